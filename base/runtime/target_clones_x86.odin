@@ -0,0 +1,134 @@
+#+build i386, amd64
+package runtime
+
+import "base:intrinsics"
+
+// NOTE: Keep in sync with `target_clones_detectable_features` in the compiler (src/check_decl.cpp)
+@(private="file")
+Target_Clone_Feature :: struct {
+	name:  string,
+	word:  u8, // index into `target_clone_cpu_words`
+	bit:   u8,
+	state: u8, // register state the OS must preserve: 0 none, 1 AVX, 2 AVX-512
+}
+
+@(private="file", rodata)
+target_clone_features := [?]Target_Clone_Feature{
+	{"sse3",                0,  0, 0},
+	{"pclmul",              0,  1, 0},
+	{"ssse3",               0,  9, 0},
+	{"fma",                 0, 12, 1},
+	{"cx16",                0, 13, 0},
+	{"sse4.1",              0, 19, 0},
+	{"sse4.2",              0, 20, 0},
+	{"movbe",               0, 22, 0},
+	{"popcnt",              0, 23, 0},
+	{"aes",                 0, 25, 0},
+	{"xsave",               0, 26, 0},
+	{"avx",                 0, 28, 1},
+	{"f16c",                0, 29, 1},
+	{"rdrnd",               0, 30, 0},
+	{"sse",                 1, 25, 0},
+	{"sse2",                1, 26, 0},
+	{"bmi",                 2,  3, 0},
+	{"avx2",                2,  5, 1},
+	{"bmi2",                2,  8, 0},
+	{"ermsb",               2,  9, 0},
+	{"avx512f",             2, 16, 2},
+	{"avx512dq",            2, 17, 2},
+	{"rdseed",              2, 18, 0},
+	{"adx",                 2, 19, 0},
+	{"avx512ifma",          2, 21, 2},
+	{"clflushopt",          2, 23, 0},
+	{"avx512cd",            2, 28, 2},
+	{"sha",                 2, 29, 0},
+	{"avx512bw",            2, 30, 2},
+	{"avx512vl",            2, 31, 2},
+	{"avx512vbmi",          3,  1, 2},
+	{"avx512vbmi2",         3,  6, 2},
+	{"gfni",                3,  8, 0},
+	{"vaes",                3,  9, 1},
+	{"vpclmulqdq",          3, 10, 1},
+	{"avx512vnni",          3, 11, 2},
+	{"avx512bitalg",        3, 12, 2},
+	{"avx512vpopcntdq",     3, 14, 2},
+	{"rdpid",               3, 22, 0},
+	{"avx512vp2intersect",  4,  8, 2},
+	{"avx512fp16",          4, 23, 2},
+	{"lzcnt",               5,  5, 0},
+	{"sse4a",               5,  6, 0},
+	{"prfchw",              5,  8, 0},
+}
+
+// cpuid 1 ecx, cpuid 1 edx, cpuid 7 ebx, cpuid 7 ecx, cpuid 7 edx, cpuid 0x8000_0001 ecx
+@(private="file") target_clone_cpu_words: [6]u32
+@(private="file") target_clone_cpu_state: u8
+@(private="file") target_clone_cpu_ready: bool
+
+@(private="file")
+target_clone_detect :: proc "contextless" () {
+	words: [6]u32
+	state: u8
+
+	max_id, _, _, _ := intrinsics.x86_cpuid(0, 0)
+	if max_id >= 1 {
+		_, _, words[0], words[1] = intrinsics.x86_cpuid(1, 0)
+	}
+	if max_id >= 7 {
+		_, words[2], words[3], words[4] = intrinsics.x86_cpuid(7, 0)
+	}
+	max_ext, _, _, _ := intrinsics.x86_cpuid(0x8000_0000, 0)
+	if max_ext >= 0x8000_0001 {
+		_, _, words[5], _ = intrinsics.x86_cpuid(0x8000_0001, 0)
+	}
+
+	// NOTE: XGETBV is only usable when both XSAVE and OSXSAVE are set,
+	// and it is an illegal instruction under FreeBSD 13, OpenBSD 7.1 and NetBSD 10
+	when ODIN_OS != .FreeBSD && ODIN_OS != .OpenBSD && ODIN_OS != .NetBSD {
+		if words[0] & (1<<26) != 0 && words[0] & (1<<27) != 0 {
+			xcr0, _ := intrinsics.x86_xgetbv(0)
+			if xcr0 & 0x06 == 0x06 {
+				state = 1
+			}
+			if xcr0 & 0xe6 == 0xe6 {
+				state = 2
+			}
+		}
+	}
+
+	target_clone_cpu_words = words
+	target_clone_cpu_state = state
+	intrinsics.atomic_store_explicit(&target_clone_cpu_ready, true, .Release)
+}
+
+// Reports whether every feature of a `@(target_clones)` feature set, e.g. "avx2+fma", is available
+// on the running CPU. The resolver generated for each cloned procedure calls this once and caches the result.
+__target_clones_supported :: proc "contextless" (features: string) -> bool {
+	if !intrinsics.atomic_load_explicit(&target_clone_cpu_ready, .Acquire) {
+		target_clone_detect()
+	}
+
+	rest := features
+	for len(rest) != 0 {
+		name := rest
+		rest = ""
+		for i in 0..<len(name) {
+			if name[i] == '+' {
+				name, rest = name[:i], name[i+1:]
+				break
+			}
+		}
+
+		found := false
+		for f in target_clone_features {
+			if f.name == name {
+				found = target_clone_cpu_words[f.word] & (u32(1)<<f.bit) != 0 && target_clone_cpu_state >= f.state
+				break
+			}
+		}
+		if !found {
+			return false
+		}
+	}
+	return true
+}
@@ -0,0 +1,85 @@
+// Makespan of one codegen-like stage on the compiler's `ThreadPool`, with the tasks added in order
+// (`thread_pool_add_task`) and by cost (`thread_pool_add_task_with_cost`, as `-internal-schedule-by-cost` does).
+//
+// Each task sleeps for its cost, standing in for one module on a machine with a core per thread, so the
+// result only depends on the order the pool starts the tasks in and not on the cores of the machine.
+
+#include "common.cpp"
+#include <time.h>
+
+// NOTE: needed by `gb_assert_handler`, which is all this uses of the error reporting
+gb_internal void print_all_errors(void) {}
+gb_internal bool any_errors(void)   { return false; }
+gb_internal bool any_warnings(void) { return false; }
+
+gb_internal WORKER_TASK_PROC(bench_sleep_task) {
+	i64 ms = cast(i64)cast(intptr)data;
+	struct timespec ts = {cast(time_t)(ms/1000), cast(long)((ms%1000)*1000000)};
+	nanosleep(&ts, nullptr);
+	return 0;
+}
+
+gb_internal f64 bench_now_ms(void) {
+	struct timespec ts = {};
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000.0 + ts.tv_nsec/1.0e6;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		gb_printf_err("Usage: %s <worker count> <placement>\n", argv[0]);
+		gb_printf_err("\tplacement of the large modules in the order they are added: 0 first, 1 in the middle, 2 last\n");
+		return 1;
+	}
+	isize worker_count = atoi(argv[1]);
+	int placement = atoi(argv[2]);
+
+	virtual_memory_init();
+
+	// NOTE: 48 library-sized modules of 10-49ms and 3 large ones, roughly the shape of a program
+	// whose own packages dominate the code generation
+	Array<i64> costs = {};
+	array_init(&costs, heap_allocator());
+	u64 seed = 12345;
+	for (isize i = 0; i < 48; i++) {
+		seed = seed*6364136223846793005ull + 1442695040888963407ull;
+		array_add(&costs, cast(i64)(10 + (seed >> 33) % 40));
+	}
+	i64 const large[] = {250, 400, 600};
+	isize at = placement == 0 ? 0 : placement == 1 ? costs.count/2 : costs.count;
+	for (isize i = 0; i < gb_count_of(large); i++) {
+		array_inject_at(&costs, at+i, large[i]);
+	}
+
+	i64 total = 0;
+	i64 largest = 0;
+	for (i64 cost : costs) {
+		total += cost;
+		largest = gb_max(largest, cost);
+	}
+	// NOTE: the thread in `thread_pool_wait` runs tasks too
+	i64 lower_bound = gb_max(largest, total/(worker_count+1));
+	gb_printf("%td modules, %td workers, %lldms of work, best possible %lldms\n",
+	          costs.count, worker_count, cast(long long)total, cast(long long)lower_bound);
+
+	ThreadPool pool = {};
+	thread_pool_init(&pool, worker_count, "BenchWorker");
+
+	for (isize rep = 0; rep < 3; rep++) {
+		for (int by_cost = 0; by_cost < 2; by_cost++) {
+			f64 start = bench_now_ms();
+			for (i64 cost : costs) {
+				if (by_cost) {
+					thread_pool_add_task_with_cost(&pool, bench_sleep_task, cast(void *)cast(intptr)cost, cost);
+				} else {
+					thread_pool_add_task(&pool, bench_sleep_task, cast(void *)cast(intptr)cost);
+				}
+			}
+			thread_pool_wait(&pool);
+			gb_printf("%s %8.1fms\n", by_cost ? "by cost " : "in order", bench_now_ms() - start);
+		}
+	}
+
+	thread_pool_destroy(&pool);
+	return 0;
+}
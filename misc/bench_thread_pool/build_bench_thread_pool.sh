@@ -0,0 +1,5 @@
+#!/usr/bin/env bash
+
+set -ex
+
+${CXX:-clang++} -std=c++14 -O2 -I../../src bench_thread_pool.cpp -o bench_thread_pool -pthread
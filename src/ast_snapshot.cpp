@@ -0,0 +1,1144 @@
+// Binary AST snapshots of library files (-ast-cache)
+//
+// Files in the `base`, `core` and `vendor` collections rarely change between builds, so the result of parsing them is
+// stored as `.odin-cache/ast/<hash>.odin-ast`, keyed on the file contents and on the settings which affect parsing.
+// A snapshot holds the packed tokens, the line table, and one blob with every node, slice and comment group of the file.
+// Pointers within the blob are stored as offsets from its start and pointers into the source text as offsets from the
+// start of the source, so loading is a single linear pass over the relocation tables followed by fixing up what
+// depends on this process: file ids, interned identifiers, the constant values of basic literals and import paths.
+//
+// NOTE: the blob cannot be used in place from a read-only mapping as the checker writes through the nodes (entities,
+// types, scopes), so the file is read into the permanent arena and relocated there.
+
+enum : u32 {
+	AST_SNAPSHOT_VERSION = 2,
+};
+
+gb_global char const AST_SNAPSHOT_MAGIC[8] = {'O', 'D', 'I', 'N', 'A', 'S', 'T', 0};
+
+enum AstSnapshotSectionKind : u32 {
+	AstSnapshotSection_Tokens,       // PackedToken
+	AstSnapshotSection_LineOffsets,  // u32
+	AstSnapshotSection_Blob,         // u8, starts with the `AstSnapshotRoot`
+	AstSnapshotSection_Relocs,       // u32, blob offsets of pointers into the blob
+	AstSnapshotSection_SourceRelocs, // u32, blob offsets of pointers into the source text
+	AstSnapshotSection_FileIds,      // u32, blob offsets of `i32 file_id` fields
+	AstSnapshotSection_Arrays,       // u32, blob offsets of `Array` headers which need an allocator
+	AstSnapshotSection_Nodes,        // u32, blob offsets of nodes which are fixed up after loading
+
+	AstSnapshotSection_COUNT,
+};
+
+gb_global isize const ast_snapshot_section_elem_size[AstSnapshotSection_COUNT] = {
+	gb_size_of(PackedToken),
+	gb_size_of(u32),
+	1,
+	gb_size_of(u32),
+	gb_size_of(u32),
+	gb_size_of(u32),
+	gb_size_of(u32),
+	gb_size_of(u32),
+};
+
+struct AstSnapshotSection {
+	u32 offset;
+	u32 count;
+};
+
+struct AstSnapshotHeader {
+	char    magic[8];
+	u32     version;
+	u32     ast_size;
+	u64     layout;
+	Hash128 key;
+	u32     source_len;
+	u32     line_count;
+	AstSnapshotSection sections[AstSnapshotSection_COUNT];
+};
+
+struct AstSnapshotRoot {
+	Slice<Ast *>          decls;
+	Array<Ast *>          imports;
+	Array<CommentGroup *> comments; // only those after the package declaration
+	isize                 total_file_decl_count;
+	isize                 delayed_decl_count;
+	isize                 seen_load_directive_count;
+};
+
+
+// NOTE: the text of every node definition, so that a reordered or retyped field changes the layout fingerprint
+gb_global char const *const ast_snapshot_node_definitions[] = {
+	"",
+#define AST_KIND(_kind_name_, name, ...) #__VA_ARGS__,
+	AST_KINDS
+#undef AST_KIND
+};
+
+// Snapshots are raw images of the nodes, so they may only be loaded by a compiler with the same node layout.
+// Along with the node definitions, this covers the numbering of the node and token kinds and the layout of the
+// types the nodes embed. A change anywhere else which alters what the nodes mean still needs a new `AST_SNAPSHOT_VERSION`.
+gb_internal u64 ast_snapshot_layout_fingerprint(void) {
+	u64 layout[] = {
+		Ast_COUNT,
+		Token_Count,
+		gb_size_of(AstCommonStuff),
+		gb_offset_of(Ast, file_id),
+		gb_offset_of(Ast, tav),
+		gb_size_of(TypeAndValue),
+		gb_size_of(Token),
+		gb_offset_of(Token, flags),
+		gb_offset_of(Token, string),
+		gb_offset_of(Token, pos),
+		gb_size_of(TokenPos),
+		gb_size_of(String),
+		gb_size_of(PackedToken),
+		gb_size_of(CommentGroup),
+		gb_size_of(Slice<Ast *>),
+		gb_size_of(Array<Ast *>),
+		gb_offset_of(Array<Ast *>, data),
+		gb_offset_of(Array<Ast *>, count),
+		gb_size_of(AstSnapshotRoot),
+	};
+	u64 h = fnv64a(layout, gb_size_of(layout));
+	for (isize kind = 0; kind < Ast_COUNT; kind++) {
+		u64 size = cast(u64)ast_node_size(cast(AstKind)kind);
+		h = fnv64a(&size, gb_size_of(size), h);
+		h = fnv64a(ast_strings[kind].text, ast_strings[kind].len, h);
+		h = fnv64a(ast_snapshot_node_definitions[kind], gb_strlen(ast_snapshot_node_definitions[kind]), h);
+	}
+	for (isize kind = 0; kind < Token_Count; kind++) {
+		h = fnv64a(token_strings[kind].text, token_strings[kind].len, h);
+	}
+#if defined(GIT_SHA)
+	h = fnv64a(GIT_SHA, gb_strlen(GIT_SHA), h);
+#endif
+	return h;
+}
+
+gb_internal bool ast_snapshot_is_library_file(AstFile *f) {
+	for (LibraryCollections const &lc : library_collections) {
+		if (lc.name == "base" || lc.name == "core" || lc.name == "vendor") {
+			if (lc.path.len > 0 && string_starts_with(f->fullpath, lc.path)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// NOTE: covers everything the parser reads from `build_context` that can change the tree or its diagnostics
+gb_internal Hash128 ast_snapshot_key(AstFile *f) {
+	u64 settings[] = {
+		AST_SNAPSHOT_VERSION,
+		gb_size_of(Ast),
+		cast(u64)build_context.metrics.os,
+		cast(u64)build_context.metrics.arch,
+		cast(u64)build_context.command_kind,
+		cast(u64)build_context.vet_flags,
+		cast(u64)build_context.strict_style,
+		cast(u64)build_context.disallow_do,
+		cast(u64)build_context.bedrock,
+	};
+	u64 seed = fnv64a(settings, gb_size_of(settings));
+	seed = fnv64a(&build_context.build_cache_data.ast_layout, gb_size_of(u64), seed);
+	seed = fnv64a(build_context.ODIN_VERSION.text, build_context.ODIN_VERSION.len, seed);
+	return hash128(f->tokenizer.start, f->tokenizer.end - f->tokenizer.start, seed);
+}
+
+gb_internal String ast_snapshot_path(Hash128 const &key) {
+	String dir = build_context.build_cache_data.ast_dir;
+	GB_ASSERT(dir.len != 0);
+
+	gbString path = gb_string_make_length(permanent_allocator(), dir.text, dir.len);
+	path = gb_string_appendc(path, "/");
+	path = hash128_append_hex(path, key);
+	path = gb_string_appendc(path, ".odin-ast");
+	return make_string(cast(u8 *)path, gb_string_length(path));
+}
+
+// Called once the tokenizer has read the source. Returns false if the file is not eligible for the cache.
+gb_internal bool ast_snapshot_begin(AstFile *f) {
+	if (!build_context.ast_cache || build_context.build_cache_data.ast_dir.len == 0) {
+		return false;
+	}
+	// NOTE: `in_vet_packages` needs the package name, which is not known before parsing
+	if (build_context.vet_packages.entries.count != 0) {
+		return false;
+	}
+	if (f->tokenizer.start == f->tokenizer.end || !ast_snapshot_is_library_file(f)) {
+		return false;
+	}
+	f->snapshot_key = ast_snapshot_key(f);
+	f->snapshot_enabled = true;
+	return true;
+}
+
+
+struct AstSnapshotWriter {
+	AstFile *           f;
+	Array<u8>           blob;
+	PtrMap<void *, u32> offsets;
+	Array<u32>          tables[AstSnapshotSection_COUNT];
+	bool                ok;
+};
+
+gb_internal u32 ast_snapshot_alloc(AstSnapshotWriter *w, isize size, isize align) {
+	isize offset = align_formula_isize(w->blob.count, align);
+	array_resize(&w->blob, offset+size);
+	gb_zero_size(w->blob.data+offset, size);
+	return cast(u32)offset;
+}
+
+gb_internal gb_inline u8 *ast_snapshot_at(AstSnapshotWriter *w, u32 offset) {
+	return w->blob.data + offset;
+}
+
+// The blob offset of `field`, which is a member of `owner` copied to `owner_offset`
+gb_internal gb_inline u32 ast_snapshot_field(u32 owner_offset, void const *owner, void const *field) {
+	return owner_offset + cast(u32)(cast(u8 const *)field - cast(u8 const *)owner);
+}
+
+gb_internal void ast_snapshot_set_ptr(AstSnapshotWriter *w, u32 at, u32 target) {
+	uintptr value = target;
+	gb_memmove(ast_snapshot_at(w, at), &value, gb_size_of(value));
+	if (target != 0) {
+		array_add(&w->tables[AstSnapshotSection_Relocs], at);
+	}
+}
+
+gb_internal void ast_snapshot_write_string(AstSnapshotWriter *w, u32 at, String const &s) {
+	u8 const *start = w->f->tokenizer.start;
+	u8 const *end   = w->f->tokenizer.end;
+	u32 text_at = ast_snapshot_field(at, &s, &s.text);
+	if (s.text == nullptr) {
+		ast_snapshot_set_ptr(w, text_at, 0);
+	} else if (start <= s.text && s.text+s.len <= end) {
+		// NOTE: an offset of zero into the source still needs relocating
+		uintptr value = cast(uintptr)(s.text - start);
+		gb_memmove(ast_snapshot_at(w, text_at), &value, gb_size_of(value));
+		array_add(&w->tables[AstSnapshotSection_SourceRelocs], text_at);
+	} else {
+		u32 data = ast_snapshot_alloc(w, s.len+1, 1);
+		gb_memmove(ast_snapshot_at(w, data), s.text, s.len);
+		ast_snapshot_set_ptr(w, text_at, data);
+	}
+}
+
+gb_internal void ast_snapshot_write_token(AstSnapshotWriter *w, u32 at, Token const &t) {
+	ast_snapshot_write_string(w, ast_snapshot_field(at, &t, &t.string), t.string);
+	if (t.pos.file_id == w->f->id) {
+		array_add(&w->tables[AstSnapshotSection_FileIds], ast_snapshot_field(at, &t, &t.pos.file_id));
+	}
+}
+
+gb_internal u32 ast_snapshot_write(AstSnapshotWriter *w, Ast *node);
+gb_internal u32 ast_snapshot_write(AstSnapshotWriter *w, CommentGroup *cg);
+
+template <typename T>
+gb_internal u32 ast_snapshot_write_ptrs(AstSnapshotWriter *w, T *const *ptrs, isize count) {
+	if (count == 0) {
+		return 0;
+	}
+	u32 data = ast_snapshot_alloc(w, count*gb_size_of(T *), gb_align_of(T *));
+	for (isize i = 0; i < count; i++) {
+		u32 target = ast_snapshot_write(w, ptrs[i]);
+		ast_snapshot_set_ptr(w, data + cast(u32)(i*gb_size_of(T *)), target);
+	}
+	return data;
+}
+
+template <typename T>
+gb_internal void ast_snapshot_ptr_field(AstSnapshotWriter *w, u32 offset, void const *owner, T *const &field) {
+	u32 target = ast_snapshot_write(w, field);
+	ast_snapshot_set_ptr(w, ast_snapshot_field(offset, owner, &field), target);
+}
+
+template <typename T>
+gb_internal void ast_snapshot_slice_field(AstSnapshotWriter *w, u32 offset, void const *owner, Slice<T *> const &field) {
+	u32 data = ast_snapshot_write_ptrs(w, field.data, field.count);
+	ast_snapshot_set_ptr(w, ast_snapshot_field(offset, owner, &field.data), data);
+}
+
+template <typename T>
+gb_internal void ast_snapshot_array_field(AstSnapshotWriter *w, u32 offset, void const *owner, Array<T *> const &field) {
+	u32 at = ast_snapshot_field(offset, owner, &field);
+	u32 data = ast_snapshot_write_ptrs(w, field.data, field.count);
+
+	Array<T *> *copy = cast(Array<T *> *)ast_snapshot_at(w, at);
+	gb_zero_item(copy);
+	copy->count    = field.count;
+	copy->capacity = field.count;
+	ast_snapshot_set_ptr(w, ast_snapshot_field(at, &field, &field.data), data);
+	array_add(&w->tables[AstSnapshotSection_Arrays], at);
+}
+
+gb_internal void ast_snapshot_token_field(AstSnapshotWriter *w, u32 offset, void const *owner, Token const &field) {
+	ast_snapshot_write_token(w, ast_snapshot_field(offset, owner, &field), field);
+}
+
+// Fields which are filled in by the checker or by `parse_setup_file_decls`
+template <typename T>
+gb_internal void ast_snapshot_clear_field(AstSnapshotWriter *w, u32 offset, void const *owner, T const &field) {
+	gb_zero_size(ast_snapshot_at(w, ast_snapshot_field(offset, owner, &field)), gb_size_of(T));
+}
+
+gb_internal u32 ast_snapshot_write(AstSnapshotWriter *w, CommentGroup *cg) {
+	if (cg == nullptr) {
+		return 0;
+	}
+	u32 *found = map_get(&w->offsets, cast(void *)cg);
+	if (found) {
+		return *found;
+	}
+	u32 offset = ast_snapshot_alloc(w, gb_size_of(CommentGroup), gb_align_of(CommentGroup));
+	map_set(&w->offsets, cast(void *)cg, offset);
+
+	u32 list = 0;
+	if (cg->list.count > 0) {
+		list = ast_snapshot_alloc(w, cg->list.count*gb_size_of(Token), gb_align_of(Token));
+		for_array(i, cg->list) {
+			u32 at = list + cast(u32)(i*gb_size_of(Token));
+			gb_memmove(ast_snapshot_at(w, at), &cg->list[i], gb_size_of(Token));
+			ast_snapshot_write_token(w, at, cg->list[i]);
+		}
+	}
+	CommentGroup *copy = cast(CommentGroup *)ast_snapshot_at(w, offset);
+	copy->list.count = cg->list.count;
+	ast_snapshot_set_ptr(w, ast_snapshot_field(offset, cg, &cg->list.data), list);
+	return offset;
+}
+
+gb_internal u32 ast_snapshot_write(AstSnapshotWriter *w, Ast *node) {
+	if (node == nullptr) {
+		return 0;
+	}
+	u32 *found = map_get(&w->offsets, cast(void *)node);
+	if (found) {
+		return *found;
+	}
+	isize size = ast_node_size(node->kind);
+	u32 offset = ast_snapshot_alloc(w, size, 16);
+	map_set(&w->offsets, cast(void *)node, offset);
+	gb_memmove(ast_snapshot_at(w, offset), node, size);
+
+	ast_snapshot_clear_field(w, offset, node, node->tav);
+	if (node->file_id == w->f->id) {
+		array_add(&w->tables[AstSnapshotSection_FileIds], ast_snapshot_field(offset, node, &node->file_id));
+	}
+
+#define AST_SNAPSHOT_PTR(field)   ast_snapshot_ptr_field  (w, offset, node, node->field)
+#define AST_SNAPSHOT_SLICE(field) ast_snapshot_slice_field(w, offset, node, node->field)
+#define AST_SNAPSHOT_ARRAY(field) ast_snapshot_array_field(w, offset, node, node->field)
+#define AST_SNAPSHOT_TOKEN(field) ast_snapshot_token_field(w, offset, node, node->field)
+#define AST_SNAPSHOT_CLEAR(field) ast_snapshot_clear_field(w, offset, node, node->field)
+
+	switch (node->kind) {
+	case Ast_Ident:
+		AST_SNAPSHOT_TOKEN(Ident.token);
+		AST_SNAPSHOT_CLEAR(Ident.entity);
+		AST_SNAPSHOT_CLEAR(Ident.hash);
+		AST_SNAPSHOT_CLEAR(Ident.interned);
+		array_add(&w->tables[AstSnapshotSection_Nodes], offset);
+		break;
+	case Ast_Implicit:
+		AST_SNAPSHOT_TOKEN(Implicit);
+		break;
+	case Ast_Uninit:
+		AST_SNAPSHOT_TOKEN(Uninit);
+		break;
+	case Ast_BasicLit:
+		AST_SNAPSHOT_TOKEN(BasicLit.token);
+		array_add(&w->tables[AstSnapshotSection_Nodes], offset);
+		break;
+	case Ast_BasicDirective:
+		AST_SNAPSHOT_TOKEN(BasicDirective.token);
+		AST_SNAPSHOT_TOKEN(BasicDirective.name);
+		array_add(&w->tables[AstSnapshotSection_Nodes], offset);
+		break;
+	case Ast_Ellipsis:
+		AST_SNAPSHOT_TOKEN(Ellipsis.token);
+		AST_SNAPSHOT_PTR(Ellipsis.expr);
+		break;
+	case Ast_ProcGroup:
+		AST_SNAPSHOT_TOKEN(ProcGroup.token);
+		AST_SNAPSHOT_TOKEN(ProcGroup.open);
+		AST_SNAPSHOT_TOKEN(ProcGroup.close);
+		AST_SNAPSHOT_SLICE(ProcGroup.args);
+		break;
+	case Ast_AsmGroup:
+		AST_SNAPSHOT_TOKEN(AsmGroup.token);
+		AST_SNAPSHOT_TOKEN(AsmGroup.open);
+		AST_SNAPSHOT_TOKEN(AsmGroup.close);
+		AST_SNAPSHOT_SLICE(AsmGroup.args);
+		break;
+	case Ast_ProcLit:
+		AST_SNAPSHOT_PTR(ProcLit.type);
+		AST_SNAPSHOT_PTR(ProcLit.body);
+		AST_SNAPSHOT_TOKEN(ProcLit.where_token);
+		AST_SNAPSHOT_SLICE(ProcLit.where_clauses);
+		AST_SNAPSHOT_CLEAR(ProcLit.decl);
+		break;
+	case Ast_CompoundLit:
+		AST_SNAPSHOT_PTR(CompoundLit.type);
+		AST_SNAPSHOT_SLICE(CompoundLit.elems);
+		AST_SNAPSHOT_TOKEN(CompoundLit.open);
+		AST_SNAPSHOT_TOKEN(CompoundLit.close);
+		AST_SNAPSHOT_PTR(CompoundLit.tag);
+		break;
+	case Ast_AsmTemplate:
+		AST_SNAPSHOT_TOKEN(AsmTemplate.token);
+		AST_SNAPSHOT_PTR(AsmTemplate.signature);
+		AST_SNAPSHOT_SLICE(AsmTemplate.specs);
+		AST_SNAPSHOT_SLICE(AsmTemplate.clobbers);
+		AST_SNAPSHOT_SLICE(AsmTemplate.instructions);
+		AST_SNAPSHOT_TOKEN(AsmTemplate.end);
+		AST_SNAPSHOT_CLEAR(AsmTemplate.anonymous_entity);
+		break;
+	case Ast_AsmRegister:
+		AST_SNAPSHOT_TOKEN(AsmRegister.token);
+		AST_SNAPSHOT_TOKEN(AsmRegister.name);
+		AST_SNAPSHOT_TOKEN(AsmRegister.flag);
+		break;
+	case Ast_AsmSpec:
+		AST_SNAPSHOT_PTR(AsmSpec.name);
+		AST_SNAPSHOT_PTR(AsmSpec.tied_name);
+		AST_SNAPSHOT_PTR(AsmSpec.type);
+		AST_SNAPSHOT_PTR(AsmSpec.value);
+		break;
+	case Ast_AsmClobber:
+		AST_SNAPSHOT_TOKEN(AsmClobber.token);
+		AST_SNAPSHOT_TOKEN(AsmClobber.name);
+		AST_SNAPSHOT_PTR(AsmClobber.value);
+		break;
+	case Ast_AsmLabelDecl:
+		AST_SNAPSHOT_TOKEN(AsmLabelDecl.token);
+		AST_SNAPSHOT_PTR(AsmLabelDecl.name);
+		break;
+	case Ast_AsmInstruction:
+		AST_SNAPSHOT_PTR(AsmInstruction.name);
+		AST_SNAPSHOT_SLICE(AsmInstruction.operands);
+		break;
+	case Ast_AsmMemoryOperand:
+		AST_SNAPSHOT_TOKEN(AsmMemoryOperand.open);
+		AST_SNAPSHOT_PTR(AsmMemoryOperand.segment_override);
+		AST_SNAPSHOT_PTR(AsmMemoryOperand.base);
+		AST_SNAPSHOT_TOKEN(AsmMemoryOperand.index_op);
+		AST_SNAPSHOT_PTR(AsmMemoryOperand.index);
+		AST_SNAPSHOT_TOKEN(AsmMemoryOperand.scale_op);
+		AST_SNAPSHOT_PTR(AsmMemoryOperand.scale);
+		AST_SNAPSHOT_TOKEN(AsmMemoryOperand.disp_op);
+		AST_SNAPSHOT_PTR(AsmMemoryOperand.disp);
+		AST_SNAPSHOT_PTR(AsmMemoryOperand.type);
+		AST_SNAPSHOT_TOKEN(AsmMemoryOperand.close);
+		break;
+	case Ast_AsmDirective:
+		AST_SNAPSHOT_TOKEN(AsmDirective.token);
+		AST_SNAPSHOT_TOKEN(AsmDirective.name);
+		AST_SNAPSHOT_SLICE(AsmDirective.operands);
+		break;
+
+	case Ast_BadExpr:
+		AST_SNAPSHOT_TOKEN(BadExpr.begin);
+		AST_SNAPSHOT_TOKEN(BadExpr.end);
+		break;
+	case Ast_TagExpr:
+		AST_SNAPSHOT_TOKEN(TagExpr.token);
+		AST_SNAPSHOT_TOKEN(TagExpr.name);
+		AST_SNAPSHOT_PTR(TagExpr.expr);
+		break;
+	case Ast_UnaryExpr:
+		AST_SNAPSHOT_TOKEN(UnaryExpr.op);
+		AST_SNAPSHOT_PTR(UnaryExpr.expr);
+		break;
+	case Ast_BinaryExpr:
+		AST_SNAPSHOT_TOKEN(BinaryExpr.op);
+		AST_SNAPSHOT_PTR(BinaryExpr.left);
+		AST_SNAPSHOT_PTR(BinaryExpr.right);
+		break;
+	case Ast_ParenExpr:
+		AST_SNAPSHOT_PTR(ParenExpr.expr);
+		AST_SNAPSHOT_TOKEN(ParenExpr.open);
+		AST_SNAPSHOT_TOKEN(ParenExpr.close);
+		break;
+	case Ast_SelectorExpr:
+		AST_SNAPSHOT_TOKEN(SelectorExpr.token);
+		AST_SNAPSHOT_PTR(SelectorExpr.expr);
+		AST_SNAPSHOT_PTR(SelectorExpr.selector);
+		break;
+	case Ast_ImplicitSelectorExpr:
+		AST_SNAPSHOT_TOKEN(ImplicitSelectorExpr.token);
+		AST_SNAPSHOT_PTR(ImplicitSelectorExpr.selector);
+		break;
+	case Ast_SelectorCallExpr:
+		AST_SNAPSHOT_TOKEN(SelectorCallExpr.token);
+		AST_SNAPSHOT_PTR(SelectorCallExpr.expr);
+		AST_SNAPSHOT_PTR(SelectorCallExpr.call);
+		break;
+	case Ast_IndexExpr:
+		AST_SNAPSHOT_PTR(IndexExpr.expr);
+		AST_SNAPSHOT_PTR(IndexExpr.index);
+		AST_SNAPSHOT_TOKEN(IndexExpr.open);
+		AST_SNAPSHOT_TOKEN(IndexExpr.close);
+		break;
+	case Ast_DerefExpr:
+		AST_SNAPSHOT_PTR(DerefExpr.expr);
+		AST_SNAPSHOT_TOKEN(DerefExpr.op);
+		break;
+	case Ast_SliceExpr:
+		AST_SNAPSHOT_PTR(SliceExpr.expr);
+		AST_SNAPSHOT_TOKEN(SliceExpr.open);
+		AST_SNAPSHOT_TOKEN(SliceExpr.close);
+		AST_SNAPSHOT_TOKEN(SliceExpr.interval);
+		AST_SNAPSHOT_PTR(SliceExpr.low);
+		AST_SNAPSHOT_PTR(SliceExpr.high);
+		break;
+	case Ast_CallExpr:
+		AST_SNAPSHOT_PTR(CallExpr.proc);
+		AST_SNAPSHOT_SLICE(CallExpr.args);
+		AST_SNAPSHOT_TOKEN(CallExpr.open);
+		AST_SNAPSHOT_TOKEN(CallExpr.close);
+		AST_SNAPSHOT_TOKEN(CallExpr.ellipsis);
+		AST_SNAPSHOT_CLEAR(CallExpr.split_args);
+		AST_SNAPSHOT_CLEAR(CallExpr.entity_procedure_of);
+		break;
+	case Ast_FieldValue:
+		AST_SNAPSHOT_TOKEN(FieldValue.eq);
+		AST_SNAPSHOT_PTR(FieldValue.field);
+		AST_SNAPSHOT_PTR(FieldValue.value);
+		break;
+	case Ast_EnumFieldValue:
+		AST_SNAPSHOT_PTR(EnumFieldValue.name);
+		AST_SNAPSHOT_PTR(EnumFieldValue.value);
+		AST_SNAPSHOT_PTR(EnumFieldValue.docs);
+		AST_SNAPSHOT_PTR(EnumFieldValue.comment);
+		break;
+	case Ast_TernaryIfExpr:
+		AST_SNAPSHOT_PTR(TernaryIfExpr.x);
+		AST_SNAPSHOT_PTR(TernaryIfExpr.cond);
+		AST_SNAPSHOT_PTR(TernaryIfExpr.y);
+		break;
+	case Ast_TernaryWhenExpr:
+		AST_SNAPSHOT_PTR(TernaryWhenExpr.x);
+		AST_SNAPSHOT_PTR(TernaryWhenExpr.cond);
+		AST_SNAPSHOT_PTR(TernaryWhenExpr.y);
+		break;
+	case Ast_OrElseExpr:
+		AST_SNAPSHOT_PTR(OrElseExpr.x);
+		AST_SNAPSHOT_TOKEN(OrElseExpr.token);
+		AST_SNAPSHOT_PTR(OrElseExpr.y);
+		break;
+	case Ast_OrReturnExpr:
+		AST_SNAPSHOT_PTR(OrReturnExpr.expr);
+		AST_SNAPSHOT_TOKEN(OrReturnExpr.token);
+		break;
+	case Ast_OrBranchExpr:
+		AST_SNAPSHOT_PTR(OrBranchExpr.expr);
+		AST_SNAPSHOT_TOKEN(OrBranchExpr.token);
+		AST_SNAPSHOT_PTR(OrBranchExpr.label);
+		break;
+	case Ast_TypeAssertion:
+		AST_SNAPSHOT_PTR(TypeAssertion.expr);
+		AST_SNAPSHOT_TOKEN(TypeAssertion.dot);
+		AST_SNAPSHOT_PTR(TypeAssertion.type);
+		AST_SNAPSHOT_CLEAR(TypeAssertion.type_hint);
+		break;
+	case Ast_TypeCast:
+		AST_SNAPSHOT_TOKEN(TypeCast.token);
+		AST_SNAPSHOT_PTR(TypeCast.type);
+		AST_SNAPSHOT_PTR(TypeCast.expr);
+		break;
+	case Ast_AutoCast:
+		AST_SNAPSHOT_TOKEN(AutoCast.token);
+		AST_SNAPSHOT_PTR(AutoCast.expr);
+		break;
+	case Ast_MatrixIndexExpr:
+		AST_SNAPSHOT_PTR(MatrixIndexExpr.expr);
+		AST_SNAPSHOT_PTR(MatrixIndexExpr.row_index);
+		AST_SNAPSHOT_PTR(MatrixIndexExpr.column_index);
+		AST_SNAPSHOT_TOKEN(MatrixIndexExpr.open);
+		AST_SNAPSHOT_TOKEN(MatrixIndexExpr.close);
+		break;
+
+	case Ast_BadStmt:
+		AST_SNAPSHOT_TOKEN(BadStmt.begin);
+		AST_SNAPSHOT_TOKEN(BadStmt.end);
+		break;
+	case Ast_EmptyStmt:
+		AST_SNAPSHOT_TOKEN(EmptyStmt.token);
+		break;
+	case Ast_ExprStmt:
+		AST_SNAPSHOT_PTR(ExprStmt.expr);
+		break;
+	case Ast_AssignStmt:
+		AST_SNAPSHOT_TOKEN(AssignStmt.op);
+		AST_SNAPSHOT_SLICE(AssignStmt.lhs);
+		AST_SNAPSHOT_SLICE(AssignStmt.rhs);
+		break;
+	case Ast_BlockStmt:
+		AST_SNAPSHOT_CLEAR(BlockStmt.scope);
+		AST_SNAPSHOT_SLICE(BlockStmt.stmts);
+		AST_SNAPSHOT_PTR(BlockStmt.label);
+		AST_SNAPSHOT_TOKEN(BlockStmt.open);
+		AST_SNAPSHOT_TOKEN(BlockStmt.close);
+		break;
+	case Ast_IfStmt:
+		AST_SNAPSHOT_CLEAR(IfStmt.scope);
+		AST_SNAPSHOT_TOKEN(IfStmt.token);
+		AST_SNAPSHOT_PTR(IfStmt.label);
+		AST_SNAPSHOT_PTR(IfStmt.init);
+		AST_SNAPSHOT_PTR(IfStmt.cond);
+		AST_SNAPSHOT_PTR(IfStmt.body);
+		AST_SNAPSHOT_PTR(IfStmt.else_stmt);
+		break;
+	case Ast_WhenStmt:
+		AST_SNAPSHOT_TOKEN(WhenStmt.token);
+		AST_SNAPSHOT_PTR(WhenStmt.cond);
+		AST_SNAPSHOT_PTR(WhenStmt.body);
+		AST_SNAPSHOT_PTR(WhenStmt.else_stmt);
+		break;
+	case Ast_ReturnStmt:
+		AST_SNAPSHOT_TOKEN(ReturnStmt.token);
+		AST_SNAPSHOT_SLICE(ReturnStmt.results);
+		break;
+	case Ast_ForStmt:
+		AST_SNAPSHOT_CLEAR(ForStmt.scope);
+		AST_SNAPSHOT_TOKEN(ForStmt.token);
+		AST_SNAPSHOT_PTR(ForStmt.label);
+		AST_SNAPSHOT_PTR(ForStmt.init);
+		AST_SNAPSHOT_PTR(ForStmt.cond);
+		AST_SNAPSHOT_PTR(ForStmt.post);
+		AST_SNAPSHOT_PTR(ForStmt.body);
+		break;
+	case Ast_RangeStmt:
+		AST_SNAPSHOT_CLEAR(RangeStmt.scope);
+		AST_SNAPSHOT_TOKEN(RangeStmt.token);
+		AST_SNAPSHOT_PTR(RangeStmt.label);
+		AST_SNAPSHOT_PTR(RangeStmt.init);
+		AST_SNAPSHOT_SLICE(RangeStmt.vals);
+		AST_SNAPSHOT_TOKEN(RangeStmt.in_token);
+		AST_SNAPSHOT_PTR(RangeStmt.expr);
+		AST_SNAPSHOT_PTR(RangeStmt.body);
+		break;
+	case Ast_UnrollRangeStmt:
+		AST_SNAPSHOT_CLEAR(UnrollRangeStmt.scope);
+		AST_SNAPSHOT_TOKEN(UnrollRangeStmt.unroll_token);
+		AST_SNAPSHOT_PTR(UnrollRangeStmt.init);
+		AST_SNAPSHOT_SLICE(UnrollRangeStmt.args);
+		AST_SNAPSHOT_TOKEN(UnrollRangeStmt.for_token);
+		AST_SNAPSHOT_PTR(UnrollRangeStmt.val0);
+		AST_SNAPSHOT_PTR(UnrollRangeStmt.val1);
+		AST_SNAPSHOT_TOKEN(UnrollRangeStmt.in_token);
+		AST_SNAPSHOT_PTR(UnrollRangeStmt.expr);
+		AST_SNAPSHOT_PTR(UnrollRangeStmt.body);
+		break;
+	case Ast_CaseClause:
+		AST_SNAPSHOT_CLEAR(CaseClause.scope);
+		AST_SNAPSHOT_TOKEN(CaseClause.token);
+		AST_SNAPSHOT_SLICE(CaseClause.list);
+		AST_SNAPSHOT_SLICE(CaseClause.stmts);
+		AST_SNAPSHOT_CLEAR(CaseClause.implicit_entity);
+		break;
+	case Ast_SwitchStmt:
+		AST_SNAPSHOT_CLEAR(SwitchStmt.scope);
+		AST_SNAPSHOT_TOKEN(SwitchStmt.token);
+		AST_SNAPSHOT_PTR(SwitchStmt.label);
+		AST_SNAPSHOT_PTR(SwitchStmt.init);
+		AST_SNAPSHOT_PTR(SwitchStmt.tag);
+		AST_SNAPSHOT_PTR(SwitchStmt.body);
+		break;
+	case Ast_TypeSwitchStmt:
+		AST_SNAPSHOT_CLEAR(TypeSwitchStmt.scope);
+		AST_SNAPSHOT_TOKEN(TypeSwitchStmt.token);
+		AST_SNAPSHOT_PTR(TypeSwitchStmt.label);
+		AST_SNAPSHOT_PTR(TypeSwitchStmt.tag);
+		AST_SNAPSHOT_PTR(TypeSwitchStmt.body);
+		break;
+	case Ast_DeferStmt:
+		AST_SNAPSHOT_TOKEN(DeferStmt.token);
+		AST_SNAPSHOT_PTR(DeferStmt.stmt);
+		break;
+	case Ast_BranchStmt:
+		AST_SNAPSHOT_TOKEN(BranchStmt.token);
+		AST_SNAPSHOT_PTR(BranchStmt.label);
+		break;
+	case Ast_UsingStmt:
+		AST_SNAPSHOT_TOKEN(UsingStmt.token);
+		AST_SNAPSHOT_SLICE(UsingStmt.list);
+		break;
+
+	case Ast_BadDecl:
+		AST_SNAPSHOT_TOKEN(BadDecl.begin);
+		AST_SNAPSHOT_TOKEN(BadDecl.end);
+		break;
+	case Ast_ForeignBlockDecl:
+		AST_SNAPSHOT_TOKEN(ForeignBlockDecl.token);
+		AST_SNAPSHOT_PTR(ForeignBlockDecl.foreign_library);
+		AST_SNAPSHOT_PTR(ForeignBlockDecl.body);
+		AST_SNAPSHOT_ARRAY(ForeignBlockDecl.attributes);
+		AST_SNAPSHOT_PTR(ForeignBlockDecl.docs);
+		break;
+	case Ast_Label:
+		AST_SNAPSHOT_TOKEN(Label.token);
+		AST_SNAPSHOT_PTR(Label.name);
+		break;
+	case Ast_ValueDecl:
+		AST_SNAPSHOT_SLICE(ValueDecl.names);
+		AST_SNAPSHOT_PTR(ValueDecl.type);
+		AST_SNAPSHOT_SLICE(ValueDecl.values);
+		AST_SNAPSHOT_ARRAY(ValueDecl.attributes);
+		AST_SNAPSHOT_PTR(ValueDecl.docs);
+		AST_SNAPSHOT_PTR(ValueDecl.comment);
+		break;
+	case Ast_PackageDecl:
+		AST_SNAPSHOT_TOKEN(PackageDecl.token);
+		AST_SNAPSHOT_TOKEN(PackageDecl.name);
+		AST_SNAPSHOT_PTR(PackageDecl.docs);
+		AST_SNAPSHOT_PTR(PackageDecl.comment);
+		break;
+	case Ast_ImportDecl:
+		AST_SNAPSHOT_CLEAR(ImportDecl.package);
+		AST_SNAPSHOT_TOKEN(ImportDecl.token);
+		AST_SNAPSHOT_TOKEN(ImportDecl.relpath);
+		AST_SNAPSHOT_CLEAR(ImportDecl.fullpath);
+		AST_SNAPSHOT_TOKEN(ImportDecl.import_name);
+		AST_SNAPSHOT_ARRAY(ImportDecl.attributes);
+		AST_SNAPSHOT_PTR(ImportDecl.docs);
+		AST_SNAPSHOT_PTR(ImportDecl.comment);
+		break;
+	case Ast_ForeignImportDecl:
+		AST_SNAPSHOT_TOKEN(ForeignImportDecl.token);
+		AST_SNAPSHOT_SLICE(ForeignImportDecl.filepaths);
+		AST_SNAPSHOT_TOKEN(ForeignImportDecl.library_name);
+		AST_SNAPSHOT_CLEAR(ForeignImportDecl.collection_name);
+		AST_SNAPSHOT_CLEAR(ForeignImportDecl.fullpaths);
+		AST_SNAPSHOT_ARRAY(ForeignImportDecl.attributes);
+		AST_SNAPSHOT_PTR(ForeignImportDecl.docs);
+		AST_SNAPSHOT_PTR(ForeignImportDecl.comment);
+		break;
+
+	case Ast_Attribute:
+		AST_SNAPSHOT_TOKEN(Attribute.token);
+		AST_SNAPSHOT_SLICE(Attribute.elems);
+		AST_SNAPSHOT_TOKEN(Attribute.open);
+		AST_SNAPSHOT_TOKEN(Attribute.close);
+		break;
+	case Ast_Field:
+		AST_SNAPSHOT_SLICE(Field.names);
+		AST_SNAPSHOT_PTR(Field.type);
+		AST_SNAPSHOT_PTR(Field.default_value);
+		AST_SNAPSHOT_TOKEN(Field.tag);
+		AST_SNAPSHOT_PTR(Field.docs);
+		AST_SNAPSHOT_PTR(Field.comment);
+		break;
+	case Ast_BitFieldField:
+		AST_SNAPSHOT_PTR(BitFieldField.name);
+		AST_SNAPSHOT_PTR(BitFieldField.type);
+		AST_SNAPSHOT_PTR(BitFieldField.bit_size);
+		AST_SNAPSHOT_TOKEN(BitFieldField.tag);
+		AST_SNAPSHOT_PTR(BitFieldField.docs);
+		AST_SNAPSHOT_PTR(BitFieldField.comment);
+		break;
+	case Ast_FieldList:
+		AST_SNAPSHOT_TOKEN(FieldList.token);
+		AST_SNAPSHOT_SLICE(FieldList.list);
+		break;
+
+	case Ast_TypeidType:
+		AST_SNAPSHOT_TOKEN(TypeidType.token);
+		AST_SNAPSHOT_PTR(TypeidType.specialization);
+		break;
+	case Ast_HelperType:
+		AST_SNAPSHOT_TOKEN(HelperType.token);
+		AST_SNAPSHOT_PTR(HelperType.type);
+		break;
+	case Ast_DistinctType:
+		AST_SNAPSHOT_TOKEN(DistinctType.token);
+		AST_SNAPSHOT_PTR(DistinctType.type);
+		break;
+	case Ast_PolyType:
+		AST_SNAPSHOT_TOKEN(PolyType.token);
+		AST_SNAPSHOT_PTR(PolyType.type);
+		AST_SNAPSHOT_PTR(PolyType.specialization);
+		break;
+	case Ast_ProcType:
+		AST_SNAPSHOT_CLEAR(ProcType.scope);
+		AST_SNAPSHOT_TOKEN(ProcType.token);
+		AST_SNAPSHOT_PTR(ProcType.params);
+		AST_SNAPSHOT_PTR(ProcType.results);
+		break;
+	case Ast_PointerType:
+		AST_SNAPSHOT_TOKEN(PointerType.token);
+		AST_SNAPSHOT_PTR(PointerType.type);
+		AST_SNAPSHOT_PTR(PointerType.tag);
+		break;
+	case Ast_RelativeType:
+		AST_SNAPSHOT_PTR(RelativeType.tag);
+		AST_SNAPSHOT_PTR(RelativeType.type);
+		break;
+	case Ast_MultiPointerType:
+		AST_SNAPSHOT_TOKEN(MultiPointerType.token);
+		AST_SNAPSHOT_PTR(MultiPointerType.type);
+		break;
+	case Ast_ArrayType:
+		AST_SNAPSHOT_TOKEN(ArrayType.token);
+		AST_SNAPSHOT_PTR(ArrayType.count);
+		AST_SNAPSHOT_PTR(ArrayType.elem);
+		AST_SNAPSHOT_PTR(ArrayType.tag);
+		break;
+	case Ast_DynamicArrayType:
+		AST_SNAPSHOT_TOKEN(DynamicArrayType.token);
+		AST_SNAPSHOT_PTR(DynamicArrayType.elem);
+		AST_SNAPSHOT_PTR(DynamicArrayType.tag);
+		break;
+	case Ast_FixedCapacityDynamicArrayType:
+		AST_SNAPSHOT_TOKEN(FixedCapacityDynamicArrayType.token);
+		AST_SNAPSHOT_PTR(FixedCapacityDynamicArrayType.capacity);
+		AST_SNAPSHOT_PTR(FixedCapacityDynamicArrayType.elem);
+		AST_SNAPSHOT_PTR(FixedCapacityDynamicArrayType.tag);
+		break;
+	case Ast_StructType:
+		AST_SNAPSHOT_CLEAR(StructType.scope);
+		AST_SNAPSHOT_TOKEN(StructType.token);
+		AST_SNAPSHOT_SLICE(StructType.fields);
+		AST_SNAPSHOT_PTR(StructType.polymorphic_params);
+		AST_SNAPSHOT_PTR(StructType.align);
+		AST_SNAPSHOT_PTR(StructType.min_field_align);
+		AST_SNAPSHOT_PTR(StructType.max_field_align);
+		AST_SNAPSHOT_TOKEN(StructType.where_token);
+		AST_SNAPSHOT_SLICE(StructType.where_clauses);
+		break;
+	case Ast_UnionType:
+		AST_SNAPSHOT_CLEAR(UnionType.scope);
+		AST_SNAPSHOT_TOKEN(UnionType.token);
+		AST_SNAPSHOT_SLICE(UnionType.variants);
+		AST_SNAPSHOT_PTR(UnionType.polymorphic_params);
+		AST_SNAPSHOT_PTR(UnionType.align);
+		AST_SNAPSHOT_TOKEN(UnionType.where_token);
+		AST_SNAPSHOT_SLICE(UnionType.where_clauses);
+		break;
+	case Ast_EnumType:
+		AST_SNAPSHOT_CLEAR(EnumType.scope);
+		AST_SNAPSHOT_TOKEN(EnumType.token);
+		AST_SNAPSHOT_PTR(EnumType.base_type);
+		AST_SNAPSHOT_SLICE(EnumType.fields);
+		break;
+	case Ast_BitSetType:
+		AST_SNAPSHOT_TOKEN(BitSetType.token);
+		AST_SNAPSHOT_PTR(BitSetType.elem);
+		AST_SNAPSHOT_PTR(BitSetType.underlying);
+		break;
+	case Ast_BitFieldType:
+		AST_SNAPSHOT_CLEAR(BitFieldType.scope);
+		AST_SNAPSHOT_TOKEN(BitFieldType.token);
+		AST_SNAPSHOT_PTR(BitFieldType.backing_type);
+		AST_SNAPSHOT_TOKEN(BitFieldType.open);
+		AST_SNAPSHOT_SLICE(BitFieldType.fields);
+		AST_SNAPSHOT_TOKEN(BitFieldType.close);
+		break;
+	case Ast_MapType:
+		AST_SNAPSHOT_TOKEN(MapType.token);
+		AST_SNAPSHOT_PTR(MapType.count);
+		AST_SNAPSHOT_PTR(MapType.key);
+		AST_SNAPSHOT_PTR(MapType.value);
+		break;
+	case Ast_MatrixType:
+		AST_SNAPSHOT_TOKEN(MatrixType.token);
+		AST_SNAPSHOT_PTR(MatrixType.row_count);
+		AST_SNAPSHOT_PTR(MatrixType.column_count);
+		AST_SNAPSHOT_PTR(MatrixType.elem);
+		break;
+
+	default:
+		// NOTE: a node kind without a field list cannot be written safely
+		w->ok = false;
+		break;
+	}
+
+#undef AST_SNAPSHOT_PTR
+#undef AST_SNAPSHOT_SLICE
+#undef AST_SNAPSHOT_ARRAY
+#undef AST_SNAPSHOT_TOKEN
+#undef AST_SNAPSHOT_CLEAR
+
+	return offset;
+}
+
+gb_internal void ast_snapshot_append_section(Array<u8> *out, AstSnapshotSection *section, void const *data, isize count, isize elem_size) {
+	isize prev_count = out->count;
+	isize offset = align_formula_isize(prev_count, 16);
+	isize size = count*elem_size;
+	array_resize(out, offset+size);
+	gb_zero_size(out->data+prev_count, offset-prev_count);
+	if (size > 0) {
+		gb_memmove(out->data+offset, data, size);
+	}
+	section->offset = cast(u32)offset;
+	section->count  = cast(u32)count;
+}
+
+// Writes the snapshot of a file which has just been parsed without any errors or warnings
+// `prefix_comment_count` is the number of comment groups read along with the package declaration,
+// which the parser reads again on load
+gb_internal void ast_snapshot_store(AstFile *f, isize prefix_comment_count) {
+	GB_ASSERT(f->snapshot_enabled);
+	if (f->tokenizer.end - f->tokenizer.start >= cast(isize)U32_MAX) {
+		return;
+	}
+
+	AstSnapshotWriter w = {};
+	w.f  = f;
+	w.ok = true;
+	array_init(&w.blob, heap_allocator(), 0, 4*(f->tokenizer.end - f->tokenizer.start));
+	map_init(&w.offsets, f->tokens.count/2);
+	for (isize i = 0; i < AstSnapshotSection_COUNT; i++) {
+		array_init(&w.tables[i], heap_allocator());
+	}
+	defer ({
+		array_free(&w.blob);
+		map_destroy(&w.offsets);
+		for (isize i = 0; i < AstSnapshotSection_COUNT; i++) {
+			array_free(&w.tables[i]);
+		}
+	});
+
+	AstSnapshotRoot root = {};
+	root.decls                     = f->decls;
+	root.imports                   = f->imports;
+	root.comments                  = f->comments;
+	root.comments.data            += prefix_comment_count;
+	root.comments.count           -= prefix_comment_count;
+	root.total_file_decl_count     = f->total_file_decl_count;
+	root.delayed_decl_count        = f->delayed_decl_count;
+	root.seen_load_directive_count = f->seen_load_directive_count.load();
+
+	u32 root_offset = ast_snapshot_alloc(&w, gb_size_of(root), 16);
+	GB_ASSERT(root_offset == 0);
+	gb_memmove(ast_snapshot_at(&w, root_offset), &root, gb_size_of(root));
+	ast_snapshot_slice_field(&w, root_offset, &root, root.decls);
+	ast_snapshot_array_field(&w, root_offset, &root, root.imports);
+	ast_snapshot_array_field(&w, root_offset, &root, root.comments);
+
+	if (!w.ok || w.blob.count >= cast(isize)U32_MAX) {
+		return;
+	}
+
+	AstSnapshotHeader header = {};
+	gb_memmove(header.magic, AST_SNAPSHOT_MAGIC, gb_size_of(header.magic));
+	header.version    = AST_SNAPSHOT_VERSION;
+	header.ast_size   = gb_size_of(Ast);
+	header.layout     = build_context.build_cache_data.ast_layout;
+	header.key        = f->snapshot_key;
+	header.source_len = cast(u32)(f->tokenizer.end - f->tokenizer.start);
+	header.line_count = cast(u32)f->tokenizer.line_count;
+
+	Array<u8> out = {};
+	array_init(&out, heap_allocator(), gb_size_of(header), gb_size_of(header) + w.blob.count + f->tokens.count*gb_size_of(PackedToken));
+	defer (array_free(&out));
+
+	for (isize i = 0; i < AstSnapshotSection_COUNT; i++) {
+		AstSnapshotSection *section = &header.sections[i];
+		isize elem_size = ast_snapshot_section_elem_size[i];
+		switch (i) {
+		case AstSnapshotSection_Tokens:
+			ast_snapshot_append_section(&out, section, f->tokens.data, f->tokens.count, elem_size);
+			break;
+		case AstSnapshotSection_LineOffsets:
+			ast_snapshot_append_section(&out, section, f->line_offsets.data, f->line_offsets.count, elem_size);
+			break;
+		case AstSnapshotSection_Blob:
+			ast_snapshot_append_section(&out, section, w.blob.data, w.blob.count, elem_size);
+			break;
+		default:
+			ast_snapshot_append_section(&out, section, w.tables[i].data, w.tables[i].count, elem_size);
+			break;
+		}
+	}
+	gb_memmove(out.data, &header, gb_size_of(header));
+
+	// NOTE: write to a unique temporary name first and then move it into place,
+	// so that a concurrent build never reads a partially written snapshot
+	String cache_path = ast_snapshot_path(f->snapshot_key);
+	gbString tmp_path = gb_string_make_length(heap_allocator(), cache_path.text, cache_path.len);
+	tmp_path = gb_string_append_fmt(tmp_path, ".tmp-%llx-%d", cast(unsigned long long)time_stamp_time_now(), f->id);
+	defer (gb_string_free(tmp_path));
+
+	gbFile file = {};
+	if (gb_file_create(&file, tmp_path) != gbFileError_None) {
+		return;
+	}
+	bool written = gb_file_write(&file, out.data, out.count) != 0;
+	gb_file_close(&file);
+
+	char const *cache_path_c = alloc_cstring(temporary_allocator(), cache_path);
+	if (!written || !gb_file_move(tmp_path, cache_path_c)) {
+		gb_file_remove(tmp_path);
+	}
+}
+
+
+// `max_target` is the largest offset the pointers may hold: the last byte of the blob, or the end of the source text
+// as an empty string may point there
+gb_internal bool ast_snapshot_relocate(u8 *blob, u32 blob_size, u32 const *offsets, u32 count, uintptr base, u32 max_target) {
+	for (u32 i = 0; i < count; i++) {
+		u32 at = offsets[i];
+		if (at > blob_size - gb_size_of(uintptr)) {
+			return false;
+		}
+		uintptr value = 0;
+		gb_memmove(&value, blob+at, gb_size_of(value));
+		if (value > max_target) {
+			return false;
+		}
+		value += base;
+		gb_memmove(blob+at, &value, gb_size_of(value));
+	}
+	return true;
+}
+
+// `elem_size` of zero checks for whole nodes
+gb_internal bool ast_snapshot_check_table(u8 *blob, u32 blob_size, u32 const *offsets, u32 count, isize elem_size) {
+	for (u32 i = 0; i < count; i++) {
+		isize at = offsets[i];
+		isize size = elem_size;
+		if (size == 0) {
+			if (at + gb_size_of(AstKind) > blob_size) {
+				return false;
+			}
+			Ast *node = cast(Ast *)(blob + at);
+			AstKind kind = node->kind;
+			if (kind <= Ast_Invalid || kind >= Ast_COUNT) {
+				return false;
+			}
+			size = ast_node_size(kind);
+		}
+		if (at + size > blob_size) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Replaces tokenizing and parsing `f` with its snapshot if one exists,
+// `parse_file` then takes the declarations from `f->snapshot`
+gb_internal bool ast_snapshot_load(AstFile *f) {
+	BuildCacheData *cache = &build_context.build_cache_data;
+
+	String cache_path = ast_snapshot_path(f->snapshot_key);
+	char const *cache_path_c = alloc_cstring(temporary_allocator(), cache_path);
+	gbFileContents fc = {};
+	if (gb_file_exists(cache_path_c)) {
+		fc = gb_file_read_contents(permanent_allocator(), false, cache_path_c);
+	}
+	u8 *base = cast(u8 *)fc.data;
+	isize size = fc.size;
+
+	AstSnapshotHeader *header = cast(AstSnapshotHeader *)base;
+	bool ok = base != nullptr &&
+	          (cast(uintptr)base & 15) == 0 &&
+	          size >= gb_size_of(AstSnapshotHeader) &&
+	          gb_memcompare(header->magic, AST_SNAPSHOT_MAGIC, gb_size_of(header->magic)) == 0 &&
+	          header->version == AST_SNAPSHOT_VERSION &&
+	          header->ast_size == gb_size_of(Ast) &&
+	          header->layout == build_context.build_cache_data.ast_layout &&
+	          header->key == f->snapshot_key &&
+	          header->source_len == cast(u32)(f->tokenizer.end - f->tokenizer.start);
+	for (isize i = 0; ok && i < AstSnapshotSection_COUNT; i++) {
+		AstSnapshotSection section = header->sections[i];
+		ok = (section.offset & 15) == 0 &&
+		     cast(isize)section.offset + cast(isize)section.count*ast_snapshot_section_elem_size[i] <= size;
+	}
+	ok = ok && header->sections[AstSnapshotSection_Blob].count >= gb_size_of(AstSnapshotRoot);
+	if (!ok) {
+		// NOTE: a damaged snapshot is removed so that this parse can store a new one
+		if (base != nullptr) {
+			gb_file_remove(cache_path_c);
+		}
+		cache->ast_cache_misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	#define AST_SNAPSHOT_TABLE(kind) cast(u32 const *)(base + header->sections[kind].offset), header->sections[kind].count
+
+	u8 *blob = base + header->sections[AstSnapshotSection_Blob].offset;
+	u32 blob_size = header->sections[AstSnapshotSection_Blob].count;
+	ok = ast_snapshot_relocate(blob, blob_size, AST_SNAPSHOT_TABLE(AstSnapshotSection_Relocs),       cast(uintptr)blob,                   blob_size-1) &&
+	     ast_snapshot_relocate(blob, blob_size, AST_SNAPSHOT_TABLE(AstSnapshotSection_SourceRelocs), cast(uintptr)f->tokenizer.start, header->source_len);
+	ok = ok &&
+	     ast_snapshot_check_table(blob, blob_size, AST_SNAPSHOT_TABLE(AstSnapshotSection_FileIds), gb_size_of(i32)) &&
+	     ast_snapshot_check_table(blob, blob_size, AST_SNAPSHOT_TABLE(AstSnapshotSection_Arrays),  gb_size_of(Array<Ast *>)) &&
+	     ast_snapshot_check_table(blob, blob_size, AST_SNAPSHOT_TABLE(AstSnapshotSection_Nodes),   0);
+	if (!ok) {
+		gb_file_remove(cache_path_c);
+		cache->ast_cache_misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	{
+		u32 const *offsets = cast(u32 const *)(base + header->sections[AstSnapshotSection_FileIds].offset);
+		for (u32 i = 0; i < header->sections[AstSnapshotSection_FileIds].count; i++) {
+			*cast(i32 *)(blob + offsets[i]) = f->id;
+		}
+	}
+	{
+		u32 const *offsets = cast(u32 const *)(base + header->sections[AstSnapshotSection_Arrays].offset);
+		for (u32 i = 0; i < header->sections[AstSnapshotSection_Arrays].count; i++) {
+			Array<Ast *> *array = cast(Array<Ast *> *)(blob + offsets[i]);
+			array->allocator = ast_allocator(f);
+		}
+	}
+	{
+		u32 const *offsets = cast(u32 const *)(base + header->sections[AstSnapshotSection_Nodes].offset);
+		for (u32 i = 0; i < header->sections[AstSnapshotSection_Nodes].count; i++) {
+			Ast *node = cast(Ast *)(blob + offsets[i]);
+			switch (node->kind) {
+			case Ast_Ident:
+				node->Ident.interned = string_interner_insert(node->Ident.token.string, 0, &node->Ident.hash);
+				break;
+			case Ast_BasicLit:
+				node->tav.mode  = Addressing_Constant;
+				node->tav.value = exact_value_from_token(f, node->BasicLit.token);
+				break;
+			case Ast_BasicDirective:
+				string_interner_insert(node->BasicDirective.name.string);
+				break;
+			}
+		}
+	}
+
+	#undef AST_SNAPSHOT_TABLE
+
+	AstSnapshotSection tokens = header->sections[AstSnapshotSection_Tokens];
+	f->tokens.allocator = ast_allocator(f);
+	f->tokens.data      = cast(PackedToken *)(base + tokens.offset);
+	f->tokens.count     = tokens.count;
+	f->tokens.capacity  = tokens.count;
+
+	AstSnapshotSection lines = header->sections[AstSnapshotSection_LineOffsets];
+	f->line_offsets.allocator = ast_allocator(f);
+	f->line_offsets.data      = cast(u32 *)(base + lines.offset);
+	f->line_offsets.count     = lines.count;
+	f->line_offsets.capacity  = lines.count;
+
+	f->tokenizer.line_count = header->line_count;
+	f->snapshot = cast(AstSnapshotRoot *)blob;
+
+	cache->ast_cache_hits.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+// Takes the declarations of `f` from its snapshot, after `parse_file` has read the file tags and the package declaration
+gb_internal void ast_snapshot_apply(AstFile *f) {
+	AstSnapshotRoot *root = f->snapshot;
+	GB_ASSERT(root != nullptr);
+
+	f->decls                 = root->decls;
+	f->imports               = root->imports;
+	f->total_file_decl_count = root->total_file_decl_count;
+	f->delayed_decl_count    = root->delayed_decl_count;
+	f->seen_load_directive_count.store(root->seen_load_directive_count);
+	array_add_elems(&f->comments, root->comments.data, root->comments.count);
+
+	// NOTE: the tokens are not needed by the checker, skip to the end as the parser would have
+	f->curr_token_index = f->tokens.count-1;
+	f->curr_token = ast_file_unpack_token(f, f->curr_token_index);
+}
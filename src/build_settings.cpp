@@ -10,6 +10,7 @@
 
 #define DEFAULT_MAX_ERROR_COLLECTOR_COUNT (36)
 #define DEFAULT_DID_YOU_MEAN_LIMIT (10)
+#define DEFAULT_OBJECT_CACHE_LIMIT_MIB (4096)
 
 enum TargetOsKind : u16 {
 	TargetOs_Invalid,
@@ -424,6 +425,18 @@ struct BuildCacheData {
 	String env_path;
 
 	bool copy_already_done;
+	bool content_hash; // key the files manifest on file contents rather than modification times
+
+	// -object-cache
+	String objects_dir;
+	std::atomic<isize> object_cache_hits;
+	std::atomic<isize> object_cache_misses;
+
+	// -ast-cache
+	String ast_dir;
+	u64    ast_layout; // see `ast_snapshot_layout_fingerprint`
+	std::atomic<isize> ast_cache_hits;
+	std::atomic<isize> ast_cache_misses;
 };
 
 
@@ -433,6 +446,11 @@ enum LTOKind : i32 {
 	LTO_Thin_Files,
 };
 
+enum DebugInfoKind : i32 {
+	DebugInfo_Full,
+	DebugInfo_LineTables, // procedures and line locations only, no type or variable information
+};
+
 enum LinkerChoice : i32 {
 	Linker_Invalid = -1,
 	Linker_Default = 0,
@@ -476,6 +494,8 @@ struct BuildContext {
 	String ODIN_BUILD_PROJECT_NAME;           // Odin main/initial package's directory name
 	Windows_Subsystem ODIN_WINDOWS_SUBSYSTEM; // .Console, .Windows
 	bool   ODIN_DEBUG;                        // Odin in debug mode
+	DebugInfoKind debug_info_kind;
+	bool   split_dwarf;                       // -split-dwarf, debug information in per module .dwo files
 	bool   ODIN_DISABLE_ASSERT;               // Whether the default 'assert' et al is disabled in code or not
 	bool   ODIN_DEFAULT_TO_NIL_ALLOCATOR;     // Whether the default allocator is a "nil" allocator or not (i.e. it does nothing)
 	bool   ODIN_DEFAULT_TO_PANIC_ALLOCATOR;   // Whether the default allocator is a "panic" allocator or not (i.e. panics on any call to it)
@@ -523,11 +543,13 @@ struct BuildContext {
 	bool   show_timings;
 	TimingsExportFormat export_timings_format;
 	String export_timings_file;
+	String export_trace_file;
 	DependenciesExportFormat export_dependencies_format;
 	String export_dependencies_file;
 	bool   show_unused;
 	bool   show_unused_with_location;
 	bool   show_more_timings;
+	bool   show_memory;
 	bool   show_defineables;
 	String export_defineables_file;
 	bool   ignore_unused_defineables;
@@ -578,8 +600,13 @@ struct BuildContext {
 	bool   use_single_module;
 	bool   use_separate_modules;
 	LTOKind lto_kind;
+	bool   pgo_generate;
+	String pgo_use_path;
 	bool   module_per_file;
 	bool   cached;
+	bool   object_cache;
+	i64    object_cache_limit_mib;
+	bool   ast_cache;
 	BuildCacheData build_cache_data;
 
 	bool internal_no_inline;
@@ -587,6 +614,10 @@ struct BuildContext {
 	bool internal_weak_monomorphization;
 	bool internal_ignore_llvm_verification;
 	bool internal_llvm_no_sroa;
+	bool internal_map_files;
+	bool internal_schedule_by_cost;
+	bool internal_split_packages;
+	bool internal_no_load_sections;
 
 	bool   enable_rvo;
 
@@ -597,6 +628,7 @@ struct BuildContext {
 	int    did_you_mean_limit;
 
 	bool   copy_file_contents;
+	bool   serve_worker; // NOTE: set in an `odin serve` worker, which keeps its parsed files alive
 
 	bool   no_rtti;
 
@@ -1757,8 +1789,12 @@ gb_internal void init_build_context(TargetMetrics *cross_target, Subtarget subta
 	if (bc->max_error_count <= 0) {
 		bc->max_error_count = DEFAULT_MAX_ERROR_COLLECTOR_COUNT;
 	}
+	if (bc->object_cache_limit_mib <= 0) {
+		bc->object_cache_limit_mib = DEFAULT_OBJECT_CACHE_LIMIT_MIB;
+	}
 
-	bc->copy_file_contents = true;
+	// NOTE: a serve worker must own the contents of the files it keeps, as they may change on disk
+	bc->copy_file_contents = !bc->internal_map_files || bc->serve_worker;
 
 	TargetMetrics *metrics = nullptr;
 
@@ -2112,6 +2148,40 @@ gb_internal void init_build_context(TargetMetrics *cross_target, Subtarget subta
 		}
 	}
 
+	if (bc->split_dwarf) {
+		if (!bc->ODIN_DEBUG) {
+			gb_printf_err("-split-dwarf requires -debug\n");
+			gb_exit(1);
+		}
+		switch (bc->metrics.os) {
+		case TargetOs_linux:
+		case TargetOs_freebsd:
+		case TargetOs_openbsd:
+		case TargetOs_netbsd:
+			break;
+		default:
+			gb_printf_err("-split-dwarf is only supported for ELF targets (Linux, FreeBSD, OpenBSD and NetBSD)\n");
+			gb_exit(1);
+		}
+		if (bc->lto_kind != LTO_None) {
+			gb_printf_err("-split-dwarf cannot be used with -lto\n");
+			gb_exit(1);
+		}
+		if (bc->build_mode == BuildMode_Assembly || bc->build_mode == BuildMode_LLVM_IR) {
+			gb_printf_err("-split-dwarf is incompatible with -build-mode:asm and -build-mode:llvm-ir\n");
+			gb_exit(1);
+		}
+	}
+
+	if (bc->pgo_generate && bc->pgo_use_path.len != 0) {
+		gb_printf_err("-pgo-generate and -pgo-use:<filepath> cannot be used together\n");
+		gb_exit(1);
+	}
+	if (bc->pgo_generate && is_arch_wasm()) {
+		gb_printf_err("-pgo-generate is not supported on wasm targets\n");
+		gb_exit(1);
+	}
+
 	bc->ODIN_VALGRIND_SUPPORT = false;
 	if (build_context.metrics.os != TargetOs_windows) {
 		switch (bc->metrics.arch) {
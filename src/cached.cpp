@@ -85,16 +85,6 @@ gb_internal bool try_clear_cache(void) {
 }
 
 
-gb_internal u64 crc64_with_seed(void const *data, isize len, u64 seed) {
-	isize remaining;
-	u64 result = ~seed;
-	u8 const *c = cast(u8 const *)data;
-	for (remaining = len; remaining--; c++) {
-		result = (result >> 8) ^ (GB__CRC64_TABLE[(result ^ *c) & 0xff]);
-	}
-	return ~result;
-}
-
 gb_internal bool check_if_exists_file_otherwise_create(String const &str) {
 	char const *str_c = alloc_cstring(permanent_allocator(), str);
 	if (!gb_file_exists(str_c)) {
@@ -209,12 +199,16 @@ Array<String> cache_gather_files(Checker *c) {
 		}
 	#endif
 
-	for (auto const &entry : c->info.load_file_cache) {
-		auto *cache = entry.value;
-		if (!cache || !cache->exists) {
-			continue;
+	if (!build_context.build_cache_data.content_hash) {
+		// NOTE: in content hash mode, the `#load` inputs are recorded within the manifest instead
+		// so that the cache directory is already known before semantic checking
+		for (auto const &entry : c->info.load_file_cache) {
+			auto *cache = entry.value;
+			if (!cache || !cache->exists) {
+				continue;
+			}
+			array_add(&files, cache->path);
 		}
-		array_add(&files, cache->path);
 	}
 
 	array_sort(files, string_cmp);
@@ -222,6 +216,216 @@ Array<String> cache_gather_files(Checker *c) {
 	return files;
 }
 
+enum CacheInputKind : u8 {
+	CacheInput_Source,    // parsed source file, hash of its contents
+	CacheInput_Load,      // `#load` file, hash of its contents
+	CacheInput_Exists,    // `#exists` file which existed
+	CacheInput_Missing,   // `#load`/`#exists` file which did not exist
+	CacheInput_Directory, // `#load_directory`, hash of its file listing
+
+	CacheInput_COUNT,
+};
+
+gb_global String const cache_input_kind_strings[CacheInput_COUNT] = {
+	str_lit("src"),
+	str_lit("load"),
+	str_lit("exists"),
+	str_lit("missing"),
+	str_lit("dir"),
+};
+
+struct CacheInput {
+	CacheInputKind kind;
+	Hash128        hash;
+	String         path;
+};
+
+gb_internal GB_COMPARE_PROC(cache_input_cmp) {
+	CacheInput const &x = *(CacheInput *)a;
+	CacheInput const &y = *(CacheInput *)b;
+	if (x.kind != y.kind) {
+		return x.kind < y.kind ? -1 : +1;
+	}
+	return string_compare(x.path, y.path);
+}
+
+gb_internal Hash128 cache_hash_file_contents(String const &path, bool *exists_) {
+	gbFileContents fc = gb_file_read_contents(heap_allocator(), false, alloc_cstring(temporary_allocator(), path));
+	defer (gb_file_free_contents(&fc));
+	if (exists_) *exists_ = fc.data != nullptr || gb_file_exists(alloc_cstring(temporary_allocator(), path));
+	return hash128(fc.data, fc.size);
+}
+
+gb_internal Hash128 cache_hash_directory_listing(Array<String> paths) {
+	array_sort(paths, string_cmp);
+	gbString listing = gb_string_make(heap_allocator(), "");
+	defer (gb_string_free(listing));
+	for (String const &path : paths) {
+		listing = gb_string_append_length(listing, path.text, path.len);
+		listing = gb_string_appendc(listing, "\n");
+	}
+	return hash128(listing, gb_string_length(listing));
+}
+
+gb_internal bool cache_hash_directory_from_disk(String const &path, Hash128 *hash_) {
+	Array<FileInfo> list = {};
+	ReadDirectoryError rd_err = read_directory(path, &list);
+	defer (array_free(&list));
+	if (rd_err != ReadDirectory_None) {
+		return false;
+	}
+
+	auto paths = array_make<String>(heap_allocator(), 0, list.count);
+	defer (array_free(&paths));
+	for (FileInfo const &fi : list) {
+		if (!fi.is_dir) {
+			array_add(&paths, fi.fullpath);
+		}
+	}
+	*hash_ = cache_hash_directory_listing(paths);
+	return true;
+}
+
+// All of the inputs of a build for the content hash mode, sorted by kind and then path
+gb_internal Array<CacheInput> cache_gather_inputs(Checker *c) {
+	Parser *p = c->parser;
+
+	auto inputs = array_make<CacheInput>(heap_allocator());
+	for (AstPackage *pkg : p->packages) {
+		for (AstFile *f : pkg->files) {
+			CacheInput input = {CacheInput_Source};
+			input.path = f->fullpath;
+			input.hash = hash128(f->tokenizer.start, f->tokenizer.end - f->tokenizer.start);
+			array_add(&inputs, input);
+		}
+	}
+
+	#if defined(GB_SYSTEM_WINDOWS)
+		if (build_context.has_resource) {
+			CacheInput input = {CacheInput_Load};
+			if (build_context.build_paths[BuildPath_RC].basename == "")  {
+				input.path = path_to_string(permanent_allocator(), build_context.build_paths[BuildPath_RES]);
+			} else {
+				input.path = path_to_string(permanent_allocator(), build_context.build_paths[BuildPath_RC]);
+			}
+			input.hash = cache_hash_file_contents(input.path, nullptr);
+			array_add(&inputs, input);
+		}
+	#endif
+
+	for (auto const &entry : c->info.load_file_cache) {
+		LoadFileCache *cache = entry.value;
+		if (!cache) {
+			continue;
+		}
+		CacheInput input = {};
+		input.path = cache->path;
+		if (!cache->exists) {
+			input.kind = CacheInput_Missing;
+		} else if (cache->tier == LoadFileTier_Exists) {
+			input.kind = CacheInput_Exists;
+		} else {
+			input.kind = CacheInput_Load;
+			input.hash = hash128(cache->data.text, cache->data.len);
+		}
+		array_add(&inputs, input);
+	}
+
+	for (auto const &entry : c->info.load_directory_cache) {
+		LoadDirectoryCache *cache = entry.value;
+		if (!cache) {
+			continue;
+		}
+		auto paths = array_make<String>(heap_allocator(), 0, cache->files.count);
+		defer (array_free(&paths));
+		for (LoadFileCache *file : cache->files) {
+			array_add(&paths, file->path);
+		}
+
+		CacheInput input = {CacheInput_Directory};
+		input.path = cache->path;
+		input.hash = cache_hash_directory_listing(paths);
+		array_add(&inputs, input);
+	}
+
+	array_sort(inputs, cache_input_cmp);
+	return inputs;
+}
+
+// NOTE: only the `#load` related inputs need to be checked against the disk, as their paths are fully
+// determined by the (unchanged) sources, arguments and environment
+gb_internal bool cache_check_input_on_disk(CacheInput const &input) {
+	TEMPORARY_ALLOCATOR_GUARD();
+	switch (input.kind) {
+	case CacheInput_Load: {
+		bool exists = false;
+		Hash128 hash = cache_hash_file_contents(input.path, &exists);
+		return exists && hash == input.hash;
+	}
+	case CacheInput_Exists:
+		return gb_file_exists(alloc_cstring(temporary_allocator(), input.path));
+	case CacheInput_Missing:
+		return !gb_file_exists(alloc_cstring(temporary_allocator(), input.path));
+	case CacheInput_Directory: {
+		Hash128 hash = {};
+		return cache_hash_directory_from_disk(input.path, &hash) && hash == input.hash;
+	}
+	}
+	return false;
+}
+
+// returns false if different, true if it is the same
+gb_internal bool cache_check_files_manifest_content(Checker *c, String const &data) {
+	auto inputs = cache_gather_inputs(c);
+	defer (array_free(&inputs));
+
+	isize source_count = 0;
+	for (CacheInput const &input : inputs) {
+		if (input.kind == CacheInput_Source) {
+			source_count += 1;
+		}
+	}
+
+	String_Iterator it = {data, 0};
+	isize seen_source_count = 0;
+	while (it.pos < data.len) {
+		String line = string_split_iterator(&it, '\n');
+		if (line.len == 0) {
+			break;
+		}
+		String_Iterator line_it = {line, 0};
+		String kind_str = string_split_iterator(&line_it, ' ');
+		String hash_str = string_split_iterator(&line_it, ' ');
+		String path_str = string_trim_whitespace(substring(line, line_it.pos, line.len));
+
+		CacheInput input = {CacheInput_COUNT};
+		for (isize i = 0; i < CacheInput_COUNT; i++) {
+			if (kind_str == cache_input_kind_strings[i]) {
+				input.kind = cast(CacheInputKind)i;
+				break;
+			}
+		}
+		if (input.kind == CacheInput_COUNT || !hash128_from_hex(hash_str, &input.hash)) {
+			return false;
+		}
+		input.path = path_str;
+
+		if (input.kind == CacheInput_Source) {
+			// NOTE: sources are already in memory, so compare against the parsed files
+			if (seen_source_count >= source_count) {
+				return false;
+			}
+			CacheInput const &parsed = inputs[seen_source_count++];
+			if (parsed.path != input.path || parsed.hash != input.hash) {
+				return false;
+			}
+		} else if (!cache_check_input_on_disk(input)) {
+			return false;
+		}
+	}
+	return seen_source_count == source_count;
+}
+
 Array<String> cache_gather_envs() {
 	auto envs = array_make<String>(heap_allocator());
 	{
@@ -257,6 +461,45 @@ Array<String> cache_gather_envs() {
 	return envs;
 }
 
+// returns false if different, true if it is the same
+gb_internal bool cache_check_files_manifest_mtime(Array<String> const &files, String const &data) {
+	String_Iterator it = {data, 0};
+
+	isize file_count = 0;
+
+	for (; it.pos < data.len; file_count++) {
+		String line = string_split_iterator(&it, '\n');
+		if (line.len == 0) {
+			break;
+		}
+		isize sep = string_index_byte(line, ' ');
+		if (sep < 0) {
+			return false;
+		}
+
+		String timestamp_str = substring(line, 0, sep);
+		String path_str = substring(line, sep+1, line.len);
+
+		timestamp_str = string_trim_whitespace(timestamp_str);
+		path_str = string_trim_whitespace(path_str);
+
+		if (file_count >= files.count) {
+			return false;
+		}
+		if (files[file_count] != path_str) {
+			return false;
+		}
+
+		u64 timestamp = exact_value_to_u64(exact_value_integer_from_string(timestamp_str));
+		gbFileTime last_write_time = gb_file_last_write_time(alloc_cstring(temporary_allocator(), path_str));
+		if (last_write_time != timestamp) {
+			return false;
+		}
+	}
+
+	return file_count == files.count;
+}
+
 // returns false if different, true if it is the same
 gb_internal bool try_cached_build(Checker *c, Array<String> const &args) {
 	TEMPORARY_ALLOCATOR_GUARD();
@@ -265,18 +508,24 @@ gb_internal bool try_cached_build(Checker *c, Array<String> const &args) {
 	auto envs = cache_gather_envs();
 	defer (array_free(&envs));
 
-	u64 crc = 0;
-	for (String const &path : files) {
-		crc = crc64_with_seed(path.text, path.len, crc);
+	Hash128 files_hash = {};
+	{
+		gbString joined = gb_string_make(heap_allocator(), "");
+		defer (gb_string_free(joined));
+		for (String const &path : files) {
+			joined = gb_string_append_length(joined, path.text, path.len);
+			joined = gb_string_appendc(joined, "\n");
+		}
+		files_hash = hash128(joined, gb_string_length(joined), build_context.build_cache_data.content_hash);
 	}
 
 	String base_cache_dir = build_context.build_paths[BuildPath_Output].basename;
 	base_cache_dir = concatenate_strings(permanent_allocator(), base_cache_dir, str_lit("/.odin-cache"));
 	(void)check_if_exists_directory_otherwise_create(base_cache_dir);
 
-	gbString crc_str = gb_string_make_reserve(permanent_allocator(), 16);
-	crc_str = gb_string_append_fmt(crc_str, "%016llx", crc);
-	String cache_dir  = concatenate3_strings(permanent_allocator(), base_cache_dir, str_lit("/"), make_string_c(crc_str));
+	gbString hash_str = gb_string_make_reserve(permanent_allocator(), 32);
+	hash_str = hash128_append_hex(hash_str, files_hash);
+	String cache_dir  = concatenate3_strings(permanent_allocator(), base_cache_dir, str_lit("/"), make_string_c(hash_str));
 	String files_path = concatenate3_strings(permanent_allocator(), cache_dir, str_lit("/"), str_lit("files.manifest"));
 	String args_path  = concatenate3_strings(permanent_allocator(), cache_dir, str_lit("/"), str_lit("args.manifest"));
 	String env_path   = concatenate3_strings(permanent_allocator(), cache_dir, str_lit("/"), str_lit("env.manifest"));
@@ -314,41 +563,11 @@ gb_internal bool try_cached_build(Checker *c, Array<String> const &args) {
 		}
 
 		String data = {cast(u8 *)loaded_file.data, loaded_file.size};
-		String_Iterator it = {data, 0};
-
-		isize file_count = 0;
-
-		for (; it.pos < data.len; file_count++) {
-			String line = string_split_iterator(&it, '\n');
-			if (line.len == 0) {
-				break;
-			}
-			isize sep = string_index_byte(line, ' ');
-			if (sep < 0) {
+		if (build_context.build_cache_data.content_hash) {
+			if (!cache_check_files_manifest_content(c, data)) {
 				return false;
 			}
-
-			String timestamp_str = substring(line, 0, sep);
-			String path_str = substring(line, sep+1, line.len);
-
-			timestamp_str = string_trim_whitespace(timestamp_str);
-			path_str = string_trim_whitespace(path_str);
-
-			if (file_count >= files.count) {
-				return false;
-			}
-			if (files[file_count] != path_str) {
-				return false;
-			}
-
-			u64 timestamp = exact_value_to_u64(exact_value_integer_from_string(timestamp_str));
-			gbFileTime last_write_time = gb_file_last_write_time(alloc_cstring(temporary_allocator(), path_str));
-			if (last_write_time != timestamp) {
-				return false;
-			}
-		}
-
-		if (file_count != files.count) {
+		} else if (!cache_check_files_manifest_mtime(files, data)) {
 			return false;
 		}
 	}
@@ -436,9 +655,19 @@ void write_cached_build(Checker *c, Array<String> const &args) {
 		defer (gb_file_close(&f));
 		gb_file_open_mode(&f, gbFileMode_Write, path_c);
 
-		for (String const &path : files) {
-			gbFileTime ft = gb_file_last_write_time(alloc_cstring(temporary_allocator(), path));
-			gb_fprintf(&f, "%llu %.*s\n", cast(unsigned long long)ft, LIT(path));
+		if (build_context.build_cache_data.content_hash) {
+			auto inputs = cache_gather_inputs(c);
+			defer (array_free(&inputs));
+
+			for (CacheInput const &input : inputs) {
+				gbString hash_str = hash128_append_hex(gb_string_make_reserve(temporary_allocator(), 32), input.hash);
+				gb_fprintf(&f, "%.*s %s %.*s\n", LIT(cache_input_kind_strings[input.kind]), hash_str, LIT(input.path));
+			}
+		} else {
+			for (String const &path : files) {
+				gbFileTime ft = gb_file_last_write_time(alloc_cstring(temporary_allocator(), path));
+				gb_fprintf(&f, "%llu %.*s\n", cast(unsigned long long)ft, LIT(path));
+			}
 		}
 	}
 	{
@@ -472,3 +701,156 @@ void write_cached_build(Checker *c, Array<String> const &args) {
 	}
 }
 
+
+
+// Per-module object cache (-object-cache)
+// Objects are stored as `.odin-cache/objects/<hash>.<ext>` where the hash covers the module's bitcode and the target machine settings
+gb_internal String object_cache_init_directory(void) {
+	String base_cache_dir = build_context.build_paths[BuildPath_Output].basename;
+	base_cache_dir = concatenate_strings(permanent_allocator(), base_cache_dir, str_lit("/.odin-cache"));
+	(void)check_if_exists_directory_otherwise_create(base_cache_dir);
+
+	String objects_dir = concatenate_strings(permanent_allocator(), base_cache_dir, str_lit("/objects"));
+	(void)check_if_exists_directory_otherwise_create(objects_dir);
+
+	build_context.build_cache_data.objects_dir = objects_dir;
+	return objects_dir;
+}
+
+// Per-file AST snapshot cache (-ast-cache), see `ast_snapshot.cpp`
+gb_internal String ast_cache_init_directory(void) {
+	String base_cache_dir = build_context.build_paths[BuildPath_Output].basename;
+	base_cache_dir = concatenate_strings(permanent_allocator(), base_cache_dir, str_lit("/.odin-cache"));
+	(void)check_if_exists_directory_otherwise_create(base_cache_dir);
+
+	String ast_dir = concatenate_strings(permanent_allocator(), base_cache_dir, str_lit("/ast"));
+	(void)check_if_exists_directory_otherwise_create(ast_dir);
+
+	build_context.build_cache_data.ast_dir    = ast_dir;
+	build_context.build_cache_data.ast_layout = ast_snapshot_layout_fingerprint();
+	return ast_dir;
+}
+
+gb_internal String object_cache_path_for_hash(Hash128 const &hash) {
+	String dir = build_context.build_cache_data.objects_dir;
+	GB_ASSERT(dir.len != 0);
+	String ext = infer_object_extension_from_build_context();
+
+	gbString path = gb_string_make_length(permanent_allocator(), dir.text, dir.len);
+	path = gb_string_appendc(path, "/");
+	path = hash128_append_hex(path, hash);
+	path = gb_string_append_fmt(path, ".%.*s", LIT(ext));
+	return make_string(cast(u8 *)path, gb_string_length(path));
+}
+
+// Marks a cached object as used now, as `object_cache_prune` removes the least recently used objects first
+gb_internal void object_cache_touch(char const *cache_path_c) {
+#if defined(GB_SYSTEM_WINDOWS)
+	TEMPORARY_ALLOCATOR_GUARD();
+	wchar_t *w_path = gb__alloc_utf8_to_ucs2(temporary_allocator(), cache_path_c, nullptr);
+	HANDLE handle = CreateFileW(w_path, FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ|FILE_SHARE_WRITE|FILE_SHARE_DELETE,
+	                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle != INVALID_HANDLE_VALUE) {
+		FILETIME now = {};
+		GetSystemTimeAsFileTime(&now);
+		SetFileTime(handle, nullptr, nullptr, &now);
+		CloseHandle(handle);
+	}
+#else
+	utimes(cache_path_c, nullptr);
+#endif
+}
+
+// returns true if the cached object was copied to `filepath_obj`
+gb_internal bool object_cache_try_restore(String const &cache_path, String const &filepath_obj) {
+	char const *cache_path_c = alloc_cstring(permanent_allocator(), cache_path);
+	if (!gb_file_exists(cache_path_c)) {
+		return false;
+	}
+	if (!gb_file_copy(cache_path_c, cast(char const *)filepath_obj.text, false)) {
+		return false;
+	}
+	object_cache_touch(cache_path_c);
+	return true;
+}
+
+gb_internal void object_cache_store(String const &filepath_obj, String const &cache_path) {
+	// NOTE: copy to a unique temporary name first and then move it into place,
+	// so that a concurrent build never sees a partially written object
+	gbString tmp_path = gb_string_make_length(permanent_allocator(), cache_path.text, cache_path.len);
+	tmp_path = gb_string_append_fmt(tmp_path, ".tmp-%llx-%p", cast(unsigned long long)time_stamp_time_now(), filepath_obj.text);
+
+	char const *cache_path_c = alloc_cstring(permanent_allocator(), cache_path);
+	if (!gb_file_copy(cast(char const *)filepath_obj.text, tmp_path, false)) {
+		gb_file_remove(tmp_path);
+		return;
+	}
+	if (!gb_file_move(tmp_path, cache_path_c)) {
+		// NOTE: another build may have stored the same object in the meantime
+		gb_file_remove(tmp_path);
+	}
+}
+
+struct ObjectCacheEntry {
+	String     fullpath;
+	i64        size;
+	gbFileTime last_used;
+};
+
+gb_internal GB_COMPARE_PROC(object_cache_entry_cmp) {
+	ObjectCacheEntry const *x = cast(ObjectCacheEntry const *)a;
+	ObjectCacheEntry const *y = cast(ObjectCacheEntry const *)b;
+	if (x->last_used != y->last_used) {
+		return x->last_used < y->last_used ? -1 : +1;
+	}
+	return string_compare(x->fullpath, y->fullpath);
+}
+
+// Removes the least recently used objects until the cache fits in `-object-cache-limit`
+// NOTE: an object removed while another build restores it is only a miss for that build
+gb_internal void object_cache_prune(void) {
+	String dir = build_context.build_cache_data.objects_dir;
+	GB_ASSERT(dir.len != 0);
+
+	Array<FileInfo> list = {};
+	ReadDirectoryError rd_err = read_directory(dir, &list);
+	defer (array_free(&list));
+	if (rd_err != ReadDirectory_None) {
+		return;
+	}
+
+	auto entries = array_make<ObjectCacheEntry>(heap_allocator(), 0, list.count);
+	defer (array_free(&entries));
+
+	i64 total_size = 0;
+	for (FileInfo const &fi : list) {
+		// NOTE: skip the temporary files of a build storing an object right now
+		if (fi.is_dir || string_contains_string(fi.name, str_lit(".tmp-"))) {
+			continue;
+		}
+		ObjectCacheEntry entry = {};
+		entry.fullpath  = fi.fullpath;
+		entry.size      = fi.size;
+		entry.last_used = gb_file_last_write_time(alloc_cstring(temporary_allocator(), fi.fullpath));
+		array_add(&entries, entry);
+		total_size += fi.size;
+	}
+
+	i64 limit = build_context.object_cache_limit_mib * 1024 * 1024;
+	if (total_size <= limit) {
+		return;
+	}
+
+	array_sort(entries, object_cache_entry_cmp);
+	isize removed = 0;
+	for (ObjectCacheEntry const &entry : entries) {
+		if (total_size <= limit) {
+			break;
+		}
+		if (gb_file_remove(alloc_cstring(temporary_allocator(), entry.fullpath))) {
+			total_size -= entry.size;
+			removed += 1;
+		}
+	}
+	debugf("Object Cache: removed %td objects, %lld bytes left\n", removed, cast(long long)total_size);
+}
@@ -170,7 +170,8 @@ gb_internal bool check_asm_immediate_value_fits(ExactValue ev, i32 bits, i32 *ne
 		return true;
 
 	case ExactValue_Integer: {
-		mp_int const *v = &ev.value_integer;
+		BigInt value = exact_value_to_big_int(ev);
+		mp_int const *v = &value;
 		i32 mag_bits = cast(i32)mp_count_bits(v);
 		if (needed_) *needed_ = mag_bits;
 
@@ -268,7 +269,7 @@ gb_internal bool check_asm_operand_size_class(AsmCtx *asm_ctx, typename AsmCtx::
 	if (got_w < 0) {
 		// Untyped constant: width is a property of the value, not the type.
 		if (operand->mode == Addressing_Constant && operand->value.kind == ExactValue_Integer) {
-			got_w = cast(i32)mp_count_bits(&operand->value.value_integer);
+			got_w = exact_value_integer_bit_count(operand->value);
 			if (got_w == 0) {
 				got_w = 1; // zero still occupies a slot
 			}
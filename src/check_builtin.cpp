@@ -6,7 +6,7 @@ gb_internal int enum_constant_entity_cmp(void const* a, void const* b) {
 	GB_ASSERT(ea->kind == Entity_Constant && eb->kind == Entity_Constant);
 	GB_ASSERT(ea->Constant.value.kind == ExactValue_Integer && eb->Constant.value.kind == ExactValue_Integer);
 	
-	return big_int_cmp(&ea->Constant.value.value_integer, &eb->Constant.value.value_integer);
+	return exact_value_integer_cmp(ea->Constant.value, eb->Constant.value);
 }
 
 gb_global BuiltinTypeIsProc *builtin_type_is_procs[BuiltinProc__type_simple_boolean_end - BuiltinProc__type_simple_boolean_begin] = {
@@ -1506,14 +1506,12 @@ gb_internal bool check_builtin_simd_operation(CheckerContext *c, Operand *operan
 					return false;
 				}
 
-				if (big_int_is_neg(&op.value.value_integer)) {
+				if (exact_value_integer_is_neg(op.value)) {
 					error(op.expr, "Negative '%.*s' index", LIT(builtin_name));
 					return false;
 				}
 
-				BigInt mc = {};
-				big_int_from_i64(&mc, max_count);
-				if (big_int_cmp(&mc, &op.value.value_integer) <= 0) {
+				if (exact_value_integer_cmp(exact_value_i64(max_count), op.value) <= 0) {
 					error(op.expr, "'%.*s' index exceeds length", LIT(builtin_name));
 					return false;
 				}
@@ -1701,7 +1699,7 @@ gb_internal bool check_builtin_simd_operation(CheckerContext *c, Operand *operan
 					return false;
 				}
 
-				if (big_int_is_neg(&y.value.value_integer)) {
+				if (exact_value_integer_is_neg(y.value)) {
 					error(y.expr, "Negative '%.*s' index", LIT(builtin_name));
 					return false;
 				}
@@ -2105,6 +2103,17 @@ gb_internal bool cache_load_file_directive(CheckerContext *c, Ast *call, String
 				// Nothing to do.
 				break;
 			case LoadFileTier_Contents: {
+				LoadedFile loaded_file = {};
+				LoadedFileError load_err = load_file_32(c_str, &loaded_file, build_context.copy_file_contents);
+				if (load_err == LoadedFile_None) {
+					data.text = cast(u8 *)loaded_file.data;
+					data.len = loaded_file.size;
+					break;
+				} else if (load_err != LoadedFile_FileTooLarge) {
+					break;
+				}
+
+				// NOTE: files too large for `load_file_32` are read directly
 				isize file_size = cast(isize)gb_file_size(&f);
 				if (file_size > 0) {
 					u8 *ptr = permanent_alloc_array<u8>(file_size+1);
@@ -3027,7 +3036,14 @@ gb_internal bool check_builtin_procedure(CheckerContext *c, Operand *operand, As
 		} else if (is_type_dynamic_array(op_type)) {
 			mode = Addressing_Value;
 		} else if (is_type_map(op_type)) {
-			mode = Addressing_Value;
+			if (operand->mode == Addressing_Constant && operand->value.kind == ExactValue_Compound) {
+				// NOTE: a constant map is a fixed table, its length and capacity are both the entry count
+				mode = Addressing_Constant;
+				value = exact_value_i64(operand->value.value_compound->CompoundLit.elems.count);
+				type = t_untyped_integer;
+			} else {
+				mode = Addressing_Value;
+			}
 		} else if (operand->mode == Addressing_Type && is_type_enum(op_type)) {
 			Type *bt = base_type(op_type);
 			mode = Addressing_Constant;
@@ -3491,14 +3507,12 @@ gb_internal bool check_builtin_procedure(CheckerContext *c, Operand *operand, As
 				return false;
 			}
 
-			if (big_int_is_neg(&op.value.value_integer)) {
+			if (exact_value_integer_is_neg(op.value)) {
 				error(op.expr, "Negative 'swizzle' index");
 				return false;
 			}
 
-			BigInt mc = {};
-			big_int_from_i64(&mc, max_count);
-			if (big_int_cmp(&mc, &op.value.value_integer) <= 0) {
+			if (exact_value_integer_cmp(exact_value_i64(max_count), op.value) <= 0) {
 				error(op.expr, "'swizzle' index exceeds length");
 				return false;
 			}
@@ -4578,7 +4592,9 @@ gb_internal bool check_builtin_procedure(CheckerContext *c, Operand *operand, As
 		if (operand->mode == Addressing_Constant) {
 			switch (operand->value.kind) {
 			case ExactValue_Integer:
-				mp_abs(&operand->value.value_integer, &operand->value.value_integer);
+				if (exact_value_integer_is_neg(operand->value)) {
+					operand->value = exact_unary_operator_value(Token_Sub, operand->value, 0, false);
+				}
 				break;
 			case ExactValue_Float: {
 				u64 abs = bit_cast<u64>(operand->value.value_float);
@@ -5170,7 +5186,7 @@ gb_internal bool check_builtin_procedure(CheckerContext *c, Operand *operand, As
 			return false;
 		}
 
-		int log2 = big_int_log2(&o.value.value_integer);
+		int log2 = exact_value_integer_bit_count(o.value) - 1;
 
 		operand->mode = Addressing_Constant;
 		operand->value = exact_value_i64(cast(i64)log2);
@@ -5224,13 +5240,13 @@ gb_internal bool check_builtin_procedure(CheckerContext *c, Operand *operand, As
 			operand->type = t_invalid;
 			return false;
 		}
-		if (big_int_is_neg(&x.value.value_integer)) {
+		if (exact_value_integer_is_neg(x.value)) {
 			error(call, "Negative array element length");
 			operand->mode = Addressing_Type;
 			operand->type = t_invalid;
 			return false;
 		}
-		i64 count = big_int_to_i64(&x.value.value_integer);
+		i64 count = exact_value_to_i64(x.value);
 
 		check_expr_or_type(c, &y, ce->args[1]);
 		if (y.mode != Addressing_Type) {
@@ -5712,10 +5728,11 @@ gb_internal bool check_builtin_procedure(CheckerContext *c, Operand *operand, As
 				size_t nails = 0;
 				mp_endian endian = MP_LITTLE_ENDIAN;
 
-				max_count = mp_pack_count(&x.value.value_integer, nails, size);
+				BigInt value = exact_value_to_big_int(x.value);
+				max_count = mp_pack_count(&value, nails, size);
 				GB_ASSERT(sz >= cast(i64)max_count);
 
-				mp_err err = mp_pack(rop, max_count, &written, MP_LSB_FIRST, size, endian, nails, &x.value.value_integer);
+				mp_err err = mp_pack(rop, max_count, &written, MP_LSB_FIRST, size, endian, nails, &value);
 				GB_ASSERT(err == MP_OKAY);
 
 				if (id != BuiltinProc_reverse_bits) {
@@ -7710,7 +7727,7 @@ gb_internal bool check_builtin_procedure(CheckerContext *c, Operand *operand, As
 				return false;
 			}
 			
-			i64 index = big_int_to_i64(&x.value.value_integer);
+			i64 index = exact_value_to_i64(x.value);
 			if (index < 0 || index >= u->Union.variants.count) {
 				error(call, "Variant tag out of bounds index for '%.*s", LIT(builtin_name));
 				operand->mode = Addressing_Type;
@@ -8322,21 +8339,18 @@ gb_internal bool check_builtin_procedure(CheckerContext *c, Operand *operand, As
 			array_copy(&enum_constants, type->Enum.fields, 0);
 			array_sort(enum_constants, enum_constant_entity_cmp);
 			
-			BigInt minus_one = big_int_make_i64(-1);
-			defer (big_int_dealloc(&minus_one));
-			BigInt diff = {};
+			ExactValue minus_one = exact_value_i64(-1);
 			
 			bool contiguous = true;
 			operand->mode = Addressing_Constant;
 			operand->type = t_untyped_bool;
 			
 			for (isize i = 0; i < enum_constants.count - 1; i++) {
-				BigInt curr = enum_constants[i]->Constant.value.value_integer;
-				BigInt next = enum_constants[i + 1]->Constant.value.value_integer;
-				big_int_sub(&diff, &curr, &next);
-				defer (big_int_dealloc(&diff));
+				ExactValue curr = enum_constants[i]->Constant.value;
+				ExactValue next = enum_constants[i + 1]->Constant.value;
+				ExactValue diff = exact_value_sub(curr, next);
 				
-				if (!big_int_is_zero(&diff) && big_int_cmp(&diff, &minus_one) != 0) {
+				if (!exact_value_integer_is_zero(diff) && exact_value_integer_cmp(diff, minus_one) != 0) {
 					contiguous = false;
 					break;
 				}
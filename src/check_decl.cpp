@@ -173,8 +173,14 @@ gb_internal void override_entity_in_scope(Entity *original_entity, Entity *new_e
 	// Therefore two things can be done: the type can be assigned to state that it
 	// has been "evaluated" and the variant data can be copied across
 
+	// NOTE: a sealed scope is read by other threads without the mutex, so its existing entry must only
+	// have its value replaced, as an insert could grow the map underneath them
 	rw_mutex_lock(&found_scope->mutex);
-	scope_map_insert(&found_scope->elements, original_intern, hash, new_entity);
+	if (found_scope->flags.load(std::memory_order_relaxed) & ScopeFlag_Sealed) {
+		scope_map_replace(&found_scope->elements, original_intern, hash, new_entity);
+	} else {
+		scope_map_insert(&found_scope->elements, original_intern, hash, new_entity);
+	}
 	rw_mutex_unlock(&found_scope->mutex);
 
 	original_entity->flags |= EntityFlag_Overridden;
@@ -649,6 +655,13 @@ gb_internal void check_const_decl(CheckerContext *ctx, Entity *e, Ast *type_expr
 
 	Operand operand = {};
 
+	// NOTE: a non-empty map literal is only a constant when it is directly the value of a constant declaration
+	bool prev_allow_constant_map_literal = ctx->allow_constant_map_literal;
+	ctx->allow_constant_map_literal = init != nullptr && (init->kind == Ast_CompoundLit ||
+	                                                      init->kind == Ast_Ident ||
+	                                                      init->kind == Ast_SelectorExpr);
+	defer (ctx->allow_constant_map_literal = prev_allow_constant_map_literal);
+
 	if (init != nullptr) {
 		Entity *entity = check_entity_from_ident_or_selector(ctx, init, false);
 		if (check_override_as_type_due_to_aliasing(ctx, e, entity, init, named_type)) {
@@ -1260,6 +1273,96 @@ gb_internal void check_foreign_procedure(CheckerContext *ctx, Entity *e, DeclInf
 	mutex_unlock(&ctx->info->foreign_mutex);
 }
 
+// NOTE: Keep in sync with `target_clone_features` in base:runtime (base/runtime/target_clones_x86.odin)
+gb_global String const target_clones_detectable_features = str_lit(
+	"adx,aes,avx,avx2,avx512bitalg,avx512bw,avx512cd,avx512dq,avx512f,avx512fp16,avx512ifma,avx512vbmi,avx512vbmi2,"
+	"avx512vl,avx512vnni,avx512vp2intersect,avx512vpopcntdq,bmi,bmi2,clflushopt,cx16,ermsb,f16c,fma,gfni,lzcnt,movbe,"
+	"pclmul,popcnt,prfchw,rdpid,rdrnd,rdseed,sha,sse,sse2,sse3,sse4.1,sse4.2,sse4a,ssse3,vaes,vpclmulqdq,xsave"
+);
+
+gb_internal void check_proc_target_clones(CheckerContext *ctx, Entity *e, AstProcLit *pl, AttributeContext const &ac) {
+	if (ac.require_target_feature.len != 0 || ac.enable_target_feature.len != 0) {
+		error(e->token, "A procedure cannot have both @(target_clones=\"...\") and @(require_target_feature=\"...\") or @(enable_target_feature=\"...\")");
+		return;
+	}
+	// NOTE: the clone is picked at runtime with cpuid, see `__target_clones_supported` in base:runtime
+	if (build_context.metrics.arch != TargetArch_amd64 && build_context.metrics.arch != TargetArch_i386) {
+		error(e->token, "@(target_clones=\"...\") is only supported on i386 and amd64");
+		return;
+	}
+	if (pl->body == nullptr) {
+		error(e->token, "@(target_clones=\"...\") is not allowed on foreign procedures");
+		return;
+	}
+	if (pl->inlining == ProcInlining_inline) {
+		error(e->token, "#force_inline cannot be used in conjunction with @(target_clones=\"...\")");
+	}
+
+	Type *pt = base_type(e->type);
+	if (pt->Proc.calling_convention == ProcCC_Naked) {
+		error(e->token, "@(target_clones=\"...\") is not allowed on \"naked\" procedures");
+		return;
+	}
+
+	// NOTE: vectors wider than 128 bits are passed in different registers depending on the enabled
+	// features, so the dispatcher and the clones would not agree on how to pass them
+	Type *tuples[2] = {pt->Proc.params, pt->Proc.results};
+	for (Type *tuple : tuples) {
+		if (tuple == nullptr) {
+			continue;
+		}
+		for (Entity *v : tuple->Tuple.variables) {
+			if (is_type_simd_vector(v->type) && type_size_of(v->type) > 16) {
+				gbString str = type_to_string(v->type);
+				error(e->token, "@(target_clones=\"...\") procedures cannot pass or return '%s' by value, use a pointer or an array", str);
+				gb_string_free(str);
+			}
+		}
+	}
+
+	isize default_count = 0;
+	isize clone_count = 0;
+	String_Iterator it = {ac.target_clones, 0};
+	for (;;) {
+		String clone = string_trim_whitespace(string_split_iterator(&it, ','));
+		if (clone == "") break;
+
+		if (clone == "default") {
+			default_count += 1;
+			continue;
+		}
+		clone_count += 1;
+
+		// NOTE: '+' joins the features of a single clone, e.g. "avx2+fma"
+		String_Iterator fit = {clone, 0};
+		for (;;) {
+			String feature = string_split_iterator(&fit, '+');
+			if (feature == "") {
+				if (fit.pos < clone.len) {
+					error(e->token, "Invalid feature set '%.*s' in @(target_clones=\"...\"), features are joined with '+'", LIT(clone));
+				}
+				break;
+			}
+			String invalid;
+			if (!check_target_feature_is_valid_for_target_arch(feature, &invalid)) {
+				error(e->token, "Target clone feature '%.*s' is not a valid target feature for the current target architecture", LIT(invalid));
+			} else if (!check_single_target_feature_is_valid(target_clones_detectable_features, feature)) {
+				error(e->token, "Target clone feature '%.*s' cannot be detected at runtime", LIT(feature));
+			}
+		}
+	}
+
+	if (default_count != 1) {
+		error(e->token, "@(target_clones=\"...\") expects exactly one \"default\" entry, got %td", default_count);
+	}
+	if (clone_count == 0) {
+		error(e->token, "@(target_clones=\"...\") expects at least one feature set besides \"default\"");
+	}
+
+	pt->Proc.target_clones = ac.target_clones;
+	add_package_dependency(ctx, "runtime", "__target_clones_supported");
+}
+
 gb_internal void check_proc_decl(CheckerContext *ctx, Entity *e, DeclInfo *d) {
 	GB_ASSERT(e->type == nullptr);
 	if (d->proc_lit->kind != Ast_ProcLit) {
@@ -1380,6 +1483,10 @@ gb_internal void check_proc_decl(CheckerContext *ctx, Entity *e, DeclInfo *d) {
 				error(e->token, "Procedure enabled target feature '%.*s' is not a valid target feature", LIT(invalid));
 			}
 		}
+
+		if (ac.target_clones.len != 0) {
+			check_proc_target_clones(ctx, e, pl, ac);
+		}
 	}
 
 	switch (e->Procedure.optimization_mode) {
@@ -1770,6 +1877,8 @@ gb_internal void check_global_variable_decl(CheckerContext *ctx, Entity *e, Ast
 			name = e->Variable.link_name;
 		}
 
+		mutex_lock(&ctx->info->foreign_mutex);
+
 		auto *fp = &ctx->info->foreigns;
 		StringHashKey key = string_hash_string(name);
 		Entity **found = string_map_get(fp, key);
@@ -1787,6 +1896,8 @@ gb_internal void check_global_variable_decl(CheckerContext *ctx, Entity *e, Ast
 		} else {
 			string_map_set(fp, key, e);
 		}
+
+		mutex_unlock(&ctx->info->foreign_mutex);
 	}
 	
 	if (e->Variable.link_name.len > 0) {
@@ -2155,9 +2266,11 @@ gb_internal void check_entity_decl(CheckerContext *ctx, Entity *e, DeclInfo *d,
 		c.decl  = d;
 		c.type_level = 0;
 		c.curr_proc_calling_convention = ProcCC_Contextless;
+		// NOTE: only the declaration being checked may allow a constant map, not one reached through its value
+		c.allow_constant_map_literal = false;
 
-		auto prev_flags = c.scope->flags;
-		defer (c.scope->flags = prev_flags);
+		i32 prev_flags = c.scope->flags.load();
+		defer (c.scope->flags.store(prev_flags));
 
 		if (check_feature_flags(ctx, d->decl_node) & OptInFeatureFlag_GlobalContext) {
 			c.scope->flags |= ScopeFlag_ContextDefined;
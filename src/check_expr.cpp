@@ -103,6 +103,7 @@ gb_internal void check_assignment_error_suggestion(CheckerContext *c, Operand *o
 gb_internal char const *zero_value_suggestion(Operand *o, Type *type);
 gb_internal bool check_is_expressible(CheckerContext *ctx, Operand *o, Type *type);
 gb_internal void add_map_key_type_dependencies(CheckerContext *ctx, Type *key);
+gb_internal Ast *check_constant_map_find(ExactValue const &map, ExactValue const &key);
 
 gb_internal Type *make_soa_struct_fixed(CheckerContext *ctx, Ast *array_typ_expr, Ast *elem_expr, Type *elem, i64 count, Type *generic_type);
 gb_internal Type *make_soa_struct_slice(CheckerContext *ctx, Ast *array_typ_expr, Ast *elem_expr, Type *elem);
@@ -123,7 +124,7 @@ gb_internal isize get_procedure_param_count_excluding_defaults(Type *pt, isize *
 
 gb_internal bool is_expr_inferred_fixed_array(Ast *type_expr);
 
-gb_internal Entity *find_polymorphic_record_entity(GenTypesData *found_gen_types, isize param_count, Array<Operand> const &ordered_operands);
+gb_internal Entity *find_polymorphic_record_entity(GenTypesData *found_gen_types, isize param_count, Array<Operand> const &ordered_operands, TypeTuple *params);
 
 gb_internal bool complete_soa_type(Checker *checker, Type *t, bool wait_to_finish);
 
@@ -294,6 +295,26 @@ gb_internal void error_operand_not_expression(Operand *o) {
 	}
 }
 
+gb_internal bool is_operand_constant_map(Operand const *o) {
+	if (o->mode != Addressing_Constant || !is_type_map(o->type)) {
+		return false;
+	}
+	if (o->value.kind != ExactValue_Compound || o->value.value_compound == nullptr) {
+		return false;
+	}
+	// NOTE: an empty constant map literal is still usable as a 'nil' map value
+	return o->value.value_compound->CompoundLit.elems.count != 0;
+}
+
+gb_internal void error_operand_constant_map(Operand *o) {
+	if (is_operand_constant_map(o)) {
+		gbString err = expr_to_string(o->expr);
+		error(o->expr, "'%s' is a constant map and may only be indexed, tested with 'in' or 'not_in', or passed to 'len' or 'cap'", err);
+		gb_string_free(err);
+		o->mode = Addressing_Invalid;
+	}
+}
+
 gb_internal void error_operand_no_value(Operand *o) {
 	if (o->mode == Addressing_NoValue) {
 		Ast *x = unparen_expr(o->expr);
@@ -332,6 +353,13 @@ gb_internal void add_map_get_dependencies(CheckerContext *c) {
 	}
 }
 
+gb_internal void add_constant_map_get_dependencies(CheckerContext *c, Type *key) {
+	add_map_key_type_dependencies(c, key);
+	if (is_type_string(key)) {
+		add_package_dependency(c, "runtime", "string_eq");
+	}
+}
+
 gb_internal void add_map_set_dependencies(CheckerContext *c) {
 	if (build_context.bedrock) {
 		return;
@@ -384,6 +412,59 @@ gb_internal void check_scope_decls(CheckerContext *c, Slice<Ast *> const &nodes,
 	}
 }
 
+// Mixes `type` (and the `value` of a constant parameter) into a key used to index polymorphic instantiations.
+// Returns 0 (no key) if `type` is still polymorphic, and those instantiations are kept in the unkeyed arrays.
+gb_internal u64 polymorphic_instance_key_append(u64 key, Type *type, ExactValue const *value = nullptr) {
+	if (key == 0 || type == nullptr || is_type_polymorphic(type)) {
+		return 0;
+	}
+	key = type_hash_identical_mix(key, type_hash_identical(type));
+	if (value != nullptr) {
+		key = type_hash_identical_mix(key, hash_exact_value_for_equality(*value));
+	}
+	if (key == 0 || key == PtrMapConstant<u64>::TOMBSTONE()) {
+		key = 1;
+	}
+	return key;
+}
+
+gb_internal u64 polymorphic_procedure_key(Type *proc_type) {
+	Type *params = base_type(proc_type)->Proc.params;
+	u64 key = 0xcbf29ce484222325ull;
+	if (params != nullptr) {
+		for (Entity *param : params->Tuple.variables) {
+			key = polymorphic_instance_key_append(key, param->type, param->kind == Entity_Constant ? &param->Constant.value : nullptr);
+		}
+	}
+	return key;
+}
+
+// NOTE: `gen_procs->mutex` must be held
+gb_internal Entity *find_polymorphic_procedure_instance(GenProcsData *gen_procs, Type *proc_type, u64 key) {
+	if (key == 0) {
+		for (Entity *other : gen_procs->procs) {
+			if (are_types_identical(base_type(other->type), proc_type)) {
+				return other;
+			}
+		}
+		return nullptr;
+	}
+
+	for (auto *entry = multi_map_find_first(&gen_procs->procs_by_key, key);
+	     entry != nullptr;
+	     entry = multi_map_find_next(&gen_procs->procs_by_key, entry)) {
+		if (are_types_identical(base_type(entry->value->type), proc_type)) {
+			return entry->value;
+		}
+	}
+	for (Entity *other : gen_procs->unkeyed_procs) {
+		if (are_types_identical(base_type(other->type), proc_type)) {
+			return other;
+		}
+	}
+	return nullptr;
+}
+
 gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, Entity *base_entity, Type *type,
                                                         Array<Operand> const *param_operands, Ast *poly_def_node, PolyProcData *poly_proc_data) {
 	///////////////////////////////////////////////////////////////////////////////
@@ -504,22 +585,19 @@ gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, E
 
 		mutex_unlock(&base_entity->Procedure.gen_procs_mutex); // @entity-mutex
 
-		for (Entity *other : gen_procs->procs) {
-			Type *pt = base_type(other->type);
-			if (are_types_identical(pt, final_proc_type)) {
-				rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
+		Entity *other = find_polymorphic_procedure_instance(gen_procs, final_proc_type, polymorphic_procedure_key(final_proc_type));
+		rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
 
-				if (poly_proc_data) {
-					poly_proc_data->gen_entity = other;
-				}
-				return true;
+		if (other != nullptr) {
+			if (poly_proc_data) {
+				poly_proc_data->gen_entity = other;
 			}
+			return true;
 		}
-
-		rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
 	} else {
 		gen_procs = permanent_alloc_item<GenProcsData>();
 		gen_procs->procs.allocator = heap_allocator();
+		gen_procs->unkeyed_procs.allocator = heap_allocator();
 		base_entity->Procedure.gen_procs = gen_procs;
 		mutex_unlock(&base_entity->Procedure.gen_procs_mutex); // @entity-mutex
 	}
@@ -544,34 +622,31 @@ gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, E
 		}
 
 		rw_mutex_shared_lock(&gen_procs->mutex); // @local-mutex
-		for (Entity *other : gen_procs->procs) {
-			Type *pt = base_type(other->type);
-			if (are_types_identical(pt, final_proc_type)) {
-				rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
-
-				if (poly_proc_data) {
-					poly_proc_data->gen_entity = other;
-				}
+		Entity *other = find_polymorphic_procedure_instance(gen_procs, final_proc_type, polymorphic_procedure_key(final_proc_type));
+		rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
 
-				DeclInfo *decl = other->decl_info;
-				if (decl->proc_checked_state != ProcCheckedState_Checked) {
-					ProcInfo *proc_info = permanent_alloc_item<ProcInfo>();
-					proc_info->file  = other->file;
-					proc_info->token = other->token;
-					proc_info->decl  = decl;
-					proc_info->type  = other->type;
-					proc_info->body  = decl->proc_lit->ProcLit.body;
-					proc_info->tags  = other->Procedure.tags;;
-					proc_info->generated_from_polymorphic = true;
-					proc_info->poly_def_node = poly_def_node;
+		if (other != nullptr) {
+			if (poly_proc_data) {
+				poly_proc_data->gen_entity = other;
+			}
 
-					check_procedure_later(nctx.checker, proc_info);
-				}
+			DeclInfo *decl = other->decl_info;
+			if (decl->proc_checked_state != ProcCheckedState_Checked) {
+				ProcInfo *proc_info = permanent_alloc_item<ProcInfo>();
+				proc_info->file  = other->file;
+				proc_info->token = other->token;
+				proc_info->decl  = decl;
+				proc_info->type  = other->type;
+				proc_info->body  = decl->proc_lit->ProcLit.body;
+				proc_info->tags  = other->Procedure.tags;;
+				proc_info->generated_from_polymorphic = true;
+				proc_info->poly_def_node = poly_def_node;
 
-				return true;
+				check_procedure_later(nctx.checker, proc_info);
 			}
+
+			return true;
 		}
-		rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
 	}
 
 
@@ -591,6 +666,7 @@ gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, E
 	final_proc_type->Proc.optional_ok            = src->Proc.optional_ok;
 	final_proc_type->Proc.enable_target_feature  = src->Proc.enable_target_feature;
 	final_proc_type->Proc.require_target_feature = src->Proc.require_target_feature;
+	final_proc_type->Proc.target_clones          = src->Proc.target_clones;
 
 
 	for (isize i = 0; i < operands.count; i++) {
@@ -645,8 +721,14 @@ gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, E
 		}
 	}
 
+	u64 gen_key = polymorphic_procedure_key(final_proc_type);
 	rw_mutex_lock(&gen_procs->mutex); // @local-mutex
 		array_add(&gen_procs->procs, entity);
+		if (gen_key != 0) {
+			multi_map_insert(&gen_procs->procs_by_key, gen_key, entity);
+		} else {
+			array_add(&gen_procs->unkeyed_procs, entity);
+		}
 	rw_mutex_unlock(&gen_procs->mutex); // @local-mutex
 
 	ProcInfo *proc_info = permanent_alloc_item<ProcInfo>();
@@ -1158,6 +1240,13 @@ gb_internal void check_assignment(CheckerContext *c, Operand *operand, Type *typ
 		return;
 	}
 
+	if (!c->allow_constant_map_literal) {
+		error_operand_constant_map(operand);
+		if (operand->mode == Addressing_Invalid) {
+			return;
+		}
+	}
+
 	if (is_type_untyped(operand->type)) {
 		Type *target_type = type;
 		Type *elem_type = core_broadcastable_elem_type(type);
@@ -1438,7 +1527,7 @@ gb_internal bool polymorphic_assign_index(Type **gt_, i64 *dst_count, i64 source
 		if (e->Constant.value.kind != ExactValue_Integer) {
 			return false;
 		}
-		i64 count = big_int_to_i64(&e->Constant.value.value_integer);
+		i64 count = exact_value_to_i64(e->Constant.value);
 		if (count != source_count) {
 			return false;
 		}
@@ -2360,9 +2449,26 @@ gb_internal bool check_representable_as_constant(CheckerContext *c, ExactValue i
 			return true;
 		}
 
-		BigInt i = v.value_integer;
-
 		i64 byte_size = type_size_of(type);
+
+		if (v.is_small_integer && byte_size <= 8) {
+			i64 x = v.value_small_integer;
+			i64 bit_size = 8*byte_size;
+			if (c->bit_field_bit_size > 0) {
+				bit_size = gb_min(bit_size, cast(i64)c->bit_field_bit_size);
+			}
+			if (is_type_unsigned(type)) {
+				return x >= 0 && (bit_size >= 63 || x < (cast(i64)1 << bit_size));
+			}
+			if (bit_size >= 64) {
+				return true;
+			}
+			i64 limit = cast(i64)1 << (bit_size-1);
+			return -limit <= x && x < limit;
+		}
+
+		BigInt i = exact_value_to_big_int(v);
+
 		BigInt umax;
 		BigInt imin;
 		BigInt imax;
@@ -2642,7 +2748,8 @@ gb_internal bool check_integer_exceed_suggestion(CheckerContext *c, Operand *o,
 			size_changed = (bit_size != max_bit_size);
 			bit_size = gb_min(bit_size, max_bit_size);
 		}
-		BigInt *bi = &o->value.value_integer;
+		BigInt value = exact_value_to_big_int(o->value);
+		BigInt *bi = &value;
 		if (is_type_unsigned(type)) {
 			BigInt one = big_int_make_u64(1);
 			BigInt max_size = big_int_make_u64(1);
@@ -2923,12 +3030,6 @@ gb_internal ExactValue exact_bit_set_all_set_mask(Type *type) {
 	bool is_backed = underlying != nullptr;
 	gb_unused(is_backed);
 
-	BigInt b_lower = {};
-	BigInt b_upper = {};
-	big_int_from_i64(&b_lower, lower);
-	big_int_from_i64(&b_upper, upper);
-
-
 	BigInt one = {};
 	big_int_from_u64(&one, 1);
 
@@ -2941,8 +3042,8 @@ gb_internal ExactValue exact_bit_set_all_set_mask(Type *type) {
 		GB_ASSERT(e->kind == Type_Enum);
 		gb_unused(e);
 
-		if ((big_int_cmp(&e->Enum.min_value->value_integer, &b_lower) == 0 || is_backed) &&
-		    big_int_cmp(&e->Enum.max_value->value_integer, &b_upper) == 0) {
+		if ((exact_value_integer_cmp(*e->Enum.min_value, exact_value_i64(lower)) == 0 || is_backed) &&
+		    exact_value_integer_cmp(*e->Enum.max_value, exact_value_i64(upper)) == 0) {
 
 			i64 lower_base = is_backed ? gb_min(0, lower) : lower;
 			BigInt b_lower_base = {};
@@ -2956,8 +3057,9 @@ gb_internal ExactValue exact_bit_set_all_set_mask(Type *type) {
 					continue;
 				}
 
+				BigInt field_value = exact_value_to_big_int(f->Constant.value);
 				BigInt shift_amount = {};
-				big_int_sub(&shift_amount, &f->Constant.value.value_integer, &b_lower_base);
+				big_int_sub(&shift_amount, &field_value, &b_lower_base);
 
 				BigInt value = {};
 				big_int_shl(&value, &one, &shift_amount);
@@ -2983,10 +3085,7 @@ gb_internal ExactValue exact_bit_set_all_set_mask(Type *type) {
 	}
 
 
-	ExactValue res = {};
-	res.kind = ExactValue_Integer;
-	res.value_integer = mask;
-	return res;
+	return exact_value_big_int(mask);
 }
 
 gb_internal void check_unary_expr(CheckerContext *c, Operand *o, Token op, Ast *node) {
@@ -3273,6 +3372,13 @@ gb_internal void add_comparison_procedures_for_fields(CheckerContext *c, Type *t
 
 
 gb_internal void check_comparison(CheckerContext *c, Ast *node, Operand *x, Operand *y, TokenKind op) {
+	error_operand_constant_map(x);
+	error_operand_constant_map(y);
+	if (x->mode == Addressing_Invalid || y->mode == Addressing_Invalid) {
+		x->mode = Addressing_Invalid;
+		return;
+	}
+
 	if (x->mode == Addressing_Type && y->mode == Addressing_Type) {
 		bool comp = are_types_identical(x->type, y->type);
 		switch (op) {
@@ -3568,7 +3674,7 @@ gb_internal void check_shift(CheckerContext *c, Operand *x, Operand *y, Ast *nod
 	}
 
 	if (y->mode == Addressing_Constant) {
-		if (big_int_is_neg(&y->value.value_integer)) {
+		if (exact_value_integer_is_neg(y->value)) {
 			gbString y_str = expr_to_string(y->expr);
 			error(y->expr, "Shift amount '%s' cannot be negative", y_str);
 			gb_string_free(y_str);
@@ -3576,10 +3682,7 @@ gb_internal void check_shift(CheckerContext *c, Operand *x, Operand *y, Ast *nod
 			return;
 		}
 
-		BigInt max_shift = {};
-		big_int_from_u64(&max_shift, MAX_BIG_INT_SHIFT);
-
-		if (big_int_cmp(&y->value.value_integer, &max_shift) > 0) {
+		if (exact_value_integer_cmp(y->value, exact_value_i64(MAX_BIG_INT_SHIFT)) > 0) {
 			gbString y_str = expr_to_string(y->expr);
 			error(y->expr, "Shift amount '%s' must be <= %u", y_str, MAX_BIG_INT_SHIFT);
 			gb_string_free(y_str);
@@ -4178,7 +4281,27 @@ gb_internal bool check_transmute(CheckerContext *c, Ast *node, Operand *o, Type
 			if (types_have_same_internal_endian(src_t, dst_t)) {
 				ExactValue src_v = exact_value_to_integer(o->value);
 				GB_ASSERT(src_v.kind == ExactValue_Integer || src_v.kind == ExactValue_Invalid);
-				BigInt v = big_int_make(&src_v.value_integer);
+				if (src_v.kind == ExactValue_Integer && src_v.is_small_integer && srcz <= 8) {
+					// NOTE: the same as below, without a BigInt; a u64 value which fits in an i64 is
+					// already below the signed maximum, and `cast(u64)x` is `x + 2^64` when negative
+					i64 x = src_v.value_small_integer;
+					if (is_type_unsigned(src_t) && !is_type_unsigned(dst_t)) {
+						if (srcz < 8 && x >= (cast(i64)1 << (srcz*8 - 1))) {
+							x -= cast(i64)1 << (srcz*8);
+						}
+					} else if (!is_type_unsigned(src_t) && is_type_unsigned(dst_t)) {
+						if (x < 0 && srcz == 8) {
+							o->value = exact_value_u64(cast(u64)x);
+							return true;
+						}
+						if (x < 0) {
+							x += cast(i64)1 << (srcz*8);
+						}
+					}
+					o->value = exact_value_i64(x);
+					return true;
+				}
+				BigInt v = exact_value_to_big_int(src_v);
 
 				BigInt smax = {};
 				BigInt umax = {};
@@ -4200,8 +4323,7 @@ gb_internal bool check_transmute(CheckerContext *c, Ast *node, Operand *o, Type
 					}
 				}
 
-				o->value.kind = ExactValue_Integer;
-				o->value.value_integer = v;
+				o->value = exact_value_big_int(v);
 				return true;
 			}
 		}
@@ -4583,7 +4705,19 @@ gb_internal void check_binary_expr(CheckerContext *c, Operand *x, Ast *node, Typ
 				check_assignment(c, x, yt->Map.key, str_lit("map 'not_in'"));
 			}
 
-			add_map_get_dependencies(c);
+			if (y->mode == Addressing_Constant) {
+				if (x->mode == Addressing_Constant) {
+					bool found = check_constant_map_find(y->value, x->value) != nullptr;
+					x->mode = Addressing_Constant;
+					x->type = t_untyped_bool;
+					x->value = exact_value_bool(op.kind == Token_in ? found : !found);
+					x->expr = node;
+					return;
+				}
+				add_constant_map_get_dependencies(c, yt->Map.key);
+			} else {
+				add_map_get_dependencies(c);
+			}
 		} else if (is_type_bit_set(rhs_type)) {
 			Type *yt = base_type(rhs_type);
 
@@ -4597,7 +4731,7 @@ gb_internal void check_binary_expr(CheckerContext *c, Operand *x, Ast *node, Typ
 				ExactValue v = exact_value_to_integer(y->value);
 				GB_ASSERT(k.kind == ExactValue_Integer);
 				GB_ASSERT(v.kind == ExactValue_Integer);
-				i64 key = big_int_to_i64(&k.value_integer);
+				i64 key = exact_value_to_i64(k);
 				i64 lower = yt->BitSet.lower;
 				i64 upper = yt->BitSet.upper;
 
@@ -4606,8 +4740,9 @@ gb_internal void check_binary_expr(CheckerContext *c, Operand *x, Ast *node, Typ
 					BigInt bit = big_int_make_i64(1);
 					big_int_shl_eq(&bit, &idx);
 
+					BigInt set = exact_value_to_big_int(v);
 					BigInt mask = {};
-					big_int_and(&mask, &bit, &v.value_integer);
+					big_int_and(&mask, &bit, &set);
 
 					x->mode = Addressing_Constant;
 					x->type = t_untyped_bool;
@@ -4805,7 +4940,7 @@ gb_internal void check_binary_expr(CheckerContext *c, Operand *x, Ast *node, Typ
 			bool fail = false;
 			switch (y->value.kind) {
 			case ExactValue_Integer:
-				if (big_int_is_zero(&y->value.value_integer)) {
+				if (exact_value_integer_is_zero(y->value)) {
 					fail = true;
 				}
 				break;
@@ -4880,7 +5015,7 @@ gb_internal void check_binary_expr(CheckerContext *c, Operand *x, Ast *node, Typ
 
 		IntegerDivisionByZeroKind zero_behaviour = check_for_integer_division_by_zero(c, node);
 		if (zero_behaviour != IntegerDivisionByZero_Trap &&
-		    b.kind == ExactValue_Integer && big_int_is_zero(&b.value_integer) &&
+		    b.kind == ExactValue_Integer && exact_value_integer_is_zero(b) &&
 		    (op.kind == Token_QuoEq || op.kind == Token_Mod || op.kind == Token_ModMod)) {
 		    	if (op.kind == Token_QuoEq) {
 		    		switch (zero_behaviour) {
@@ -5470,10 +5605,11 @@ gb_internal bool check_index_value(CheckerContext *c, Type *main_type, bool open
 
 	if (operand.mode == Addressing_Constant &&
 	    (c->state_flags & StateFlag_no_bounds_check) == 0) {
-		BigInt i = exact_value_to_integer(operand.value).value_integer;
-		if (i.sign && !is_type_enum(index_type) && !is_type_multi_pointer(main_type)) {
+		ExactValue i = exact_value_to_integer(operand.value);
+		if (exact_value_integer_is_neg(i) && !is_type_enum(index_type) && !is_type_multi_pointer(main_type)) {
 			TEMPORARY_ALLOCATOR_GUARD();
-			String idx_str = big_int_to_string(temporary_allocator(), &i);
+			BigInt bi = exact_value_to_big_int(i);
+			String idx_str = big_int_to_string(temporary_allocator(), &bi);
 			gbString expr_str = expr_to_string(operand.expr, temporary_allocator());
 			error(operand.expr, "Index '%s' cannot be a negative value, got %.*s", expr_str, LIT(idx_str));
 			if (value) *value = 0;
@@ -5521,8 +5657,8 @@ gb_internal bool check_index_value(CheckerContext *c, Type *main_type, bool open
 
 			} else { // NOTE(bill): Do array bound checking
 				i64 v = -1;
-				if (i.used <= 1) {
-					v = big_int_to_i64(&i);
+				if (i.is_small_integer) {
+					v = i.value_small_integer;
 				}
 				if (value) *value = v;
 				bool out_of_bounds = false;
@@ -5536,7 +5672,8 @@ gb_internal bool check_index_value(CheckerContext *c, Type *main_type, bool open
 
 				if (out_of_bounds) {
 					TEMPORARY_ALLOCATOR_GUARD();
-					String idx_str = big_int_to_string(temporary_allocator(), &i);
+					BigInt bi = exact_value_to_big_int(i);
+					String idx_str = big_int_to_string(temporary_allocator(), &bi);
 					gbString expr_str = expr_to_string(operand.expr, temporary_allocator());
 					char range_type = open_range ? '=' : '<';
 					error(operand.expr, "Index '%s' is out of bounds range 0..%c%lld, got %.*s", expr_str, range_type, cast(long long)max_count, LIT(idx_str));
@@ -8322,7 +8459,7 @@ gb_internal CallArgumentError check_polymorphic_record_type(CheckerContext *c, O
 			c->type_path = prev_type_path;
 		});
 
-		TEMPORARY_ALLOCATOR_GUARD();
+		// NOTE: `operands` is used after this block, so it is freed by the guard of the whole procedure
 		if (is_call_expr_field_value(ce)) {
 			named_fields = true;
 			operands = array_make<Operand>(temporary_allocator(), ce->args.count);
@@ -8581,7 +8718,7 @@ gb_internal CallArgumentError check_polymorphic_record_type(CheckerContext *c, O
 		mutex_lock(&found_gen_types->mutex);
 		defer (mutex_unlock(&found_gen_types->mutex));
 
-		Entity *found_entity = find_polymorphic_record_entity(found_gen_types, param_count, ordered_operands);
+		Entity *found_entity = find_polymorphic_record_entity(found_gen_types, param_count, ordered_operands, tuple);
 		if (found_entity) {
 			operand->mode = Addressing_Type;
 			operand->type = found_entity->type;
@@ -10689,6 +10826,64 @@ gb_internal bool is_expr_inferred_fixed_array(Ast *type_expr) {
 	return false;
 }
 
+gb_internal bool is_type_constant_map_key(Type *key) {
+	Type *bt = core_type(key);
+	if (bt == nullptr || bt->kind != Type_Basic) {
+		return false;
+	}
+	if (bt->Basic.kind == Basic_string) {
+		return true;
+	}
+	return is_type_integer(bt) && !is_type_integer_128bit(bt);
+}
+
+gb_internal int constant_map_key_cmp(void const *a, void const *b) {
+	ExactValue x = (*cast(Ast *const *)a)->FieldValue.field->tav.value;
+	ExactValue y = (*cast(Ast *const *)b)->FieldValue.field->tav.value;
+	if (compare_exact_values(Token_Lt, x, y)) {
+		return -1;
+	}
+	if (compare_exact_values(Token_Gt, x, y)) {
+		return +1;
+	}
+	return 0;
+}
+
+gb_internal Ast *check_constant_map_find(ExactValue const &map, ExactValue const &key) {
+	if (map.kind != ExactValue_Compound || map.value_compound == nullptr) {
+		return nullptr;
+	}
+	ast_node(cl, CompoundLit, map.value_compound);
+	for (Ast *elem : cl->elems) {
+		ast_node(fv, FieldValue, elem);
+		if (compare_exact_values(Token_CmpEq, fv->field->tav.value, key)) {
+			return fv->value;
+		}
+	}
+	return nullptr;
+}
+
+gb_internal void check_constant_map_literal_keys(CheckerContext *c, AstCompoundLit *cl) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	// NOTE: sort the keys rather than comparing every pair, constant maps are expected to be large
+	auto elems = array_make<Ast *>(temporary_allocator(), 0, cl->elems.count);
+	for (Ast *elem : cl->elems) {
+		GB_ASSERT(elem->kind == Ast_FieldValue);
+		array_add(&elems, elem);
+	}
+	array_sort(elems, constant_map_key_cmp);
+
+	for (isize i = 1; i < elems.count; i++) {
+		if (constant_map_key_cmp(&elems[i-1], &elems[i]) == 0) {
+			Ast *key = elems[i]->FieldValue.field;
+			gbString str = expr_to_string(key);
+			error(key, "Duplicate key '%s' in constant map literal", str);
+			gb_string_free(str);
+		}
+	}
+}
+
 gb_internal bool check_for_dynamic_literals(CheckerContext *c, Ast *node, AstCompoundLit *cl) {
 	if (cl->elems.count == 0) {
 		return false;
@@ -10743,6 +10938,11 @@ gb_internal ExprKind check_compound_literal(CheckerContext *c, Operand *o, Ast *
 	bool is_constant = true;
 	bool is_soa = false;
 
+	// NOTE: only the outermost literal of a constant declaration may become a constant map
+	bool allow_constant_map = c->allow_constant_map_literal;
+	c->allow_constant_map_literal = false;
+	defer (c->allow_constant_map_literal = allow_constant_map);
+
 	Ast *type_expr = cl->type;
 
 	bool used_type_hint_expr = false;
@@ -11587,7 +11787,10 @@ gb_internal ExprKind check_compound_literal(CheckerContext *c, Operand *o, Ast *
 		if (cl->elems.count == 0) {
 			break;
 		}
-		is_constant = false;
+		is_constant = allow_constant_map &&
+		              is_type_constant_map_key(t->Map.key) &&
+		              !elem_cannot_be_constant(t->Map.value) &&
+		              !build_context.bedrock;
 		{ // Checker values
 			bool key_is_typeid = is_type_typeid(t->Map.key);
 			bool value_is_typeid = is_type_typeid(t->Map.value);
@@ -11595,6 +11798,7 @@ gb_internal ExprKind check_compound_literal(CheckerContext *c, Operand *o, Ast *
 			for (Ast *elem : cl->elems) {
 				if (elem->kind != Ast_FieldValue) {
 					error(elem, "Only 'field = value' elements are allowed in a map literal");
+					is_constant = false;
 					continue;
 				}
 				ast_node(fv, FieldValue, elem);
@@ -11606,8 +11810,12 @@ gb_internal ExprKind check_compound_literal(CheckerContext *c, Operand *o, Ast *
 				}
 				check_assignment(c, o, t->Map.key, str_lit("map literal"));
 				if (o->mode == Addressing_Invalid) {
+					is_constant = false;
 					continue;
 				}
+				if (o->mode != Addressing_Constant) {
+					is_constant = false;
+				}
 
 				if (value_is_typeid) {
 					check_expr_or_type(c, o, fv->value, t->Map.value);
@@ -11615,9 +11823,17 @@ gb_internal ExprKind check_compound_literal(CheckerContext *c, Operand *o, Ast *
 					check_expr_with_type_hint(c, o, fv->value, t->Map.value);
 				}
 				check_assignment(c, o, t->Map.value, str_lit("map literal"));
+				if (is_constant) {
+					is_constant = check_is_operand_compound_lit_constant(c, o, t->Map.value);
+				}
 			}
 		}
 
+		if (is_constant) {
+			check_constant_map_literal_keys(c, cl);
+			break;
+		}
+
 		if (check_for_dynamic_literals(c, node, cl)) {
 			add_map_reserve_dependencies(c);
 			add_map_set_dependencies(c);
@@ -11734,7 +11950,7 @@ gb_internal ExprKind check_compound_literal(CheckerContext *c, Operand *o, Ast *
 				if (tav.value.kind != ExactValue_Integer) {
 					continue;
 				}
-				i64 v = big_int_to_i64(&tav.value.value_integer);
+				i64 v = exact_value_to_i64(tav.value);
 				i64 lower = bt->BitSet.lower;
 				u64 index = cast(u64)(v-lower);
 				BigInt bit = {};
@@ -11742,8 +11958,7 @@ gb_internal ExprKind check_compound_literal(CheckerContext *c, Operand *o, Ast *
 				big_int_shl(&bit, &one, &bit);
 				big_int_or(&bits, &bits, &bit);
 			}
-			o->value.kind = ExactValue_Integer;
-			o->value.value_integer = bits;
+			o->value = exact_value_big_int(bits);
 		} else if (is_type_constant_type(type) && cl->elems.count == 0) {
 			ExactValue value = exact_value_compound(node);
 			Type *bt = core_type(type);
@@ -12096,6 +12311,16 @@ gb_internal ExprKind check_index_expr(CheckerContext *c, Operand *o, Ast *node,
 		// 	o->expr = node;
 		// 	return kind;
 		// }
+		if (is_const) {
+			// NOTE: constant maps are read-only, a lookup yields a copy of the value and an optional 'ok'
+			o->mode = Addressing_OptionalOk;
+			o->type = t->Map.value;
+			o->expr = node;
+
+			add_constant_map_get_dependencies(c, t->Map.key);
+			return Expr_Expr;
+		}
+
 		o->mode = Addressing_MapIndex;
 		o->type = t->Map.value;
 		o->expr = node;
@@ -12978,7 +13203,7 @@ gb_internal bool is_exact_value_zero(ExactValue const &v) {
 	case ExactValue_String16:
 		return v.value_string16.len == 0;
 	case ExactValue_Integer:
-		return big_int_is_zero(&v.value_integer);
+		return exact_value_integer_is_zero(v);
 	case ExactValue_Float:
 		return v.value_float == 0.0;
 	case ExactValue_Complex:
@@ -1808,6 +1808,7 @@ gb_internal void check_range_stmt(CheckerContext *ctx, Ast *node, u32 mod_flags)
 		Operand operand = {Addressing_Invalid};
 		check_expr_base(ctx, &operand, expr, nullptr);
 		error_operand_no_value(&operand);
+		error_operand_constant_map(&operand);
 
 		if (operand.mode == Addressing_Type) {
 			if (!is_type_enum(operand.type)) {
@@ -1832,7 +1833,7 @@ gb_internal void check_range_stmt(CheckerContext *ctx, Ast *node, u32 mod_flags)
 		} else if (operand.mode != Addressing_Invalid) {
 			if (operand.mode == Addressing_OptionalOk || operand.mode == Addressing_OptionalOkPtr) {
 				Ast *expr = unparen_expr(operand.expr);
-				if (expr->kind != Ast_TypeAssertion) { // Only for procedure calls
+				if (expr->kind != Ast_TypeAssertion && expr->kind != Ast_IndexExpr) { // Only for procedure calls
 					Type *end_type = nullptr;
 					check_promote_optional_ok(ctx, &operand, nullptr, &end_type, false);
 					if (is_type_boolean(end_type)) {
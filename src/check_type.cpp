@@ -271,7 +271,7 @@ gb_internal bool check_custom_align(CheckerContext *ctx, Ast *node, i64 *align_,
 	Type *type = base_type(o.type);
 	if (is_type_untyped(type) || is_type_integer(type)) {
 		if (o.value.kind == ExactValue_Integer) {
-			BigInt v = o.value.value_integer;
+			BigInt v = exact_value_to_big_int(o.value);
 			if (v.used > 1) {
 				gbAllocator a = heap_allocator();
 				String str = big_int_to_string(a, &v);
@@ -302,6 +302,7 @@ gb_internal GenTypesData *ensure_polymorphic_record_entity_has_gen_types(Checker
 	if (original_type->Named.gen_types_data == nullptr) {
 		GenTypesData *gen_types = permanent_alloc_item<GenTypesData>();
 		gen_types->types = array_make<Entity *>(heap_allocator());
+		gen_types->unkeyed_types = array_make<Entity *>(heap_allocator());
 		original_type->Named.gen_types_data = gen_types;
 	}
 	found_gen_types = original_type->Named.gen_types_data;
@@ -359,6 +360,19 @@ gb_internal void add_polymorphic_record_entity(CheckerContext *ctx, Ast *node, T
 		}
 	}
 	array_add(&found_gen_types->types, e);
+
+	u64 key = 0;
+	if (TypeTuple *tuple = get_record_polymorphic_params(named_type)) {
+		key = 0xcbf29ce484222325ull;
+		for (Entity *p : tuple->variables) {
+			key = polymorphic_instance_key_append(key, p->type, p->kind == Entity_Constant ? &p->Constant.value : nullptr);
+		}
+	}
+	if (key != 0) {
+		multi_map_insert(&found_gen_types->types_by_key, key, e);
+	} else {
+		array_add(&found_gen_types->unkeyed_types, e);
+	}
 }
 
 
@@ -600,60 +614,86 @@ gb_internal bool check_record_poly_operand_specialization(CheckerContext *ctx, T
 	return true;
 }
 
-gb_internal Entity *find_polymorphic_record_entity(GenTypesData *found_gen_types, isize param_count, Array<Operand> const &ordered_operands) {
-	for (Entity *e : found_gen_types->types) {
-		Type *t = base_type(e->type);
-		TypeTuple *tuple = get_record_polymorphic_params(t);
-		GB_ASSERT_MSG(tuple != nullptr, "%s :: %s", type_to_string(e->type), type_to_string(t));
-		GB_ASSERT(param_count == tuple->variables.count);
+gb_internal bool polymorphic_record_entity_matches(Entity *e, isize param_count, Array<Operand> const &ordered_operands) {
+	Type *t = base_type(e->type);
+	TypeTuple *tuple = get_record_polymorphic_params(t);
+	GB_ASSERT_MSG(tuple != nullptr, "%s :: %s", type_to_string(e->type), type_to_string(t));
+	GB_ASSERT(param_count == tuple->variables.count);
 
-		bool skip = false;
+	for (isize j = 0; j < param_count; j++) {
+		Entity *p = tuple->variables[j];
+		Operand o = {};
+		if (j < ordered_operands.count) {
+			o = ordered_operands[j];
+		}
+		if (o.expr == nullptr) {
+			continue;
+		}
+		Entity *oe = entity_of_node(o.expr);
+		if (p == oe) {
+			// NOTE(bill): This is the same type, make sure that it will be be same thing and use that
+			// Saves on a lot of checking too below
+			continue;
+		}
 
-		for (isize j = 0; j < param_count; j++) {
-			Entity *p = tuple->variables[j];
-			Operand o = {};
-			if (j < ordered_operands.count) {
-				o = ordered_operands[j];
+		if (p->kind == Entity_TypeName) {
+			if (is_type_polymorphic(o.type)) {
+				// NOTE(bill): Do not add polymorphic version to the gen_types
+				return false;
 			}
-			if (o.expr == nullptr) {
-				continue;
+			if (!are_types_identical(o.type, p->type)) {
+				return false;
 			}
-			Entity *oe = entity_of_node(o.expr);
-			if (p == oe) {
-				// NOTE(bill): This is the same type, make sure that it will be be same thing and use that
-				// Saves on a lot of checking too below
-				continue;
+		} else if (p->kind == Entity_Constant) {
+			if (!compare_exact_values(Token_CmpEq, o.value, p->Constant.value)) {
+				return false;
 			}
+			if (!are_types_identical(o.type, p->type)) {
+				return false;
+			}
+		} else {
+			GB_PANIC("Unknown entity kind");
+		}
+	}
+	return true;
+}
 
-			if (p->kind == Entity_TypeName) {
-				if (is_type_polymorphic(o.type)) {
-					// NOTE(bill): Do not add polymorphic version to the gen_types
-					skip = true;
-					break;
-				}
-				if (!are_types_identical(o.type, p->type)) {
-					skip = true;
-					break;
-				}
-			} else if (p->kind == Entity_Constant) {
-				if (!compare_exact_values(Token_CmpEq, o.value, p->Constant.value)) {
-					skip = true;
-					break;
-				}
-				if (!are_types_identical(o.type, p->type)) {
-					skip = true;
-					break;
-				}
-			} else {
-				GB_PANIC("Unknown entity kind");
+gb_internal Entity *find_polymorphic_record_entity(GenTypesData *found_gen_types, isize param_count, Array<Operand> const &ordered_operands, TypeTuple *params) {
+	u64 key = 0xcbf29ce484222325ull;
+	for (isize j = 0; j < param_count && key != 0; j++) {
+		if (j >= ordered_operands.count || ordered_operands[j].expr == nullptr) {
+			// NOTE: a missing operand matches any instantiation
+			key = 0;
+		} else {
+			Operand const &o = ordered_operands[j];
+			bool is_constant = params->variables[j]->kind == Entity_Constant;
+			key = polymorphic_instance_key_append(key, o.type, is_constant ? &o.value : nullptr);
+		}
+	}
+
+	if (key == 0) {
+		for (Entity *e : found_gen_types->types) {
+			if (polymorphic_record_entity_matches(e, param_count, ordered_operands)) {
+				return e;
 			}
 		}
-		if (!skip) {
+		return nullptr;
+	}
+
+	for (auto *entry = multi_map_find_first(&found_gen_types->types_by_key, key);
+	     entry != nullptr;
+	     entry = multi_map_find_next(&found_gen_types->types_by_key, entry)) {
+		if (polymorphic_record_entity_matches(entry->value, param_count, ordered_operands)) {
+			return entry->value;
+		}
+	}
+	for (Entity *e : found_gen_types->unkeyed_types) {
+		if (polymorphic_record_entity_matches(e, param_count, ordered_operands)) {
 			return e;
 		}
 	}
 	return nullptr;
-};
+}
 
 
 gb_internal void check_struct_type(CheckerContext *ctx, Type *struct_type, Ast *node, Array<Operand> *poly_operands, Type *named_type, Type *original_type_for_poly) {
@@ -1334,8 +1374,8 @@ gb_internal void check_bit_set_type(CheckerContext *c, Type *type, Type *named_t
 		GB_ASSERT(iv.kind == ExactValue_Integer);
 		GB_ASSERT(jv.kind == ExactValue_Integer);
 
-		BigInt i = iv.value_integer;
-		BigInt j = jv.value_integer;
+		BigInt i = exact_value_to_big_int(iv);
+		BigInt j = exact_value_to_big_int(jv);
 		if (big_int_cmp(&i, &j) > 0) {
 			gbAllocator a = heap_allocator();
 			String si = big_int_to_string(a, &i);
@@ -1452,7 +1492,7 @@ gb_internal void check_bit_set_type(CheckerContext *c, Type *type, Type *named_t
 					ExactValue value = exact_value_to_integer(e->Constant.value);
 					GB_ASSERT(value.kind == ExactValue_Integer);
 					// NOTE(bill): enum types should be able to store i64 values
-					i64 x = big_int_to_i64(&value.value_integer);
+					i64 x = exact_value_to_i64(value);
 					lower = gb_min(lower, x);
 					upper = gb_max(upper, x);
 				}
@@ -1775,6 +1815,7 @@ gb_internal ParameterValue handle_parameter_value(CheckerContext *ctx, Type *in_
 		} else {
 			check_expr(ctx, &o, expr);
 		}
+		error_operand_constant_map(&o);
 
 		if (in_type) {
 			check_assignment(ctx, &o, in_type, str_lit("parameter value"));
@@ -2186,8 +2227,7 @@ gb_internal Type *check_get_params(CheckerContext *ctx, Scope *scope, Ast *_para
 							if (op.mode == Addressing_Constant) {
 								poly_const = op.value;
 								if (poly_const.kind == ExactValue_Integer && is_type_float(type)) {
-									poly_const.kind = ExactValue_Float;
-									poly_const.value_float = big_int_to_f64(&poly_const.value_integer);
+									poly_const = exact_value_float(exact_value_integer_to_f64(poly_const));
 								}
 							} else {
 								if (!ctx->in_proc_group) {
@@ -2854,8 +2894,11 @@ gb_internal i64 check_array_count(CheckerContext *ctx, Operand *o, Ast *e) {
 			// NOTE: an integral float is a valid count, but it must be range checked as an integer
 			value = exact_value_to_integer(value);
 		}
+		if (value.kind == ExactValue_Integer && value.is_small_integer && value.value_small_integer >= 0) {
+			return value.value_small_integer;
+		}
 		if (value.kind == ExactValue_Integer) {
-			BigInt count = value.value_integer;
+			BigInt count = exact_value_to_big_int(value);
 			if (big_int_is_neg(&count)) {
 				gbAllocator a = heap_allocator();
 				String str = big_int_to_string(a, &count);
@@ -3501,7 +3544,7 @@ gb_internal void check_array_type_internal(CheckerContext *ctx, Ast *e, Type **t
 			    bt->Enum.min_value != nullptr && bt->Enum.max_value != nullptr) {
 				ExactValue span = exact_value_sub(*bt->Enum.max_value, *bt->Enum.min_value);
 				ExactValue len  = exact_value_add(span, exact_value_i64(1));
-				if (len.kind == ExactValue_Integer && len.value_integer.used > 1) {
+				if (len.kind == ExactValue_Integer && !len.is_small_integer && len.value_integer.used > 1) {
 					gbAllocator a = heap_allocator();
 					String str = big_int_to_string(a, &len.value_integer);
 					error(e, "Enumerated array length too large, %.*s", LIT(str));
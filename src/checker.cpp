@@ -397,9 +397,10 @@ gb_internal void scope_lookup_parent(Scope *scope, InternedString name, Scope **
 		}
 		for (Scope *s = scope; s != nullptr; s = s->parent) {
 			Entity *found = nullptr;
-			if (!is_single_threaded) rw_mutex_shared_lock(&s->mutex);
+			bool use_mutex = !is_single_threaded && (s->flags.load(std::memory_order_relaxed) & ScopeFlag_Sealed) == 0;
+			if (use_mutex) rw_mutex_shared_lock(&s->mutex);
 			found = scope_map_get(&s->elements, name, hash);
-			if (!is_single_threaded) rw_mutex_shared_unlock(&s->mutex);
+			if (use_mutex) rw_mutex_shared_unlock(&s->mutex);
 			if (found) {
 				Entity *e = found;
 				if (gone_thru_proc) {
@@ -447,6 +448,7 @@ gb_internal Entity *scope_insert_with_name_no_mutex(Scope *s, InternedString nam
 	Entity *found = nullptr;
 	Entity *result = nullptr;
 
+	GB_ASSERT((s->flags.load(std::memory_order_relaxed) & ScopeFlag_Sealed) == 0);
 	found = scope_map_get(&s->elements, name, hash);
 
 	if (found) {
@@ -483,6 +485,7 @@ gb_internal Entity *scope_insert_with_name(Scope *s, InternedString name, u32 ha
 	Entity *found = nullptr;
 	Entity *result = nullptr;
 
+	GB_ASSERT((s->flags.load(std::memory_order_relaxed) & ScopeFlag_Sealed) == 0);
 	rw_mutex_lock(&s->mutex);
 
 	found = scope_map_get(&s->elements, name, hash);
@@ -2565,7 +2568,9 @@ gb_internal void check_procedure_later(Checker *c, ProcInfo *info) {
 	if (global_procedure_body_in_worker_queue.load()) {
 		thread_pool_add_task(check_proc_info_worker_proc, info);
 	} else {
+		mutex_lock(&c->procs_to_check_mutex);
 		array_add(&c->procs_to_check, info);
+		mutex_unlock(&c->procs_to_check_mutex);
 	}
 
 	if (DEBUG_CHECK_ALL_PROCEDURES) {
@@ -4230,6 +4235,14 @@ gb_internal DECL_ATTRIBUTE_PROC(proc_decl_attribute) {
 			error(elem, "Expected a string value for '%.*s'", LIT(name));
 		}
 		return true;
+	} else if (name == "target_clones") {
+		ExactValue ev = check_decl_attribute_value(c, value);
+		if (ev.kind == ExactValue_String) {
+			ac->target_clones = ev.value_string;
+		} else {
+			error(elem, "Expected a string value for '%.*s'", LIT(name));
+		}
+		return true;
 	} else if (name == "entry_point_only") {
 		if (value != nullptr) {
 			error(value, "'%.*s' expects no parameter", LIT(name));
@@ -5338,30 +5351,354 @@ gb_internal void check_single_global_entity(Checker *c, Entity *e, DeclInfo *d)
 	check_entity_decl(ctx, e, d, nullptr);
 }
 
-gb_internal void check_all_global_entities(Checker *c) {
+gb_internal void check_global_entity_and_layout(Checker *c, Entity *e) {
+	DeclInfo *d = e->decl_info;
+	check_single_global_entity(c, e, d);
+	if (e->type != nullptr && is_type_typed(e->type)) {
+		mutex_lock(&c->soa_types_to_complete_mutex);
+		for (Type *t = nullptr; mpsc_dequeue(&c->soa_types_to_complete, &t); /**/) {
+			complete_soa_type(c, t, false);
+		}
+		mutex_unlock(&c->soa_types_to_complete_mutex);
+
+		(void)type_size_of(e->type);
+		(void)type_align_of(e->type);
+	}
+}
+
+// Global entities are checked on demand: checking a declaration resolves whatever it refers to, and
+// reaching a declaration which is still in progress is reported as a cycle. This means two threads
+// must never resolve the same entity at the same time.
+//
+// The real dependencies are only known once an entity has been checked, so this graph approximates
+// them from the tokens of each declaration: every `name` and `pkg.name` which resolves to another
+// unchecked global entity joins the two into the same group. This over-approximates what the checker
+// will resolve, so the groups are independent of each other and each can be checked serially, in the
+// original order, on its own thread.
+struct GlobalEntityGraph {
+	PtrMap<Entity *, i32>  index;
+	PtrMap<AstFile *, i32> first_of_file;
+	Array<Entity *>        entities;
+	Array<i32>             parent;
+};
+
+// The references of a range of `GlobalEntityGraph::entities`, collected on a worker thread
+struct GlobalEntityGraphChunk {
+	GlobalEntityGraph *g;
+	isize              lo, hi;
+	Array<i32>         edges; // pairs of (from, to), `to` is -1 when the references are unknown
+};
+
+struct GlobalEntityGroup {
+	Checker *       c;
+	Array<Entity *> entities;
+	u64             report_group; // see `error_report_group`
+};
+
+gb_internal i32 global_entity_graph_find(GlobalEntityGraph *g, i32 i) {
+	while (g->parent[i] != i) {
+		g->parent[i] = g->parent[g->parent[i]];
+		i = g->parent[i];
+	}
+	return i;
+}
+
+gb_internal void global_entity_graph_union(GlobalEntityGraph *g, i32 a, i32 b) {
+	a = global_entity_graph_find(g, a);
+	b = global_entity_graph_find(g, b);
+	if (a == b) {
+		return;
+	}
+	// NOTE: the earliest entity is always the root so the grouping does not depend on the union order
+	if (a > b) {
+		gb_swap(i32, a, b);
+	}
+	g->parent[b] = a;
+}
+
+gb_internal void global_entity_graph_add_edge(GlobalEntityGraphChunk *chunk, i32 from, i32 to) {
+	array_add(&chunk->edges, from);
+	array_add(&chunk->edges, to);
+}
+
+gb_internal void global_entity_graph_add_reference(GlobalEntityGraphChunk *chunk, i32 from, Entity *e) {
+	if (e == nullptr) {
+		return;
+	}
+	i32 *found = map_get(&chunk->g->index, e);
+	if (found != nullptr && *found != from) {
+		global_entity_graph_add_edge(chunk, from, *found);
+	}
+}
+
+gb_internal void global_entity_graph_add_file(GlobalEntityGraphChunk *chunk, i32 from, AstFile *f) {
+	i32 *found = map_get(&chunk->g->first_of_file, f);
+	if (found != nullptr && *found != from) {
+		global_entity_graph_add_edge(chunk, from, *found);
+	}
+}
+
+gb_internal Entity *global_entity_graph_lookup(Scope *scope, AstFile *f, PackedToken const &tok, bool current_scope_only) {
+	String name = make_string(f->tokenizer.start + tok.offset, tok.len);
+	u32 hash = 0;
+	InternedString interned = string_interner_insert(name, 0, &hash);
+	if (current_scope_only) {
+		return scope_lookup_current(scope, interned, hash);
+	}
+	return scope_lookup(scope, interned, hash);
+}
+
+// Scans the tokens starting at `start` until `stop`. If `until_terminator` is set, the scan carries on
+// past `stop` until the next semicolon outside of any brackets, which guards against an end token which
+// does not cover the whole declaration.
+gb_internal void global_entity_graph_scan(GlobalEntityGraphChunk *chunk, i32 from, Scope *scope, AstFile *f, i32 start, i32 stop, bool until_terminator) {
+	isize lo = 0;
+	isize hi = f->tokens.count;
+	while (lo < hi) {
+		isize mid = lo + (hi-lo)/2;
+		if (cast(i32)f->tokens[mid].offset < start) {
+			lo = mid+1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	isize depth = 0;
+	for (isize i = lo; i < f->tokens.count; i++) {
+		PackedToken const &tok = f->tokens[i];
+		if (cast(i32)tok.offset >= stop) {
+			if (!until_terminator) {
+				break;
+			}
+			if (depth <= 0 && tok.kind == Token_Semicolon) {
+				break;
+			}
+		}
+
+		switch (tok.kind) {
+		case Token_EOF:
+			return;
+		case Token_OpenParen:
+		case Token_OpenBracket:
+		case Token_OpenBrace:
+			depth += 1;
+			break;
+		case Token_CloseParen:
+		case Token_CloseBracket:
+		case Token_CloseBrace:
+			depth -= 1;
+			break;
+		case Token_Ident: {
+			if (i > 0 && f->tokens[i-1].kind == Token_Period) {
+				// NOTE: a field or an implicit selector, the operand (if any) has already been handled
+				break;
+			}
+			Entity *e = global_entity_graph_lookup(scope, f, tok, false);
+			if (e != nullptr && e->kind == Entity_ImportName && i+2 < f->tokens.count &&
+			    f->tokens[i+1].kind == Token_Period && f->tokens[i+2].kind == Token_Ident) {
+				Scope *pkg_scope = e->ImportName.scope;
+				e = pkg_scope ? global_entity_graph_lookup(pkg_scope, f, f->tokens[i+2], true) : nullptr;
+			}
+			global_entity_graph_add_reference(chunk, from, e);
+			break;
+		}
+		}
+	}
+}
+
+gb_internal void global_entity_graph_add_decl(GlobalEntityGraphChunk *chunk, i32 from, Entity *e) {
+	DeclInfo *d = e->decl_info;
+	Ast *decl = d ? d->decl_node : nullptr;
+	if (decl == nullptr || decl->kind != Ast_ValueDecl || d->scope == nullptr ||
+	    (d->scope->flags & ScopeFlag_File) == 0 || d->scope->file == nullptr) {
+		global_entity_graph_add_edge(chunk, from, -1);
+		return;
+	}
+	AstFile *f = d->scope->file;
+
+	// NOTE: checking a declaration temporarily changes the flags of its file scope (see
+	// `check_entity_decl`), so all of the declarations of a file must be checked by the same thread
+	global_entity_graph_add_file(chunk, from, f);
+
+	for (Ast *attr : d->attributes) {
+		global_entity_graph_scan(chunk, from, d->scope, f, ast_token(attr).pos.offset, ast_end_token(attr).pos.offset+1, true);
+	}
+
+	Ast *foreign_library = nullptr;
+	if (e->kind == Entity_Procedure) {
+		foreign_library = e->Procedure.foreign_library_ident;
+	} else if (e->kind == Entity_Variable) {
+		foreign_library = e->Variable.foreign_library_ident;
+	}
+	if (foreign_library != nullptr && foreign_library->kind == Ast_Ident) {
+		global_entity_graph_add_reference(chunk, from, scope_lookup(d->scope, foreign_library->Ident.interned, foreign_library->Ident.hash));
+	}
+
+	i32 start = ast_token(decl).pos.offset;
+	Ast *pl = d->proc_lit;
+	if (e->kind == Entity_Procedure && pl != nullptr && pl->kind == Ast_ProcLit && pl->ProcLit.body != nullptr) {
+		// NOTE: only the signature is checked at this stage, the body is checked later
+		global_entity_graph_scan(chunk, from, d->scope, f, start, ast_token(pl->ProcLit.body).pos.offset, false);
+	} else {
+		global_entity_graph_scan(chunk, from, d->scope, f, start, ast_end_token(decl).pos.offset+1, true);
+	}
+}
+
+gb_internal WORKER_TASK_PROC(global_entity_graph_chunk_worker_proc) {
+	GlobalEntityGraphChunk *chunk = cast(GlobalEntityGraphChunk *)data;
+	for (isize i = chunk->lo; i < chunk->hi; i++) {
+		global_entity_graph_add_decl(chunk, cast(i32)i, chunk->g->entities[i]);
+	}
+	return 0;
+}
+
+gb_internal GB_COMPARE_PROC(global_entity_group_cmp) {
+	GlobalEntityGroup *x = cast(GlobalEntityGroup *)a;
+	GlobalEntityGroup *y = cast(GlobalEntityGroup *)b;
+	return isize_cmp(y->entities.count, x->entities.count);
+}
+
+gb_internal WORKER_TASK_PROC(check_global_entity_group_worker_proc) {
+	GlobalEntityGroup *group = cast(GlobalEntityGroup *)data;
+	TRACE_SCOPE("check global entities", group->entities[0]->token.string);
+	error_report_group = group->report_group;
+	for (Entity *e : group->entities) {
+		check_global_entity_and_layout(group->c, e);
+	}
+	error_report_group = 0;
+	return 0;
+}
+
+gb_internal void check_all_global_entities_serial(Checker *c) {
 	in_single_threaded_checker_stage.store(true, std::memory_order_relaxed);
 
-	// NOTE(bill): This must be single threaded
-	// Don't bother trying
 	for_array(i, c->info.entities) {
 		Entity *e = c->info.entities[i];
 		GB_ASSERT(e != nullptr);
 		if (e->flags & EntityFlag_Lazy) {
 			continue;
 		}
+		check_global_entity_and_layout(c, e);
+	}
+
+	in_single_threaded_checker_stage.store(false, std::memory_order_relaxed);
+}
+
+gb_internal void check_all_global_entities(Checker *c) {
+	AstPackage *runtime_package = c->info.runtime_package;
+	if (build_context.no_threaded_checker || build_context.thread_count <= 1 || runtime_package == nullptr) {
+		check_all_global_entities_serial(c);
+		return;
+	}
+
+	// NOTE: The checker implicitly depends upon the core types from the runtime (e.g. `Context`,
+	// `Source_Code_Location`, the map internals), which are resolved on first use. The runtime, and
+	// everything it imports, is checked first and then the core types are initialized, so that the
+	// remaining packages only ever read them.
+	in_single_threaded_checker_stage.store(true, std::memory_order_relaxed);
+	for (Entity *e : c->info.entities) {
+		if (e->flags & EntityFlag_Lazy) {
+			continue;
+		}
+		if (e->pkg != nullptr && e->pkg->order <= runtime_package->order) {
+			check_global_entity_and_layout(c, e);
+		}
+	}
+	init_preload(c);
+	init_core_load_directory_file(c);
+	in_single_threaded_checker_stage.store(false, std::memory_order_relaxed);
+
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	GlobalEntityGraph g = {};
+	map_init(&g.index, c->info.entities.count);
+	map_init(&g.first_of_file);
+	defer (map_destroy(&g.index));
+	defer (map_destroy(&g.first_of_file));
+	array_init(&g.entities, temporary_allocator(), 0, c->info.entities.count);
+	array_init(&g.parent,   temporary_allocator(), 0, c->info.entities.count);
+	for (Entity *e : c->info.entities) {
+		if (e->state.load() != EntityState_Unresolved) {
+			continue;
+		}
+		i32 index = cast(i32)g.entities.count;
+		array_add(&g.entities, e);
+		array_add(&g.parent, index);
+		map_set(&g.index, e, index);
+
 		DeclInfo *d = e->decl_info;
-		check_single_global_entity(c, e, d);
-		if (e->type != nullptr && is_type_typed(e->type)) {
-			for (Type *t = nullptr; mpsc_dequeue(&c->soa_types_to_complete, &t); /**/) {
-				complete_soa_type(c, t, false);
-			}
+		if (d != nullptr && d->scope != nullptr && d->scope->file != nullptr && map_get(&g.first_of_file, d->scope->file) == nullptr) {
+			map_set(&g.first_of_file, d->scope->file, index);
+		}
+	}
+
+	isize const CHUNK_SIZE = 512;
+	isize chunk_count = (g.entities.count + CHUNK_SIZE-1) / CHUNK_SIZE;
+	Array<GlobalEntityGraphChunk> chunks = {};
+	array_init(&chunks, temporary_allocator(), chunk_count);
+	for_array(i, chunks) {
+		GlobalEntityGraphChunk *chunk = &chunks[i];
+		chunk->g  = &g;
+		chunk->lo = i*CHUNK_SIZE;
+		chunk->hi = gb_min(chunk->lo + CHUNK_SIZE, g.entities.count);
+		array_init(&chunk->edges, heap_allocator());
+		thread_pool_add_task(global_entity_graph_chunk_worker_proc, chunk);
+	}
+	thread_pool_wait();
+
+	i32 unknown = -1;
+	for (GlobalEntityGraphChunk &chunk : chunks) {
+		for (isize i = 0; i+1 < chunk.edges.count; i += 2) {
+			i32 from = chunk.edges[i];
+			i32 to   = chunk.edges[i+1];
+			if (to < 0) {
+				// NOTE: anything without a usable declaration is checked together in one group
+				if (unknown < 0) {
+					unknown = from;
+				}
+				to = unknown;
+			}
+			global_entity_graph_union(&g, from, to);
+		}
+		array_free(&chunk.edges);
+	}
+
+	Array<GlobalEntityGroup> groups = {};
+	array_init(&groups, temporary_allocator(), 0, 0);
+	Array<i32> group_index = {};
+	array_init(&group_index, temporary_allocator(), g.entities.count);
+	for_array(i, g.entities) {
+		Entity *e = g.entities[i];
+		i32 root = global_entity_graph_find(&g, cast(i32)i);
+		if (root == i) {
+			group_index[i] = cast(i32)groups.count;
+			GlobalEntityGroup group = {c};
+			array_init(&group.entities, temporary_allocator(), 0, 0);
+			// NOTE: the root is the earliest entity of the group, so this is the order of the serial checker
+			group.report_group = cast(u64)i + 1;
+			array_add(&groups, group);
+		} else {
+			group_index[i] = group_index[root];
+		}
+		// NOTE: lazy entities take part in the grouping, but they are only ever checked on demand
+		if ((e->flags & EntityFlag_Lazy) == 0) {
+			array_add(&groups[group_index[i]].entities, e);
+		}
+	}
+
+	// NOTE: the largest groups are queued first as they bound how long this stage takes
+	array_sort(groups, global_entity_group_cmp);
 
-			(void)type_size_of(e->type);
-			(void)type_align_of(e->type);
+	debugf("Global entity groups: %td for %td entities, the largest has %td\n", groups.count, g.entities.count, groups.count > 0 ? groups[0].entities.count : 0);
+	for (GlobalEntityGroup &group : groups) {
+		if (group.entities.count > 0) {
+			thread_pool_add_task(check_global_entity_group_worker_proc, &group);
 		}
 	}
+	thread_pool_wait();
 
-	in_single_threaded_checker_stage.store(false, std::memory_order_relaxed);
+	// NOTE: anything reported from now on would have come after every global entity in the serial checker
+	global_error_collector.default_report_group.store(cast(u64)g.entities.count + 1, std::memory_order_relaxed);
 }
 
 
@@ -6113,6 +6450,7 @@ gb_internal WORKER_TASK_PROC(check_collect_entities_all_worker_proc) {
 	UntypedExprInfoMap *untyped = &wd->untyped;
 
 	AstFile *f = cast(AstFile *)data;
+	TRACE_SCOPE("collect entities", f->fullpath);
 	reset_checker_context(ctx, f, untyped);
 
 	check_collect_entities(ctx, f->decls);
@@ -6157,6 +6495,7 @@ gb_internal void check_export_entities_in_pkg(CheckerContext *ctx, AstPackage *p
 
 gb_internal WORKER_TASK_PROC(check_export_entities_worker_proc) {
 	AstPackage *pkg = (AstPackage *)data;
+	TRACE_SCOPE("export entities", pkg->name);
 	auto *wd = &collect_entity_worker_data[current_thread_index()];
 	check_export_entities_in_pkg(&wd->ctx, pkg, &wd->untyped);
 	return 0;
@@ -6181,6 +6520,24 @@ gb_internal void check_export_entities(Checker *c) {
 	thread_pool_wait();
 }
 
+// NOTE: After the entities have been exported, nothing more is added to a package or file scope (only
+// `override_entity_in_scope` may replace an entry that is already there), and as these scopes are
+// at the root of every lookup, `scope_lookup_parent` can skip their mutex from then on
+gb_internal void check_seal_package_and_file_scopes(Checker *c) {
+	for (auto const &entry : c->info.packages) {
+		AstPackage *pkg = entry.value;
+		if (pkg->scope == nullptr) {
+			continue;
+		}
+		pkg->scope->flags.fetch_or(ScopeFlag_Sealed, std::memory_order_relaxed);
+		for (AstFile *f : pkg->files) {
+			if (f->scope != nullptr) {
+				f->scope->flags.fetch_or(ScopeFlag_Sealed, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
 gb_internal void check_import_entities(Checker *c) {
 	TEMPORARY_ALLOCATOR_GUARD();
 
@@ -6813,6 +7170,7 @@ gb_internal WORKER_TASK_PROC(check_proc_info_worker_proc) {
 			}
 		}
 	}
+	TRACE_SCOPE("check procedure", pi->token.string);
 	map_clear(untyped);
 	if (check_proc_info(c, pi, untyped)) {
 		total_bodies_checked.fetch_add(1, std::memory_order_relaxed);
@@ -7615,6 +7973,7 @@ gb_internal void check_update_dependency_tree_for_procedures(Checker *c) {
 gb_internal WORKER_TASK_PROC(check_scope_usage_file_worker) {
 	Checker *c = global_checker_ptr.load(std::memory_order_relaxed);
 	AstFile *f = cast(AstFile *)data;
+	TRACE_SCOPE("check scope usage", f->fullpath);
 	u64 vet_flags = ast_file_vet_flags(f);
 	check_scope_usage(c, f->scope, vet_flags);
 	return 0;
@@ -7623,6 +7982,7 @@ gb_internal WORKER_TASK_PROC(check_scope_usage_file_worker) {
 gb_internal WORKER_TASK_PROC(check_scope_usage_pkg_worker) {
 	Checker *c = global_checker_ptr.load(std::memory_order_relaxed);
 	AstPackage *pkg = cast(AstPackage *)data;
+	TRACE_SCOPE("check scope usage", pkg->name);
 	check_scope_usage_internal(c, pkg->scope, 0, true);
 	return 0;
 }
@@ -7721,6 +8081,9 @@ gb_internal void check_parsed_files(Checker *c) {
 	TIME_SECTION("export entities - post");
 	check_export_entities(c);
 
+	TIME_SECTION("seal package and file scopes");
+	check_seal_package_and_file_scopes(c);
+
 	TIME_SECTION("add entities from packages");
 	check_merge_queues_into_arrays(c);
 
@@ -7825,7 +8188,7 @@ gb_internal void check_parsed_files(Checker *c) {
 			if (s->pkg->files.count > 0) {
 				AstFile *f = s->pkg->files[0];
 				if (f->tokens.count > 0) {
-					token = f->tokens[0];
+					token = ast_file_unpack_token(f, 0);
 				}
 			}
 
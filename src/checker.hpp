@@ -162,6 +162,7 @@ struct AttributeContext {
 
 	String require_target_feature; // required by the target micro-architecture
 	String enable_target_feature;  // will be enabled for the procedure only
+	String target_clones;          // one body per feature set, the best is picked at runtime
 
 	u64 fast_math_flags;
 
@@ -460,6 +461,25 @@ gb_internal Entity *scope_map_get(ScopeMap *m, InternedString key, u32 hash) {
 	}
 }
 
+// Replaces the value of an existing entry in place and returns the previous value. Unlike
+// `scope_map_insert`, this never grows the map or moves any entry, so it is safe while other threads
+// call `scope_map_get` without the mutex (see `ScopeFlag_Sealed`)
+gb_internal Entity *scope_map_replace(ScopeMap *m, InternedString key, u32 hash, Entity *value) {
+	GB_ASSERT_MSG(m->slots != nullptr && scope_map_get(m, key, hash) != nullptr, "scope_map_replace of a missing key");
+
+	u32 mask = m->cap-1;
+	u32 pos = hash & mask;
+	for (;;) {
+		ScopeMapSlot *s = &m->slots[pos];
+		if (s->hash == hash && m->keys[pos] == key) {
+			Entity *old = s->value;
+			s->value = value;
+			return old;
+		}
+		pos = (pos + 1) & mask;
+	}
+}
+
 gb_internal void scope_map_clear(ScopeMap *m) {
 	gb_memset(m->slots, 0, gb_size_of(*m->slots) * m->cap);
 	m->count = 0;
@@ -537,6 +557,7 @@ enum ScopeFlag : i32 {
 	ScopeFlag_Type    = 1<<7,
 
 	ScopeFlag_HasBeenImported = 1<<10, // This is only applicable to file scopes
+	ScopeFlag_Sealed          = 1<<11, // No more entities can be added, so lookups need no lock (package and file scopes)
 
 	ScopeFlag_ContextDefined = 1<<16,
 };
@@ -556,7 +577,7 @@ struct Scope {
 
 	DeclInfo *decl_info;
 
-	i32             flags; // ScopeFlag
+	std::atomic<i32> flags; // ScopeFlag
 	union {
 		AstPackage *pkg;
 		AstFile *   file;
@@ -672,14 +693,21 @@ struct LoadDirectoryCache {
 };
 
 
+// NOTE: `procs_by_key`/`types_by_key` are multi-maps from `polymorphic_instance_key_append` of the
+// instantiation's parameters, which hash equally for every instantiation that `are_types_identical`.
+// Instantiations whose parameters are still polymorphic have no key and are kept in the `unkeyed_*` arrays.
 struct GenProcsData {
-	Array<Entity *> procs;
-	RwMutex         mutex;
+	Array<Entity *>       procs;
+	PtrMap<u64, Entity *> procs_by_key;
+	Array<Entity *>       unkeyed_procs;
+	RwMutex               mutex;
 };
 
 struct GenTypesData {
-	Array<Entity *> types;
-	RecursiveMutex  mutex;
+	Array<Entity *>       types;
+	PtrMap<u64, Entity *> types_by_key;
+	Array<Entity *>       unkeyed_types;
+	RecursiveMutex        mutex;
 };
 
 struct Defineable {
@@ -835,6 +863,7 @@ struct CheckerContext {
 	bool       in_polymorphic_specialization;
 	bool       allow_arrow_right_selector_expr;
 	bool       allow_c_vararg_param;
+	bool       allow_constant_map_literal;
 	u8         bit_field_bit_size;
 	Scope *    polymorphic_scope;
 
@@ -853,6 +882,7 @@ struct Checker {
 
 	MPSCQueue<Entity *> procs_with_deferred_to_check;
 	MPSCQueue<Entity *> procs_with_objc_context_provider_to_check;
+	BlockingMutex     procs_to_check_mutex;
 	Array<ProcInfo *> procs_to_check;
 
 	BlockingMutex nested_proc_lits_mutex;
@@ -861,6 +891,7 @@ struct Checker {
 
 	MPSCQueue<UntypedExprInfo> global_untyped_queue;
 	MPSCQueue<Type *> soa_types_to_complete;
+	BlockingMutex     soa_types_to_complete_mutex; // the queue has a single consumer at a time
 };
 
 
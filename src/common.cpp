@@ -42,6 +42,7 @@ gb_internal i32 next_pow2(i32 n);
 gb_internal i64 next_pow2(i64 n);
 gb_internal isize next_pow2_isize(isize n);
 gb_internal void debugf(char const *fmt, ...);
+gb_internal u64 time_stamp_time_now(void);
 
 #if defined(GB_SYSTEM_WINDOWS) && defined(GB_ARCH_32_BIT)
 #error Odin on Windows requires a 64-bit build-system. The 'Developer Command Prompt' for VS still defaults to 32-bit shell. The 64-bit shell can be found under the name 'x64 Native Tools Command Prompt' for VS. For more information, please see https://odin-lang.org/docs/install/#for-windows
@@ -375,6 +376,7 @@ gb_global String global_module_path = {0};
 gb_global bool global_module_path_set = false;
 
 
+#include "hash128.cpp"
 #include "ptr_map.cpp"
 #include "ptr_set.cpp"
 #include "string_map.cpp"
@@ -761,7 +763,16 @@ enum LoadedFileError {
 	LoadedFile_COUNT,
 };
 
-gb_internal LoadedFileError load_file_32(char const *fullpath, LoadedFile *memory_mapped_file, bool copy_file_contents) {
+struct LoadedFileStats {
+	std::atomic<isize> file_count;
+	std::atomic<isize> mapped_count;
+	std::atomic<isize> total_bytes;
+	std::atomic<u64>   total_time; // in `time_stamp_time_now` units
+};
+
+gb_global LoadedFileStats global_loaded_file_stats;
+
+gb_internal LoadedFileError load_file_32_internal(char const *fullpath, LoadedFile *memory_mapped_file, bool copy_file_contents) {
 	LoadedFileError err = LoadedFile_None;
 	
 	if (!copy_file_contents) {
@@ -831,6 +842,55 @@ gb_internal LoadedFileError load_file_32(char const *fullpath, LoadedFile *memor
 			}
 			return err;
 		}
+	#else
+		int fd = open(fullpath, O_RDONLY);
+		if (fd < 0) {
+			switch (errno) {
+			case ENOENT:
+			case ENOTDIR:
+				return LoadedFile_NotExists;
+			case EACCES:
+			case EPERM:
+				return LoadedFile_Permission;
+			}
+			return LoadedFile_Invalid;
+		}
+
+		struct stat st = {};
+		if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+			close(fd);
+			return LoadedFile_Invalid;
+		}
+		if (st.st_size > I32_MAX) {
+			close(fd);
+			return LoadedFile_FileTooLarge;
+		}
+		if (st.st_size == 0) {
+			close(fd);
+			memory_mapped_file->handle = nullptr;
+			memory_mapped_file->data   = nullptr;
+			memory_mapped_file->size   = 0;
+			return LoadedFile_Empty;
+		}
+
+		int map_flags = MAP_PRIVATE;
+	#if defined(MAP_POPULATE)
+		// NOTE: pre-fault the whole file up front, as the tokenizer will touch every page anyway
+		map_flags |= MAP_POPULATE;
+	#endif
+		void *file_data = mmap(nullptr, cast(size_t)st.st_size, PROT_READ, map_flags, fd, 0);
+		close(fd);
+
+		if (file_data != MAP_FAILED) {
+			madvise(file_data, cast(size_t)st.st_size, MADV_SEQUENTIAL);
+
+			// NOTE: the mapping is never unmapped, the same as the copied contents never being freed
+			memory_mapped_file->handle = file_data;
+			memory_mapped_file->data   = file_data;
+			memory_mapped_file->size   = cast(i32)st.st_size;
+			return LoadedFile_None;
+		}
+		// NOTE: fallback to copying the file contents if it cannot be mapped
 	#endif
 	}
 	
@@ -861,6 +921,24 @@ gb_internal LoadedFileError load_file_32(char const *fullpath, LoadedFile *memor
 	return err;
 }
 
+// NOTE: when `copy_file_contents` is false, the file is memory mapped rather than copied into the permanent arena
+gb_internal LoadedFileError load_file_32(char const *fullpath, LoadedFile *memory_mapped_file, bool copy_file_contents) {
+	u64 start = time_stamp_time_now();
+	LoadedFileError err = load_file_32_internal(fullpath, memory_mapped_file, copy_file_contents);
+	u64 finish = time_stamp_time_now();
+
+	LoadedFileStats *stats = &global_loaded_file_stats;
+	stats->total_time.fetch_add(finish - start, std::memory_order_relaxed);
+	if (err == LoadedFile_None) {
+		stats->file_count.fetch_add(1, std::memory_order_relaxed);
+		stats->total_bytes.fetch_add(memory_mapped_file->size, std::memory_order_relaxed);
+		if (memory_mapped_file->handle != nullptr) {
+			stats->mapped_count.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	return err;
+}
+
 
 
 
@@ -1,6 +1,12 @@
 #if defined(GB_SYSTEM_LINUX)
 #include <malloc.h>
 #endif
+#if defined(GB_SYSTEM_OSX)
+#include <malloc/malloc.h>
+#endif
+#if !defined(GB_SYSTEM_WINDOWS)
+#include <sys/resource.h>
+#endif
 
 #ifdef __ANDROID__
 
@@ -69,10 +75,16 @@ struct Arena {
 	isize         temp_count;
 	Thread *      parent_thread;
 	bool          custom_arena;
+	std::atomic<isize> committed; // only written by the owning thread, read by -show-memory
 };
 
 enum { DEFAULT_MINIMUM_BLOCK_SIZE = 8ll*1024ll*1024ll };
 
+// NOTE: set by -internal-poison-temporary-memory, rewound temporary memory is filled with this byte rather
+// than zeroed, so anything which escapes a `TEMPORARY_ALLOCATOR_GUARD` reads obvious garbage
+enum : u8 { ARENA_POISON_BYTE = 0xdb };
+gb_global bool global_arena_poison_rewound_memory;
+
 gb_global isize DEFAULT_PAGE_SIZE = 4096;
 
 gb_internal MemoryBlock *virtual_memory_alloc(isize size, bool commit);
@@ -119,6 +131,7 @@ gb_internal void *arena_alloc(Arena *arena, isize min_size, isize alignment) {
 		MemoryBlock *new_block = virtual_memory_alloc(block_size, true);
 		new_block->prev = arena->curr_block;
 		arena->curr_block = new_block;
+		arena->committed.fetch_add(new_block->size, std::memory_order_relaxed);
 	}
 	
 	MemoryBlock *curr_block = arena->curr_block;
@@ -130,6 +143,11 @@ gb_internal void *arena_alloc(Arena *arena, isize min_size, isize alignment) {
 	curr_block->used += size;
 	GB_ASSERT(curr_block->used <= curr_block->size);
 
+	if (global_arena_poison_rewound_memory) {
+		// NOTE: the memory may have been poisoned by an earlier `arena_temp_end`
+		gb_zero_size(ptr, min_size);
+	}
+
 	// NOTE(bill): memory will be zeroed by default due to virtual memory 
 	return ptr;	
 }
@@ -201,6 +219,7 @@ gb_internal void arena_free_all(Arena *arena) {
 	while (arena->curr_block != nullptr) {
 		MemoryBlock *free_block = arena->curr_block;
 		arena->curr_block = free_block->prev;
+		arena->committed.fetch_sub(free_block->size, std::memory_order_relaxed);
 		virtual_memory_dealloc(free_block);
 	}
 }
@@ -386,6 +405,7 @@ struct ArenaTemp {
 	Arena *      arena;
 	MemoryBlock *block;
 	isize        used;
+	isize        temp_count; // `arena->temp_count` at `arena_temp_begin`, to check the nesting
 };
 
 ArenaTemp arena_temp_begin(Arena *arena) {
@@ -398,6 +418,7 @@ ArenaTemp arena_temp_begin(Arena *arena) {
 	if (arena->curr_block != nullptr) {
 		temp.used = arena->curr_block->used;
 	}
+	temp.temp_count = arena->temp_count;
 	arena->temp_count += 1;
 	return temp;
 }
@@ -407,6 +428,9 @@ void arena_temp_end(ArenaTemp const &temp) {
 	Arena *arena = temp.arena;
 	GB_ASSERT(arena->parent_thread == get_current_thread());
 
+	GB_ASSERT_MSG(arena->temp_count > 0, "double-use of arena_temp_end");
+	GB_ASSERT_MSG(arena->temp_count == temp.temp_count+1, "out of order use of arena_temp_end");
+
 	if (temp.block) {
 		bool memory_block_found = false;
 		for (MemoryBlock *block = arena->curr_block; block != nullptr; block = block->prev) {
@@ -416,25 +440,29 @@ void arena_temp_end(ArenaTemp const &temp) {
 			}
 		}
 		GB_ASSERT_MSG(memory_block_found, "memory block stored within ArenaTemp not owned by Arena");
+	}
 
-		while (arena->curr_block != temp.block) {
-			MemoryBlock *free_block = arena->curr_block;
-			if (free_block != nullptr) {
-				arena->curr_block = free_block->prev;
-				virtual_memory_dealloc(free_block);
-			}
-		}
+	// NOTE: when the arena had no block at `arena_temp_begin`, every block allocated since is freed
+	while (arena->curr_block != temp.block) {
+		MemoryBlock *free_block = arena->curr_block;
+		arena->curr_block = free_block->prev;
+		arena->committed.fetch_sub(free_block->size, std::memory_order_relaxed);
+		virtual_memory_dealloc(free_block);
+	}
 
-		MemoryBlock *block = arena->curr_block;
-		if (block) {
-			GB_ASSERT_MSG(block->used >= temp.used, "out of order use of arena_temp_end");
-			isize amount_to_zero = gb_min(block->used - temp.used, block->size - block->used);
-			gb_zero_size(block->base + temp.used, amount_to_zero);
-			block->used = temp.used;
+	MemoryBlock *block = arena->curr_block;
+	if (block) {
+		GB_ASSERT_MSG(block->used >= temp.used, "out of order use of arena_temp_end");
+		// NOTE: `arena_alloc` relies upon unused memory being zeroed, so all of the rewound memory must be cleared
+		isize amount = block->used - temp.used;
+		if (global_arena_poison_rewound_memory) {
+			gb_memset(block->base + temp.used, ARENA_POISON_BYTE, amount);
+		} else {
+			gb_zero_size(block->base + temp.used, amount);
 		}
+		block->used = temp.used;
 	}
 
-	GB_ASSERT_MSG(arena->temp_count > 0, "double-use of arena_temp_end");
 	arena->temp_count -= 1;
 }
 
@@ -504,6 +532,8 @@ gb_internal GB_ALLOCATOR_PROC(arena_allocator_proc) {
 enum ThreadArenaKind : uintptr {
 	ThreadArena_Permanent,
 	ThreadArena_Temporary,
+
+	ThreadArena_COUNT,
 };
 
 gb_global Arena default_permanent_arena = {nullptr, DEFAULT_MINIMUM_BLOCK_SIZE};
@@ -604,17 +634,18 @@ gb_internal gbAllocator permanent_allocator() {
 	return {thread_arena_allocator_proc, cast(void *)cast(uintptr)ThreadArena_Permanent};
 }
 
+// NOTE: memory from the temporary allocator only lives until the innermost enclosing
+// `TEMPORARY_ALLOCATOR_GUARD` of the current thread ends; anything which must outlive it has to be
+// allocated with the `permanent_allocator` (or copied into it)
 gb_internal gbAllocator temporary_allocator() {
-	// return {thread_arena_allocator_proc, cast(void *)cast(uintptr)ThreadArena_Temporary};
-	return permanent_allocator();
+	return {thread_arena_allocator_proc, cast(void *)cast(uintptr)ThreadArena_Temporary};
 }
 
 
 #define TEMP_ARENA_GUARD(arena) ArenaTempGuard GB_DEFER_3(_arena_guard_){arena}
 
 
-// #define TEMPORARY_ALLOCATOR_GUARD() TEMP_ARENA_GUARD(get_arena(ThreadArena_Temporary))
-#define TEMPORARY_ALLOCATOR_GUARD()
+#define TEMPORARY_ALLOCATOR_GUARD() TEMP_ARENA_GUARD(get_arena(ThreadArena_Temporary))
 #define PERMANENT_ALLOCATOR_GUARD()
 
 
@@ -673,8 +704,9 @@ gb_internal GB_ALLOCATOR_PROC(heap_allocator_proc) {
 	// TODO(bill): *nix version that's decent
 	case gbAllocation_Alloc: {
 		isize total_size = (size + alignment - 1) & ~(alignment - 1);
-		total_heap_memory_allocated.fetch_add(total_size);
 		ptr = aligned_alloc(alignment, total_size);
+		// NOTE: counted as what `free` will subtract, not what was asked for
+		total_heap_memory_allocated.fetch_add(malloc_usable_size(ptr));
 		gb_zero_size(ptr, size);
 	} break;
 
@@ -698,8 +730,8 @@ gb_internal GB_ALLOCATOR_PROC(heap_allocator_proc) {
 
 		if (old_memory == nullptr) {
 			isize total_size = (size + alignment - 1) & ~(alignment - 1);
-			total_heap_memory_allocated.fetch_add(total_size);
 			ptr = aligned_alloc(alignment, total_size);
+			total_heap_memory_allocated.fetch_add(malloc_usable_size(ptr));
 			gb_zero_size(ptr, size);
 			break;
 		}
@@ -715,9 +747,10 @@ gb_internal GB_ALLOCATOR_PROC(heap_allocator_proc) {
 		}
 
 		isize total_size = (size + alignment - 1) & ~(alignment - 1);
-		total_heap_memory_allocated.fetch_add(total_size);
 		ptr = aligned_alloc(alignment, total_size);
+		total_heap_memory_allocated.fetch_add(malloc_usable_size(ptr));
 		gb_memmove(ptr, old_memory, old_size);
+		total_heap_memory_allocated.fetch_sub(actual_old_size);
 		free(old_memory);
 		gb_zero_size(cast(u8 *)ptr + old_size, gb_max(size-old_size, 0));
 	} break;
@@ -776,6 +809,42 @@ gb_internal GB_ALLOCATOR_PROC(heap_allocator_proc) {
 }
 
 
+// NOTE: returns -1 when the platform cannot report it
+gb_internal i64 platform_peak_resident_memory(void) {
+#if defined(GB_SYSTEM_WINDOWS)
+	PROCESS_MEMORY_COUNTERS p = {sizeof(p)};
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &p, sizeof(p))) {
+		return cast(i64)p.PeakWorkingSetSize;
+	}
+#else
+	struct rusage usage = {};
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+	#if defined(GB_SYSTEM_OSX)
+		return cast(i64)usage.ru_maxrss; // bytes
+	#else
+		return cast(i64)usage.ru_maxrss * 1024; // kilobytes
+	#endif
+	}
+#endif
+	return -1;
+}
+
+// Bytes in use by malloc for the whole process, which includes the `heap_allocator` and LLVM.
+// NOTE: returns -1 when the platform cannot report it
+gb_internal i64 platform_malloc_in_use(void) {
+#if defined(GB_SYSTEM_LINUX) && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	struct mallinfo2 info = mallinfo2();
+	return cast(i64)(info.uordblks + info.hblkhd);
+#elif defined(GB_SYSTEM_OSX)
+	malloc_statistics_t stats = {};
+	malloc_zone_statistics(nullptr, &stats);
+	return cast(i64)stats.size_in_use;
+#else
+	return -1;
+#endif
+}
+
+
 template <typename T>
 gb_internal isize resize_array_raw(T **array, gbAllocator const &a, isize old_count, isize new_count, isize custom_alignment=1) {
 	GB_ASSERT(new_count >= 0);
@@ -9,6 +9,10 @@ struct ErrorValue {
 	TokenPos       end;
 	Array<u8>      msg;
 	bool           seen_newline;
+
+	// NOTE: errors at the same position are printed in the order they were reported, see `error_value_cmp`
+	u64            report_group;
+	u64            report_index;
 };
 
 struct ErrorCollector {
@@ -23,8 +27,16 @@ struct ErrorCollector {
 	Array<ErrorValue> error_values;
 	ErrorValue        curr_error_value;
 	std::atomic<bool> curr_error_value_set;
+
+	std::atomic<u64>  report_count;
+	std::atomic<u64>  default_report_group;
 };
 
+// NOTE: set while a thread checks work whose position in the serial order is known (e.g. a group of
+// global entities), so that errors reported on different threads are still ordered deterministically.
+// Otherwise `default_report_group` is used, which is raised once all of the groups have been checked.
+gb_thread_local u64 error_report_group;
+
 gb_global ErrorCollector global_error_collector;
 
 
@@ -32,6 +44,8 @@ gb_internal void push_error_value(TokenPos const &pos, ErrorValueKind kind = Err
 	GB_ASSERT_MSG(global_error_collector.curr_error_value_set.load() == false, "Possible race condition in error handling system, please report this with an issue");
 	ErrorValue ev = {kind, pos};
 	ev.msg.allocator = heap_allocator();
+	ev.report_group = error_report_group != 0 ? error_report_group : global_error_collector.default_report_group.load(std::memory_order_relaxed);
+	ev.report_index = global_error_collector.report_count.fetch_add(1, std::memory_order_relaxed);
 
 	global_error_collector.curr_error_value = ev;
 	global_error_collector.curr_error_value_set.store(true);
@@ -122,6 +136,19 @@ gb_internal bool thread_safe_set_ast_file_from_id(i32 index, AstFile *file) {
 	return ok;
 }
 
+// NOTE: only for a file which is re-parsed in place and keeps its id (`odin serve`)
+gb_internal void thread_safe_replace_ast_file_from_id(i32 index, AstFile *file, String const &path) {
+	GB_ASSERT(index >= 0);
+	mutex_lock(&global_files_mutex);
+
+	GB_ASSERT(index < global_files.count && global_files[index] != nullptr);
+	GB_ASSERT(index < global_file_path_strings.count);
+	global_files[index]             = file;
+	global_file_path_strings[index] = path;
+
+	mutex_unlock(&global_files_mutex);
+}
+
 gb_internal String get_file_path_string(i32 index) {
 	GB_ASSERT(index >= 0);
 	// mutex_lock(&global_error_collector.path_mutex);
@@ -837,7 +864,19 @@ gb_internal void exit_with_errors(void) {
 gb_internal int error_value_cmp(void const *a, void const *b) {
 	ErrorValue *x = cast(ErrorValue *)a;
 	ErrorValue *y = cast(ErrorValue *)b;
-	return token_pos_cmp(x->pos, y->pos);
+	i32 cmp = token_pos_cmp(x->pos, y->pos);
+	if (cmp != 0) {
+		return cmp;
+	}
+	// NOTE: the first error reported at a position is usually the root cause and any others are
+	// cascading from it, so keep them in the order of the serial checker
+	if (x->report_group != y->report_group) {
+		return x->report_group < y->report_group ? -1 : +1;
+	}
+	if (x->report_index != y->report_index) {
+		return x->report_index < y->report_index ? -1 : +1;
+	}
+	return 0;
 }
 
 gb_global String error_article_table[][2] = {
@@ -52,12 +52,19 @@ gb_global char const *exact_value_kind_string[ExactValue_Count] = {
 	"Variant",
 };
 
+// NOTE: An ExactValue_Integer which fits in an i64 is always stored inline in `value_small_integer`
+// (with `is_small_integer` set) and never in `value_integer`, so that the constants found in almost
+// all code never allocate. Only construct integers with `exact_value_i64`, `exact_value_u64` or
+// `exact_value_big_int`, and read them with the `exact_value_integer_*` procedures below, or
+// `exact_value_to_big_int` where a BigInt is really needed.
 struct ExactValue {
 	ExactValueKind kind;
+	bool           is_small_integer;
 	union {
 		bool           value_bool;
 		String         value_string;
 		BigInt         value_integer;
+		i64            value_small_integer;
 		f64            value_float;
 		i64            value_pointer; // NOTE(bill): This must be an integer and not a pointer
 		Complex128    *value_complex;
@@ -90,7 +97,10 @@ gb_internal uintptr hash_exact_value(ExactValue v) {
 		res = gb_fnv32a(v.value_string.text, v.value_string.len*gb_size_of(u16));
 		break;
 	case ExactValue_Integer:
-		{
+		if (v.is_small_integer) {
+			res = gb_fnv32a(&v.value_small_integer, gb_size_of(v.value_small_integer));
+			break;
+		} else {
 			u32 key = gb_fnv32a(v.value_integer.dp, gb_size_of(*v.value_integer.dp) * v.value_integer.used);
 			u8 last = (u8)v.value_integer.sign;
 			res = (key ^ last) * 0x01000193;
@@ -155,18 +165,134 @@ gb_internal ExactValue exact_value_string16(String16 string) {
 
 gb_internal ExactValue exact_value_i64(i64 i) {
 	ExactValue result = {ExactValue_Integer};
-	result.value_integer = {0};
-	big_int_from_i64(&result.value_integer, i);
+	result.is_small_integer = true;
+	result.value_small_integer = i;
 	return result;
 }
 
 gb_internal ExactValue exact_value_u64(u64 i) {
+	if (i <= cast(u64)I64_MAX) {
+		return exact_value_i64(cast(i64)i);
+	}
 	ExactValue result = {ExactValue_Integer};
 	result.value_integer = {0};
 	big_int_from_u64(&result.value_integer, i);
 	return result;
 }
 
+gb_internal bool big_int_fits_in_i64(BigInt const *x) {
+	int bits = mp_count_bits(x);
+	if (bits <= 63) {
+		return true;
+	}
+	// NOTE: I64_MIN is the only value which needs all 64 bits
+	return bits == 64 && big_int_is_neg(x) && mp_get_mag_u64(x) == (cast(u64)1 << 63);
+}
+
+// NOTE: takes ownership of `b`
+gb_internal ExactValue exact_value_big_int(BigInt const &b) {
+	if (big_int_fits_in_i64(&b)) {
+		return exact_value_i64(big_int_to_i64(&b));
+	}
+	ExactValue result = {ExactValue_Integer};
+	result.value_integer = b;
+	return result;
+}
+
+// NOTE: this allocates for a small integer, so only use it where the value really needs to be a BigInt
+gb_internal BigInt exact_value_to_big_int(ExactValue const &v) {
+	GB_ASSERT(v.kind == ExactValue_Integer);
+	if (v.is_small_integer) {
+		return big_int_make_i64(v.value_small_integer);
+	}
+	return v.value_integer;
+}
+
+gb_internal bool exact_value_integer_is_neg(ExactValue const &v) {
+	GB_ASSERT(v.kind == ExactValue_Integer);
+	if (v.is_small_integer) {
+		return v.value_small_integer < 0;
+	}
+	return big_int_is_neg(&v.value_integer);
+}
+
+gb_internal bool exact_value_integer_is_zero(ExactValue const &v) {
+	GB_ASSERT(v.kind == ExactValue_Integer);
+	if (v.is_small_integer) {
+		return v.value_small_integer == 0;
+	}
+	return big_int_is_zero(&v.value_integer);
+}
+
+gb_internal int exact_value_integer_cmp(ExactValue const &x, ExactValue const &y) {
+	GB_ASSERT(x.kind == ExactValue_Integer && y.kind == ExactValue_Integer);
+	if (x.is_small_integer && y.is_small_integer) {
+		i64 a = x.value_small_integer;
+		i64 b = y.value_small_integer;
+		return (a > b) - (a < b);
+	}
+	if (x.is_small_integer) {
+		// NOTE: `y` does not fit in an i64
+		return big_int_is_neg(&y.value_integer) ? +1 : -1;
+	}
+	if (y.is_small_integer) {
+		return big_int_is_neg(&x.value_integer) ? -1 : +1;
+	}
+	return big_int_cmp(&x.value_integer, &y.value_integer);
+}
+
+// The number of bits needed for the magnitude of the integer
+gb_internal i32 exact_value_integer_bit_count(ExactValue const &v) {
+	GB_ASSERT(v.kind == ExactValue_Integer);
+	if (v.is_small_integer) {
+		i64 i = v.value_small_integer;
+		u64 mag = i < 0 ? -cast(u64)i : cast(u64)i;
+		return mag == 0 ? 0 : cast(i32)(64 - leading_zeros_u64(mag));
+	}
+	return cast(i32)mp_count_bits(&v.value_integer);
+}
+
+gb_internal f64 exact_value_integer_to_f64(ExactValue const &v) {
+	GB_ASSERT(v.kind == ExactValue_Integer);
+	if (v.is_small_integer) {
+		return cast(f64)v.value_small_integer;
+	}
+	return big_int_to_f64(&v.value_integer);
+}
+
+// Unlike `hash_exact_value`, values which `compare_exact_values(Token_CmpEq, ...)` treats as equal always
+// hash the same, even across kinds (e.g. `3` and `3.0`). Only the real part of a complex or quaternion is
+// hashed, and kinds which are compared by identity (pointers, compounds, typeids, ...) all hash to 0.
+gb_internal u64 hash_exact_value_for_equality(ExactValue const &v) {
+	f64 f = 0;
+	switch (v.kind) {
+	case ExactValue_Bool:
+		return v.value_bool ? 2 : 1;
+	case ExactValue_String:
+		return cast(u64)string_hash(v.value_string) + 1;
+	case ExactValue_Integer:
+		// NOTE: integers are compared with floats as f64, so they must be hashed as f64 too
+		f = exact_value_integer_to_f64(v);
+		break;
+	case ExactValue_Float:
+		f = v.value_float;
+		break;
+	case ExactValue_Complex:
+		f = v.value_complex->real;
+		break;
+	case ExactValue_Quaternion:
+		f = v.value_quaternion->real;
+		break;
+	default:
+		return 0;
+	}
+	if (f == 0) {
+		f = 0; // -0.0 == 0.0
+	}
+	u64 bits = bit_cast<u64>(f);
+	return (bits ^ (bits >> 29)) * 0x100000001b3ull;
+}
+
 gb_internal ExactValue exact_value_float(f64 f) {
 	ExactValue result = {ExactValue_Float};
 	result.value_float = f;
@@ -216,15 +342,60 @@ gb_internal ExactValue exact_value_variant(Ast *node) {
 	return result;
 }
 
+// Parses the plain literals (an optional base prefix and digits) which fit in an i64, and leaves
+// everything else (signs, exponents, large values and errors) to `big_int_from_string`
+gb_internal bool small_integer_from_string(String const &s, i64 *value_) {
+	u64 base = 10;
+	isize i = 0;
+	if (s.len > 2 && s[0] == '0') {
+		switch (s[1]) {
+		case 'b': base = 2;  i = 2; break;
+		case 'o': base = 8;  i = 2; break;
+		case 'd': base = 10; i = 2; break;
+		case 'z': base = 12; i = 2; break;
+		case 'x': base = 16; i = 2; break;
+		case 'h': base = 16; i = 2; break;
+		}
+	}
+
+	u64 value = 0;
+	isize digit_count = 0;
+	for (; i < s.len; i++) {
+		Rune r = cast(Rune)s[i];
+		if (r == '_') {
+			continue;
+		}
+		u64 v = u64_digit_value(r);
+		if (v >= base) {
+			return false;
+		}
+		if (value > (cast(u64)I64_MAX - v) / base) {
+			return false;
+		}
+		value = value*base + v;
+		digit_count += 1;
+	}
+	if (digit_count == 0) {
+		return false;
+	}
+	*value_ = cast(i64)value;
+	return true;
+}
+
 gb_internal ExactValue exact_value_integer_from_string(String const &string) {
-	ExactValue result = {ExactValue_Integer};
-	result.value_integer = {0};
+	i64 small = 0;
+	if (small_integer_from_string(string, &small)) {
+		return exact_value_i64(small);
+	}
+
+	BigInt b = {};
 	bool success;
-	big_int_from_string(&result.value_integer, string, &success);
+	big_int_from_string(&b, string, &success);
 	if (!success) {
-		result = {ExactValue_Invalid};
+		ExactValue result = {ExactValue_Invalid};
+		return result;
 	}
-	return result;
+	return exact_value_big_int(b);
 }
 
 
@@ -461,7 +632,7 @@ gb_internal ExactValue exact_value_to_integer(ExactValue v) {
 gb_internal ExactValue exact_value_to_float(ExactValue v) {
 	switch (v.kind) {
 	case ExactValue_Integer:
-		return exact_value_float(big_int_to_f64(&v.value_integer));
+		return exact_value_float(exact_value_integer_to_f64(v));
 	case ExactValue_Float:
 		return v;
 	}
@@ -472,7 +643,7 @@ gb_internal ExactValue exact_value_to_float(ExactValue v) {
 gb_internal ExactValue exact_value_to_complex(ExactValue v) {
 	switch (v.kind) {
 	case ExactValue_Integer:
-		return exact_value_complex(big_int_to_f64(&v.value_integer), 0);
+		return exact_value_complex(exact_value_integer_to_f64(v), 0);
 	case ExactValue_Float:
 		return exact_value_complex(v.value_float, 0);
 	case ExactValue_Complex:
@@ -487,7 +658,7 @@ gb_internal ExactValue exact_value_to_complex(ExactValue v) {
 gb_internal ExactValue exact_value_to_quaternion(ExactValue v) {
 	switch (v.kind) {
 	case ExactValue_Integer:
-		return exact_value_quaternion(big_int_to_f64(&v.value_integer), 0, 0, 0);
+		return exact_value_quaternion(exact_value_integer_to_f64(v), 0, 0, 0);
 	case ExactValue_Float:
 		return exact_value_quaternion(v.value_float, 0, 0, 0);
 	case ExactValue_Complex:
@@ -596,6 +767,9 @@ gb_internal ExactValue exact_value_kmag(ExactValue v) {
 gb_internal i64 exact_value_to_i64(ExactValue v) {
 	v = exact_value_to_integer(v);
 	if (v.kind == ExactValue_Integer) {
+		if (v.is_small_integer) {
+			return v.value_small_integer;
+		}
 		return big_int_to_i64(&v.value_integer);
 	}
 	return 0;
@@ -603,6 +777,10 @@ gb_internal i64 exact_value_to_i64(ExactValue v) {
 gb_internal u64 exact_value_to_u64(ExactValue v) {
 	v = exact_value_to_integer(v);
 	if (v.kind == ExactValue_Integer) {
+		if (v.is_small_integer) {
+			GB_ASSERT(v.value_small_integer >= 0);
+			return cast(u64)v.value_small_integer;
+		}
 		return big_int_to_u64(&v.value_integer);
 	}
 	return 0;
@@ -639,10 +817,13 @@ gb_internal ExactValue exact_unary_operator_value(TokenKind op, ExactValue v, i3
 		case ExactValue_Invalid:
 			return v;
 		case ExactValue_Integer: {
-			ExactValue i = {ExactValue_Integer};
-			i.value_integer = {0};
-			big_int_neg(&i.value_integer, &v.value_integer);
-			return i;
+			if (v.is_small_integer && v.value_small_integer != I64_MIN) {
+				return exact_value_i64(-v.value_small_integer);
+			}
+			BigInt x = exact_value_to_big_int(v);
+			BigInt i = {};
+			big_int_neg(&i, &x);
+			return exact_value_big_int(i);
 		}
 		case ExactValue_Float: {
 			ExactValue i = v;
@@ -671,10 +852,21 @@ gb_internal ExactValue exact_unary_operator_value(TokenKind op, ExactValue v, i3
 			return v;
 		case ExactValue_Integer: {
 			GB_ASSERT(precision != 0);
-			ExactValue i = {ExactValue_Integer};
-			i.value_integer = {0};
-			big_int_not(&i.value_integer, &v.value_integer, precision, !is_unsigned);
-			return i;
+			if (v.is_small_integer && 0 < precision && precision <= 64) {
+				// NOTE: the same as `big_int_not`, in two's complement
+				i64 x = v.value_small_integer;
+				u64 mask = precision == 64 ? ~cast(u64)0 : (cast(u64)1 << precision) - 1;
+				u64 r = ~cast(u64)x & mask;
+				if (!is_unsigned && x >= 0) {
+					u64 sign_bit = cast(u64)1 << (precision-1);
+					return exact_value_i64((r & sign_bit) ? cast(i64)(r | ~mask) : cast(i64)r);
+				}
+				return exact_value_u64(r);
+			}
+			BigInt x = exact_value_to_big_int(v);
+			BigInt i = {};
+			big_int_not(&i, &x, precision, !is_unsigned);
+			return exact_value_big_int(i);
 		}
 		default:
 			goto failure;
@@ -755,13 +947,13 @@ gb_internal void match_exact_values(ExactValue *x, ExactValue *y) {
 			return;
 		case ExactValue_Float:
 			// TODO(bill): Is this good enough?
-			*x = exact_value_float(big_int_to_f64(&x->value_integer));
+			*x = exact_value_float(exact_value_integer_to_f64(*x));
 			return;
 		case ExactValue_Complex:
-			*x = exact_value_complex(big_int_to_f64(&x->value_integer), 0);
+			*x = exact_value_complex(exact_value_integer_to_f64(*x), 0);
 			return;
 		case ExactValue_Quaternion:
-			*x = exact_value_quaternion(big_int_to_f64(&x->value_integer), 0, 0, 0);
+			*x = exact_value_quaternion(exact_value_integer_to_f64(*x), 0, 0, 0);
 			return;
 		}
 		break;
@@ -797,6 +989,81 @@ gb_internal void match_exact_values(ExactValue *x, ExactValue *y) {
 	compiler_error("match_exact_values: How'd you get here? Invalid ExactValueKind %d", x->kind);
 }
 
+// The result of `a op b` when it is an integer which fits in an i64, otherwise false and the
+// operation is done with BigInts
+gb_internal bool exact_binary_operator_small_integer(TokenKind op, i64 a, i64 b, i64 *c_) {
+	i64 c = 0;
+	switch (op) {
+	case Token_Add:
+		if ((b > 0 && a > I64_MAX - b) || (b < 0 && a < I64_MIN - b)) {
+			return false;
+		}
+		c = a + b;
+		break;
+	case Token_Sub:
+		if ((b < 0 && a > I64_MAX + b) || (b > 0 && a < I64_MIN + b)) {
+			return false;
+		}
+		c = a - b;
+		break;
+	case Token_Mul:
+	#if defined(GB_COMPILER_MSVC)
+		if (a < I32_MIN || a > I32_MAX || b < I32_MIN || b > I32_MAX) {
+			return false;
+		}
+		c = a * b;
+	#else
+		if (__builtin_mul_overflow(a, b, &c)) {
+			return false;
+		}
+	#endif
+		break;
+	case Token_QuoEq:
+	case Token_Mod:
+	case Token_ModMod:
+		if (b == 0 || (a == I64_MIN && b == -1)) {
+			return false;
+		}
+		if (op == Token_QuoEq) {
+			c = a / b;
+		} else if (op == Token_Mod) {
+			c = a % b;
+		} else {
+			// NOTE: the same as `big_int_mod_mod`
+			i64 r = a % b;
+			if ((b > 0 && r > I64_MAX - b) || (b < 0 && r < I64_MIN - b)) {
+				return false;
+			}
+			c = (r + b) % b;
+		}
+		break;
+	// NOTE: BigInt bitwise operations have two's complement semantics
+	case Token_And:    c = a & b;  break;
+	case Token_Or:     c = a | b;  break;
+	case Token_Xor:    c = a ^ b;  break;
+	case Token_AndNot: c = a & ~b; break;
+	case Token_Shl:
+		if (b < 0 || b >= 63) {
+			return false;
+		}
+		c = cast(i64)(cast(u64)a << b);
+		if ((c >> b) != a) {
+			return false;
+		}
+		break;
+	case Token_Shr:
+		if (b < 0) {
+			return false;
+		}
+		c = b >= 64 ? (a < 0 ? -1 : 0) : (a >> b);
+		break;
+	default:
+		return false;
+	}
+	*c_ = c;
+	return true;
+}
+
 gb_internal ExactValue exact_binary_operator_value(TokenKind op, ExactValue x, ExactValue y) {
 	match_exact_values(&x, &y);
 
@@ -817,8 +1084,20 @@ gb_internal ExactValue exact_binary_operator_value(TokenKind op, ExactValue x, E
 		break;
 
 	case ExactValue_Integer: {
-		BigInt const *a = &x.value_integer;
-		BigInt const *b = &y.value_integer;
+		if (x.is_small_integer && y.is_small_integer) {
+			i64 c = 0;
+			if (exact_binary_operator_small_integer(op, x.value_small_integer, y.value_small_integer, &c)) {
+				return exact_value_i64(c);
+			}
+			if (op == Token_Quo) {
+				return exact_value_float(fmod(cast(f64)x.value_small_integer, cast(f64)y.value_small_integer));
+			}
+		}
+
+		BigInt xb = exact_value_to_big_int(x);
+		BigInt yb = exact_value_to_big_int(y);
+		BigInt const *a = &xb;
+		BigInt const *b = &yb;
 		BigInt c = {};
 		switch (op) {
 		case Token_Add:    big_int_add(&c, a, b); break;
@@ -836,9 +1115,7 @@ gb_internal ExactValue exact_binary_operator_value(TokenKind op, ExactValue x, E
 		case Token_Shr:    big_int_shr(&c, a, b);     break;
 		default: goto error;
 		}
-		ExactValue res = {ExactValue_Integer};
-		res.value_integer = c;
-		return res;
+		return exact_value_big_int(c);
 	}
 
 	case ExactValue_Float: {
@@ -1010,7 +1287,7 @@ gb_internal bool compare_exact_values(TokenKind op, ExactValue x, ExactValue y)
 		break;
 
 	case ExactValue_Integer: {
-		i32 cmp = big_int_cmp(&x.value_integer, &y.value_integer);
+		i32 cmp = exact_value_integer_cmp(x, y);
 		switch (op) {
 		case Token_CmpEq: return cmp == 0;
 		case Token_NotEq: return cmp != 0;
@@ -1196,6 +1473,9 @@ gb_internal gbString write_exact_value_to_string(gbString str, ExactValue const
 		return str;
 	}
 	case ExactValue_Integer: {
+		if (v.is_small_integer) {
+			return gb_string_append_fmt(str, "%lld", cast(long long)v.value_small_integer);
+		}
 		String s = big_int_to_string(heap_allocator(), &v.value_integer);
 		str = gb_string_append_length(str, s.text, s.len);
 		gb_free(heap_allocator(), s.text);
@@ -0,0 +1,228 @@
+// A fast non-cryptographic 128-bit hash used for content addressing (build caches)
+//
+// The bulk loop follows the structure of XXH3: eight 64-bit accumulators consume 64-byte stripes,
+// each lane adding `lo32(data^key) * hi32(data^key)` to itself and the raw data to its neighbour,
+// and every block of 16 stripes the accumulators are scrambled. The SSE2 and scalar paths produce
+// identical results, so a hash written by one machine can be checked on another.
+
+#if defined(GB_CPU_X86) && (defined(__SSE2__) || defined(GB_COMPILER_MSVC))
+#include <emmintrin.h>
+#define HASH128_SSE2 1
+#endif
+
+struct Hash128 {
+	u64 lo;
+	u64 hi;
+};
+
+gb_internal gb_inline bool operator==(Hash128 const &a, Hash128 const &b) { return a.lo == b.lo && a.hi == b.hi; }
+gb_internal gb_inline bool operator!=(Hash128 const &a, Hash128 const &b) { return !(a == b); }
+
+enum : isize {
+	HASH128_STRIPE_LEN       = 64,
+	HASH128_STRIPES_PER_BLOCK = 16,
+	HASH128_BLOCK_LEN        = HASH128_STRIPE_LEN*HASH128_STRIPES_PER_BLOCK,
+};
+
+gb_global u64 const HASH128_PRIME32_1 = 0x9e3779b1ull;
+gb_global u64 const HASH128_PRIME64_1 = 0x9e3779b185ebca87ull;
+gb_global u64 const HASH128_PRIME64_2 = 0xc2b2ae3d27d4eb4full;
+
+gb_global u64 const hash128_secret[24] = {
+	0x6e789e6aa1b965f4ull, 0x06c45d188009454full, 0xf88bb8a8724c81ecull, 0x1b39896a51a8749bull,
+	0x53cb9f0c747ea2eaull, 0x2c829abe1f4532e1ull, 0xc584133ac916ab3cull, 0x3ee5789041c98ac3ull,
+	0xf3b8488c368cb0a6ull, 0x657eecdd3cb13d09ull, 0xc2d326e0055bdef6ull, 0x8621a03fe0bbdb7bull,
+	0x8e1f7555983aa92full, 0xb54e0f1600cc4d19ull, 0x84bb3f97971d80abull, 0x7d29825c75521255ull,
+	0xc3cf17102b7f7f86ull, 0x3466e9a083914f64ull, 0xd81a8d2b5a4485acull, 0xdb01602b100b9ed7ull,
+	0xa9038a921825f10dull, 0xedf5f1d90dca2f6aull, 0x54496ad67bd2634cull, 0xdd7c01d4f5407269ull,
+};
+
+// NOTE: `memcpy` rather than `gb_memcopy`, which the compiler cannot turn into a single load
+gb_internal gb_inline u64 hash128_read_u64(u8 const *p) {
+	u64 x;
+	memcpy(&x, p, 8);
+	return x;
+}
+
+gb_internal gb_inline u64 hash128_mul_fold64(u64 x, u64 y) {
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 r = cast(unsigned __int128)x * cast(unsigned __int128)y;
+	return cast(u64)r ^ cast(u64)(r >> 64);
+#else
+	u64 lo, hi;
+	mul_overflow_u64(x, y, &lo, &hi);
+	return lo ^ hi;
+#endif
+}
+
+gb_internal gb_inline u64 hash128_avalanche(u64 h) {
+	h ^= h >> 37;
+	h *= 0x165667919e3779f9ull;
+	h ^= h >> 32;
+	return h;
+}
+
+#if defined(HASH128_SSE2)
+gb_internal gb_inline void hash128_accumulate_stripe(u64 acc[8], u8 const *p) {
+	__m128i *xacc = cast(__m128i *)acc;
+	for (isize i = 0; i < 4; i++) {
+		__m128i data  = _mm_loadu_si128(cast(__m128i const *)(p + 16*i));
+		__m128i key   = _mm_loadu_si128(cast(__m128i const *)(hash128_secret + 2*i));
+		__m128i dk    = _mm_xor_si128(data, key);
+		__m128i dk_hi = _mm_shuffle_epi32(dk, _MM_SHUFFLE(0, 3, 0, 1));
+		__m128i prod  = _mm_mul_epu32(dk, dk_hi);
+		__m128i swap  = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+		xacc[i] = _mm_add_epi64(xacc[i], _mm_add_epi64(prod, swap));
+	}
+}
+
+gb_internal gb_inline void hash128_scramble(u64 acc[8]) {
+	__m128i *xacc = cast(__m128i *)acc;
+	__m128i prime = _mm_set1_epi32(cast(int)HASH128_PRIME32_1);
+	for (isize i = 0; i < 4; i++) {
+		__m128i key = _mm_loadu_si128(cast(__m128i const *)(hash128_secret + 8 + 2*i));
+		__m128i a   = xacc[i];
+		a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+		a = _mm_xor_si128(a, key);
+		__m128i a_hi    = _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1));
+		__m128i prod_lo = _mm_mul_epu32(a, prime);
+		__m128i prod_hi = _mm_mul_epu32(a_hi, prime);
+		xacc[i] = _mm_add_epi64(prod_lo, _mm_slli_epi64(prod_hi, 32));
+	}
+}
+#else
+gb_internal gb_inline void hash128_accumulate_stripe(u64 acc[8], u8 const *p) {
+	for (isize i = 0; i < 8; i++) {
+		u64 data = hash128_read_u64(p + 8*i);
+		u64 dk   = data ^ hash128_secret[i];
+		acc[i^1] += data;
+		acc[i]   += (dk & 0xffffffffull) * (dk >> 32);
+	}
+}
+
+gb_internal gb_inline void hash128_scramble(u64 acc[8]) {
+	for (isize i = 0; i < 8; i++) {
+		u64 a = acc[i];
+		a ^= a >> 47;
+		a ^= hash128_secret[8 + i];
+		acc[i] = a * HASH128_PRIME32_1;
+	}
+}
+#endif
+
+gb_internal Hash128 hash128(void const *data, isize len, u64 seed=0) {
+	u8 const *p = cast(u8 const *)data;
+	isize remaining = len;
+
+	alignas(16) u64 acc[8] = {
+		HASH128_PRIME32_1,        HASH128_PRIME64_1 ^ seed,
+		HASH128_PRIME64_2,        0x27d4eb2f165667c5ull ^ seed,
+		0x85ebca77c2b2ae63ull,    HASH128_PRIME64_2 ^ seed,
+		HASH128_PRIME64_1,        HASH128_PRIME32_1 ^ seed,
+	};
+
+	for (; remaining >= HASH128_BLOCK_LEN; remaining -= HASH128_BLOCK_LEN, p += HASH128_BLOCK_LEN) {
+		for (isize i = 0; i < HASH128_STRIPES_PER_BLOCK; i++) {
+			hash128_accumulate_stripe(acc, p + i*HASH128_STRIPE_LEN);
+		}
+		hash128_scramble(acc);
+	}
+	for (; remaining >= HASH128_STRIPE_LEN; remaining -= HASH128_STRIPE_LEN, p += HASH128_STRIPE_LEN) {
+		hash128_accumulate_stripe(acc, p);
+	}
+	if (remaining > 0) {
+		// NOTE: the trailing bytes are zero padded to a full stripe; the length is mixed in below
+		u8 last[HASH128_STRIPE_LEN] = {};
+		gb_memcopy(last, p, remaining);
+		hash128_accumulate_stripe(acc, last);
+	}
+
+	u64 ulen = cast(u64)len;
+	Hash128 h = {};
+	h.lo = ulen * HASH128_PRIME64_1;
+	h.hi = ~ulen * HASH128_PRIME64_2;
+	for (isize i = 0; i < 4; i++) {
+		h.lo += hash128_mul_fold64(acc[2*i] ^ hash128_secret[16 + 2*i], acc[2*i+1] ^ hash128_secret[16 + 2*i+1]);
+		h.hi += hash128_mul_fold64(acc[2*i] ^ hash128_secret[8 + 2*i+1],  acc[2*i+1] ^ hash128_secret[2*i]);
+	}
+	h.lo = hash128_avalanche(h.lo);
+	h.hi = hash128_avalanche(h.hi ^ seed);
+	return h;
+}
+
+gb_internal Hash128 hash128_string(String const &s, u64 seed=0) {
+	return hash128(s.text, s.len, seed);
+}
+
+gb_internal gb_inline u64 hash64_read_u32(u8 const *p) {
+	u32 x;
+	memcpy(&x, p, 4);
+	return x;
+}
+
+gb_internal gb_inline void hash64_mul128(u64 *a, u64 *b) {
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 r = cast(unsigned __int128)*a * cast(unsigned __int128)*b;
+	*a = cast(u64)r;
+	*b = cast(u64)(r >> 64);
+#else
+	mul_overflow_u64(*a, *b, a, b);
+#endif
+}
+
+// A 64-bit hash for short keys such as identifiers, used by `string_hash`
+//
+// The structure follows wyhash: inputs of up to 16 bytes are read as two possibly overlapping words so there is
+// no byte loop, longer inputs are folded 16 bytes at a time, and the result is mixed with a 64x64->128 multiply.
+gb_internal u64 hash64(void const *data, isize len, u64 seed=0) {
+	u8 const *p = cast(u8 const *)data;
+	u64 const s0 = hash128_secret[0];
+	u64 const s1 = hash128_secret[1];
+	u64 const s2 = hash128_secret[2];
+
+	seed ^= hash128_mul_fold64(seed ^ s0, s1);
+	u64 a = 0;
+	u64 b = 0;
+	if (len <= 16) {
+		if (len >= 4) {
+			isize mid = (len >> 3) << 2;
+			a = (hash64_read_u32(p) << 32)         | hash64_read_u32(p + mid);
+			b = (hash64_read_u32(p + len-4) << 32) | hash64_read_u32(p + len-4 - mid);
+		} else if (len > 0) {
+			a = (cast(u64)p[0] << 16) | (cast(u64)p[len >> 1] << 8) | p[len-1];
+		}
+	} else {
+		isize i = len;
+		for (; i > 16; i -= 16, p += 16) {
+			seed = hash128_mul_fold64(hash128_read_u64(p) ^ s1, hash128_read_u64(p + 8) ^ seed);
+		}
+		a = hash128_read_u64(p + i-16);
+		b = hash128_read_u64(p + i-8);
+	}
+	a ^= s1;
+	b ^= seed;
+	hash64_mul128(&a, &b);
+	return hash128_mul_fold64(a ^ s0 ^ cast(u64)len, b ^ s2);
+}
+
+// Formats as 32 lower-case hexadecimal digits
+gb_internal gbString hash128_append_hex(gbString str, Hash128 const &h) {
+	return gb_string_append_fmt(str, "%016llx%016llx", cast(unsigned long long)h.hi, cast(unsigned long long)h.lo);
+}
+
+gb_internal bool hash128_from_hex(String const &s, Hash128 *h_) {
+	if (s.len != 32) {
+		return false;
+	}
+	u64 parts[2] = {};
+	for (isize i = 0; i < 32; i++) {
+		u64 d = u64_digit_value(s[i]);
+		if (d >= 16) {
+			return false;
+		}
+		parts[i/16] = (parts[i/16] << 4) | d;
+	}
+	h_->hi = parts[0];
+	h_->lo = parts[1];
+	return true;
+}
@@ -1016,6 +1016,12 @@ try_cross_linking:;
 				TIME_SECTION("Linking");
 			}
 
+			if (build_context.split_dwarf && (build_context.linker_choice == Linker_lld || build_context.linker_choice == Linker_mold)) {
+				// NOTE: the debug information is in the `.dwo` files, so have the linker build the
+				// `.gdb_index` from the skeleton units, otherwise the debugger has to open every `.dwo` on startup
+				link_command_line = gb_string_appendc(link_command_line, " -Wl,--gdb-index ");
+			}
+
 			if (build_context.linker_choice == Linker_lld) {
 				link_command_line = gb_string_append_fmt(link_command_line, " -fuse-ld=lld");
 				result = system_exec_command_line_app("lld-link", link_command_line);
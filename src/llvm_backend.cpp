@@ -2016,6 +2016,7 @@ gb_internal WORKER_TASK_PROC(lb_llvm_module_verification_worker_proc) {
 	char *llvm_error = nullptr;
 	defer (LLVMDisposeMessage(llvm_error));
 	lbModule *m = cast(lbModule *)data;
+	TRACE_SCOPE("verify module", make_string_c(m->module_name));
 
 	if (LLVMVerifyModule(m->mod, LLVMReturnStatusAction, &llvm_error)) {
 		gb_printf_err("LLVM Error in module %s:\n%s\n", m->module_name, llvm_error);
@@ -2228,8 +2229,29 @@ gb_internal lbProcedure *lb_create_cleanup_runtime(lbModule *main_module) { // C
 }
 
 
+// NOTE: with `-internal-schedule-by-cost`, the per-module tasks of a stage are started most
+// expensive first, so the stage is not held up by a large module which happened to be started last
+gb_internal void lb_add_module_task(WorkerTaskProc *proc, void *data, i64 cost) {
+	if (build_context.internal_schedule_by_cost) {
+		thread_pool_add_task_with_cost(proc, data, cost);
+	} else {
+		thread_pool_add_task(proc, data);
+	}
+}
+
+gb_internal i64 lb_count_instructions(LLVMValueRef fn) {
+	i64 count = 0;
+	for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(fn); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+		for (LLVMValueRef instr = LLVMGetFirstInstruction(block); instr != nullptr; instr = LLVMGetNextInstruction(instr)) {
+			count += 1;
+		}
+	}
+	return count;
+}
+
 gb_internal WORKER_TASK_PROC(lb_generate_procedures_and_types_per_module) {
 	lbModule *m = cast(lbModule *)data;
+	TRACE_SCOPE("create procedures and types", make_string_c(m->module_name));
 	for (Entity *e : m->global_types_to_create) {
 		(void)lb_get_entity_name(m, e);
 		(void)lb_type(m, e->type);
@@ -2329,12 +2351,20 @@ gb_internal void lb_create_global_procedures_and_types(lbGenerator *gen, Checker
 		lbModule *m = entry.value;
 		array_sort(m->global_types_to_create, llvm_global_entity_cmp);
 		array_sort(m->global_procedures_to_create, llvm_global_entity_cmp);
+
+		if (build_context.internal_schedule_by_cost) {
+			i64 cost = m->global_types_to_create.count;
+			for (Entity *e : m->global_procedures_to_create) {
+				cost += gb_max(lb_estimate_procedure_cost(e), 256);
+			}
+			m->source_cost = cost;
+		}
 	}
 
 	if (do_threading) {
 		for (auto const &entry : gen->modules) {
 			lbModule *m = entry.value;
-			thread_pool_add_task(lb_generate_procedures_and_types_per_module, m);
+			lb_add_module_task(lb_generate_procedures_and_types_per_module, m, m->source_cost);
 		}
 	} else {
 		for (auto const &entry : gen->modules) {
@@ -2381,12 +2411,162 @@ struct lbLLVMEmitWorker {
 	lbModule *m;
 };
 
+gb_internal bool lb_use_split_dwarf(LLVMCodeGenFileType code_gen_file_type) {
+	// NOTE: with -print-linker-flags the clang invocation would only be printed and no object produced
+	return build_context.split_dwarf &&
+	       !build_context.print_linker_flags &&
+	       code_gen_file_type == LLVMObjectFile;
+}
+
+gb_internal String lb_filepath_dwo_for_object(String const &filepath_obj) {
+	return concatenate_strings(permanent_allocator(), remove_extension_from_path(filepath_obj), str_lit(".dwo"));
+}
+
+gb_internal String lb_filepath_split_dwarf_bc_for_object(String const &filepath_obj) {
+	return concatenate_strings(permanent_allocator(), remove_extension_from_path(filepath_obj), str_lit("-split-dwarf.bc"));
+}
+
+// NOTE: the LLVM-C API cannot set the split DWARF file of a target machine, so with -split-dwarf the module
+// is written out as bitcode and clang does the code generation of it (without running any IR passes again).
+// The debug information ends up in a `.dwo` file next to the object and only the skeleton compile unit,
+// the line tables and the address ranges stay in the object, so the linker has far less to relocate and copy
+gb_internal bool lb_emit_split_dwarf_object(lbModule *m, String const &filepath_obj) {
+	String filepath_bc = lb_filepath_split_dwarf_bc_for_object(filepath_obj);
+	if (LLVMWriteBitcodeToFile(m->mod, cast(char *)filepath_bc.text)) {
+		gb_printf_err("Failed to write bitcode file: %.*s\n", LIT(filepath_bc));
+		return false;
+	}
+
+	char *triple   = LLVMGetTargetMachineTriple(m->target_machine);
+	char *cpu      = LLVMGetTargetMachineCPU(m->target_machine);
+	char *features = LLVMGetTargetMachineFeatureString(m->target_machine);
+	defer (LLVMDisposeMessage(triple));
+	defer (LLVMDisposeMessage(cpu));
+	defer (LLVMDisposeMessage(features));
+
+	char const *clang_path = gb_get_env("ODIN_CLANG_PATH", permanent_allocator());
+	if (clang_path == nullptr) {
+		clang_path = "clang";
+	}
+
+	char const *opt_level = "-O0";
+	switch (build_context.optimization_level) {
+	case 1: opt_level = "-O1"; break;
+	case 2: opt_level = "-O2"; break;
+	case 3: opt_level = "-O3"; break;
+	}
+
+	gbString args = gb_string_make(heap_allocator(), "");
+	defer (gb_string_free(args));
+
+	if (*cpu) {
+		args = gb_string_append_fmt(args, " -Xclang -target-cpu -Xclang %s", cpu);
+	}
+	String_Iterator it = {make_string_c(features), 0};
+	for (;;) {
+		String feature = string_split_iterator(&it, ',');
+		if (feature == "") break;
+		args = gb_string_append_fmt(args, " -Xclang -target-feature -Xclang %.*s", LIT(feature));
+	}
+	args = gb_string_appendc(args, get_reloc_mode() == LLVMRelocPIC ? " -fPIC" : " -fno-pic");
+
+	i32 result = system_exec_command_line_app("clang-split-dwarf",
+		"%s -c -x ir \"%.*s\" -o \"%.*s\" "
+		"-target %s %s%s "
+		"-g -gsplit-dwarf -Xclang -disable-llvm-passes -Wno-override-module -Wno-unused-command-line-argument",
+		clang_path,
+		LIT(filepath_bc),
+		LIT(filepath_obj),
+		triple, opt_level, args
+	);
+	if (result) {
+		gb_printf_err("Failed to generate the split DWARF object file: %.*s\n", LIT(filepath_obj));
+		return false;
+	}
+	return true;
+}
+
+gb_internal bool lb_use_object_cache(LLVMCodeGenFileType code_gen_file_type) {
+	return build_context.object_cache &&
+	       build_context.lto_kind == LTO_None &&
+	       code_gen_file_type == LLVMObjectFile;
+}
+
+gb_internal Hash128 lb_object_cache_hash_module(lbModule *m, LLVMCodeGenFileType code_gen_file_type, String const &filepath_obj) {
+	char *triple   = LLVMGetTargetMachineTriple(m->target_machine);
+	char *cpu      = LLVMGetTargetMachineCPU(m->target_machine);
+	char *features = LLVMGetTargetMachineFeatureString(m->target_machine);
+	defer (LLVMDisposeMessage(triple));
+	defer (LLVMDisposeMessage(cpu));
+	defer (LLVMDisposeMessage(features));
+
+	// NOTE: everything which is passed to the target machine but is not stored in the module itself
+	gbString key = gb_string_make(heap_allocator(), "");
+	defer (gb_string_free(key));
+	key = gb_string_append_fmt(key, "%s|%s|%s|%s|%d|%d|%d|%d|%d",
+		LLVM_VERSION_STRING, triple, cpu, features,
+		build_context.optimization_level,
+		cast(int)get_reloc_mode(),
+		cast(int)build_context.fast_isel,
+		cast(int)code_gen_file_type,
+		cast(int)lb_use_split_dwarf(code_gen_file_type));
+	if (lb_use_split_dwarf(code_gen_file_type)) {
+		// NOTE: clang names the `.dwo` file in the skeleton unit after the `-o` path, so the object
+		// is only valid at the path it was emitted to
+		key = gb_string_append_fmt(key, "|%.*s", LIT(filepath_obj));
+	}
+
+	Hash128 key_hash = hash128(key, gb_string_length(key));
+
+	LLVMMemoryBufferRef bitcode = LLVMWriteBitcodeToMemoryBuffer(m->mod);
+	Hash128 hash = hash128(LLVMGetBufferStart(bitcode), cast(isize)LLVMGetBufferSize(bitcode), key_hash.lo);
+	LLVMDisposeMemoryBuffer(bitcode);
+
+	hash.hi ^= key_hash.hi;
+	return hash;
+}
+
+// returns true if the object file was restored from the object cache and does not need to be emitted,
+// otherwise `cache_path_` is set to where the emitted object file must be stored afterwards
+gb_internal bool lb_object_cache_lookup(lbModule *m, LLVMCodeGenFileType code_gen_file_type, String const &filepath_obj, String *cache_path_) {
+	*cache_path_ = {};
+	if (!lb_use_object_cache(code_gen_file_type)) {
+		return false;
+	}
+
+	Hash128 hash = lb_object_cache_hash_module(m, code_gen_file_type, filepath_obj);
+	String cache_path = object_cache_path_for_hash(hash);
+	if (lb_use_split_dwarf(code_gen_file_type)) {
+		// NOTE: the object is only useful along with its `.dwo` file, so both must be restored
+		String cache_path_dwo = lb_filepath_dwo_for_object(cache_path);
+		if (!object_cache_try_restore(cache_path_dwo, lb_filepath_dwo_for_object(filepath_obj))) {
+			build_context.build_cache_data.object_cache_misses.fetch_add(1, std::memory_order_relaxed);
+			*cache_path_ = cache_path;
+			return false;
+		}
+	}
+	if (object_cache_try_restore(cache_path, filepath_obj)) {
+		build_context.build_cache_data.object_cache_hits.fetch_add(1, std::memory_order_relaxed);
+		debugf("Object Cache: hit %.*s -> %.*s\n", LIT(cache_path), LIT(filepath_obj));
+		return true;
+	}
+	build_context.build_cache_data.object_cache_misses.fetch_add(1, std::memory_order_relaxed);
+	*cache_path_ = cache_path;
+	return false;
+}
+
 gb_internal WORKER_TASK_PROC(lb_llvm_emit_worker_proc) {
 	GB_ASSERT(MULTITHREAD_OBJECT_GENERATION);
 
 	char *llvm_error = nullptr;
 
 	auto wd = cast(lbLLVMEmitWorker *)data;
+	TRACE_SCOPE("emit object", make_string_c(wd->m->module_name));
+
+	String cache_path = {};
+	if (lb_object_cache_lookup(wd->m, wd->code_gen_file_type, wd->filepath_obj, &cache_path)) {
+		return 0;
+	}
 
 	if (build_context.lto_kind != LTO_None) {
 		if (LLVMWriteBitcodeToFile(wd->m->mod, cast(char *)wd->filepath_obj.text)) {
@@ -2394,12 +2574,24 @@ gb_internal WORKER_TASK_PROC(lb_llvm_emit_worker_proc) {
 			lb_record_worker_failure();
 			return 1;
 		}
+	} else if (lb_use_split_dwarf(wd->code_gen_file_type)) {
+		if (!lb_emit_split_dwarf_object(wd->m, wd->filepath_obj)) {
+			lb_record_worker_failure();
+			return 1;
+		}
 	} else if (LLVMTargetMachineEmitToFile(wd->target_machine, wd->m->mod, cast(char *)wd->filepath_obj.text, wd->code_gen_file_type, &llvm_error)) {
 		gb_printf_err("LLVM Error: %s\n", llvm_error);
 		lb_record_worker_failure();
 		return 1;
 	}
 	debugf("Generated File: %.*s\n", LIT(wd->filepath_obj));
+
+	if (cache_path.len != 0) {
+		if (lb_use_split_dwarf(wd->code_gen_file_type)) {
+			object_cache_store(lb_filepath_dwo_for_object(wd->filepath_obj), lb_filepath_dwo_for_object(cache_path));
+		}
+		object_cache_store(wd->filepath_obj, cache_path);
+	}
 	return 0;
 }
 
@@ -2411,6 +2603,7 @@ gb_internal void lb_llvm_function_pass_per_function_internal(lbModule *module, l
 
 gb_internal WORKER_TASK_PROC(lb_llvm_function_pass_per_module) {
 	lbModule *m = cast(lbModule *)data;
+	TRACE_SCOPE("function passes", make_string_c(m->module_name));
 	{
 		GB_ASSERT(m->function_pass_managers[lbFunctionPassManager_default] == nullptr);
 
@@ -2488,6 +2681,7 @@ struct lbLLVMModulePassWorkerData {
 
 gb_internal WORKER_TASK_PROC(lb_llvm_module_pass_worker_proc) {
 	auto wd = cast(lbLLVMModulePassWorkerData *)data;
+	TRACE_SCOPE("module passes", make_string_c(wd->m->module_name));
 
 	LLVMPassManagerRef module_pass_manager = LLVMCreatePassManager();
 	LLVMRunPassManager(module_pass_manager, wd->m->mod);
@@ -2498,8 +2692,23 @@ gb_internal WORKER_TASK_PROC(lb_llvm_module_pass_worker_proc) {
 	LLVMPassBuilderOptionsRef pb_options = LLVMCreatePassBuilderOptions();
 	defer (LLVMDisposePassBuilderOptions(pb_options));
 
+	// NOTE: PGO instrumentation and profile annotation run before the optimization
+	// pipeline so that both see the same unoptimized CFG; the profile matches
+	// functions by name and CFG hash, so the generate and use builds must agree.
+	if (build_context.pgo_generate) {
+		array_add(&passes, "pgo-instr-gen");
+		array_add(&passes, "instrprof");
+	} else if (build_context.pgo_use_path.len != 0) {
+		array_add(&passes, "pgo-instr-use");
+		array_add(&passes, "pgo-icall-prom");
+	}
+
 	#include "llvm_backend_passes.cpp"
 
+	if (build_context.pgo_use_path.len != 0 && build_context.optimization_level >= 1) {
+		array_add(&passes, "hotcoldsplit");
+	}
+
 	// asan - Linux, Darwin, Windows
 	// msan - linux
 	// tsan - Linux, Darwin
@@ -2585,6 +2794,7 @@ gb_internal WORKER_TASK_PROC(lb_llvm_module_pass_worker_proc) {
 
 gb_internal WORKER_TASK_PROC(lb_generate_procedures_worker_proc) {
 	lbModule *m = cast(lbModule *)data;
+	TRACE_SCOPE("generate procedures", make_string_c(m->module_name));
 	for (lbProcedure *p = nullptr; mpsc_dequeue(&m->procedures_to_generate, &p); /**/) {
 		lb_generate_procedure(p->module, p);
 	}
@@ -2595,7 +2805,7 @@ gb_internal void lb_generate_procedures(lbGenerator *gen, bool do_threading) {
 	if (do_threading) {
 		for (auto const &entry : gen->modules) {
 			lbModule *m = entry.value;
-			thread_pool_add_task(lb_generate_procedures_worker_proc, m);
+			lb_add_module_task(lb_generate_procedures_worker_proc, m, m->source_cost);
 		}
 
 		thread_pool_wait();
@@ -2611,6 +2821,7 @@ gb_internal void lb_generate_procedures(lbGenerator *gen, bool do_threading) {
 
 gb_internal WORKER_TASK_PROC(lb_generate_missing_procedures_to_check_worker_proc) {
 	lbModule *m = cast(lbModule *)data;
+	TRACE_SCOPE("generate missing procedures", make_string_c(m->module_name));
 	for (lbProcedure *p = nullptr; mpsc_dequeue(&m->missing_procedures_to_check, &p); /**/) {
 		if (!p->is_done.load(std::memory_order_relaxed)) {
 			debugf("Generate missing procedure: %.*s module %p\n", LIT(p->name), m);
@@ -2670,7 +2881,7 @@ gb_internal void lb_llvm_function_passes(lbGenerator *gen, bool do_threading) {
 	if (do_threading) {
 		for (auto const &entry : gen->modules) {
 			lbModule *m = entry.value;
-			thread_pool_add_task(lb_llvm_function_pass_per_module, m);
+			lb_add_module_task(lb_llvm_function_pass_per_module, m, m->codegen_cost.load(std::memory_order_relaxed));
 		}
 		thread_pool_wait();
 	} else {
@@ -2693,7 +2904,7 @@ gb_internal void lb_llvm_module_passes_and_verification(lbGenerator *gen, bool d
 			wd->target_machine = m->target_machine;
 			wd->do_threading = true;
 
-			thread_pool_add_task(lb_llvm_module_pass_worker_proc, wd);
+			lb_add_module_task(lb_llvm_module_pass_worker_proc, wd, m->codegen_cost.load(std::memory_order_relaxed));
 		}
 		thread_pool_wait();
 	} else {
@@ -2738,7 +2949,9 @@ gb_internal String lb_filepath_obj_for_module(lbModule *m) {
 	String name = build_context.build_paths[BuildPath_Output].name;
 
 	bool use_temporary_directory = false;
-	if (USE_SEPARATE_MODULES && build_context.build_mode == BuildMode_Executable) {
+	// NOTE: with -split-dwarf the objects stay next to the output, as the `.dwo` files written beside them
+	// are still needed by the debugger after linking
+	if (USE_SEPARATE_MODULES && build_context.build_mode == BuildMode_Executable && !build_context.split_dwarf) {
 		// NOTE(bill): use a temporary directory
 		String dir = temporary_directory(permanent_allocator());
 		if (dir.len != 0) {
@@ -2817,6 +3030,10 @@ gb_internal bool lb_llvm_object_generation(lbGenerator *gen, bool do_threading)
 	char *llvm_error = nullptr;
 	defer (LLVMDisposeMessage(llvm_error));
 
+	if (lb_use_object_cache(code_gen_file_type)) {
+		object_cache_init_directory();
+	}
+
 	if (do_threading) {
 		for (auto const &entry : gen->modules) {
 			lbModule *m = entry.value;
@@ -2828,13 +3045,16 @@ gb_internal bool lb_llvm_object_generation(lbGenerator *gen, bool do_threading)
 			String filepath_obj = lb_filepath_obj_for_module(m);
 			array_add(&gen->output_object_paths, filepath_obj);
 			array_add(&gen->output_temp_paths, filepath_ll);
+			if (lb_use_split_dwarf(code_gen_file_type)) {
+				array_add(&gen->output_temp_paths, lb_filepath_split_dwarf_bc_for_object(filepath_obj));
+			}
 
 			auto *wd = permanent_alloc_item<lbLLVMEmitWorker>();
 			wd->target_machine = m->target_machine;
 			wd->code_gen_file_type = code_gen_file_type;
 			wd->filepath_obj = filepath_obj;
 			wd->m = m;
-			thread_pool_add_task(lb_llvm_emit_worker_proc, wd);
+			lb_add_module_task(lb_llvm_emit_worker_proc, wd, m->codegen_cost.load(std::memory_order_relaxed));
 		}
 
 		thread_pool_wait(&global_thread_pool);
@@ -2848,6 +3068,9 @@ gb_internal bool lb_llvm_object_generation(lbGenerator *gen, bool do_threading)
 
 			String filepath_obj = lb_filepath_obj_for_module(m);
 			array_add(&gen->output_object_paths, filepath_obj);
+			if (lb_use_split_dwarf(code_gen_file_type)) {
+				array_add(&gen->output_temp_paths, lb_filepath_split_dwarf_bc_for_object(filepath_obj));
+			}
 
 			String short_name = remove_directory_from_path(filepath_obj);
 			gbString section_name = gb_string_make(permanent_allocator(), "LLVM Generate Object: ");
@@ -2855,24 +3078,146 @@ gb_internal bool lb_llvm_object_generation(lbGenerator *gen, bool do_threading)
 
 			TIME_SECTION_WITH_LEN(section_name, gb_string_length(section_name));
 
+			String cache_path = {};
+			if (lb_object_cache_lookup(m, code_gen_file_type, filepath_obj, &cache_path)) {
+				continue;
+			}
+
 			if (build_context.lto_kind != LTO_None) {
 				if (LLVMWriteBitcodeToFile(m->mod, cast(char *)filepath_obj.text)) {
 					gb_printf_err("Failed to write bitcode file: %.*s\n", LIT(filepath_obj));
 					exit_with_errors();
 					return false;
 				}
+			} else if (lb_use_split_dwarf(code_gen_file_type)) {
+				if (!lb_emit_split_dwarf_object(m, filepath_obj)) {
+					exit_with_errors();
+					return false;
+				}
 			} else if (LLVMTargetMachineEmitToFile(m->target_machine, m->mod, cast(char *)filepath_obj.text, code_gen_file_type, &llvm_error)) {
 				gb_printf_err("LLVM Error: %s\n", llvm_error);
 				exit_with_errors();
 				return false;
 			}
 			debugf("Generated File: %.*s\n", LIT(filepath_obj));
+
+			if (cache_path.len != 0) {
+				if (lb_use_split_dwarf(code_gen_file_type)) {
+					object_cache_store(lb_filepath_dwo_for_object(filepath_obj), lb_filepath_dwo_for_object(cache_path));
+				}
+				object_cache_store(filepath_obj, cache_path);
+			}
 		}
 	}
+
+	if (lb_use_object_cache(code_gen_file_type)) {
+		object_cache_prune();
+	}
 	return true;
 }
 
 
+// NOTE: each payload is written out to a temporary file and pulled into its section with `.incbin` from module level
+// assembly, so the bytes are never turned into LLVM constants; the module has no other contents
+gb_internal bool lb_emit_load_sections_object(lbGenerator *gen) {
+	if (gen->load_sections.count == 0) {
+		return true;
+	}
+
+	String filepath_obj = lb_filepath_obj_for_module(&gen->default_module);
+	filepath_obj = concatenate4_strings(permanent_allocator(),
+		remove_extension_from_path(filepath_obj),
+		str_lit("-load_sections"),
+		str_lit("."),
+		infer_object_extension_from_build_context()
+	);
+
+	bool is_darwin  = build_context.metrics.os == TargetOs_darwin;
+	bool is_windows = build_context.metrics.os == TargetOs_windows;
+	char const *symbol_prefix = "";
+	if (is_darwin || (is_windows && build_context.metrics.arch == TargetArch_i386)) {
+		symbol_prefix = "_";
+	}
+
+	gbString code = gb_string_make(heap_allocator(), "");
+	defer (gb_string_free(code));
+
+	for (auto const &entry : gen->load_sections) {
+		lbLoadSection *section = entry.value;
+
+		String filepath_bin = concatenate4_strings(permanent_allocator(),
+			remove_extension_from_path(filepath_obj),
+			str_lit("-"),
+			section->symbol_name,
+			str_lit(".bin")
+		);
+		gbFile f = {};
+		if (gb_file_create(&f, cast(char const *)filepath_bin.text) != gbFileError_None ||
+		    !gb_file_write(&f, section->data.text, section->data.len)) {
+			gb_printf_err("Failed to write load section data: %.*s\n", LIT(filepath_bin));
+			exit_with_errors();
+			return false;
+		}
+		gb_file_close(&f);
+		array_add(&gen->output_temp_paths, filepath_bin);
+
+		if (is_darwin) {
+			code = gb_string_appendc(code, ".section __TEXT,__odin_load\n");
+		} else if (is_windows) {
+			code = gb_string_appendc(code, ".section .rdata$odin_load,\"dr\"\n");
+		} else {
+			code = gb_string_appendc(code, ".section .rodata.odin_load,\"a\"\n");
+		}
+
+		String name = section->symbol_name;
+		code = gb_string_append_fmt(code, ".globl %s%.*s\n", symbol_prefix, LIT(name));
+		if (is_darwin) {
+			code = gb_string_append_fmt(code, ".private_extern %s%.*s\n", symbol_prefix, LIT(name));
+		} else if (!is_windows) {
+			code = gb_string_append_fmt(code, ".hidden %.*s\n", LIT(name));
+			code = gb_string_append_fmt(code, ".type %.*s,%%object\n", LIT(name));
+			code = gb_string_append_fmt(code, ".size %.*s,%td\n", LIT(name), section->data.len+1);
+		}
+		code = gb_string_append_fmt(code, ".balign %lld\n", cast(long long)section->alignment);
+		code = gb_string_append_fmt(code, "%s%.*s:\n", symbol_prefix, LIT(name));
+		code = gb_string_appendc(code, ".incbin \"");
+		for (isize i = 0; i < filepath_bin.len; i++) {
+			u8 c = filepath_bin[i];
+			if (c == '\\' || c == '"') {
+				code = gb_string_appendc(code, "\\");
+			}
+			code = gb_string_append_length(code, &c, 1);
+		}
+		code = gb_string_appendc(code, "\"\n");
+		// NOTE: the NUL terminator which `LLVMConstStringInContext` would have added
+		code = gb_string_appendc(code, ".byte 0\n");
+	}
+
+	lbModule *dm = &gen->default_module;
+	LLVMContextRef ctx = LLVMContextCreate();
+	LLVMModuleRef mod = LLVMModuleCreateWithNameInContext("odin_load_sections", ctx);
+	LLVMSetTarget(mod, LLVMGetTarget(dm->mod));
+	LLVMSetDataLayout(mod, LLVMGetDataLayoutStr(dm->mod));
+	LLVMSetModuleInlineAsm2(mod, code, gb_string_length(code));
+
+	char *llvm_error = nullptr;
+	bool ok = !LLVMTargetMachineEmitToFile(dm->target_machine, mod, cast(char *)filepath_obj.text, LLVMObjectFile, &llvm_error);
+	if (!ok) {
+		gb_printf_err("LLVM Error: %s\n", llvm_error);
+		LLVMDisposeMessage(llvm_error);
+	}
+	LLVMDisposeModule(mod);
+	LLVMContextDispose(ctx);
+	if (!ok) {
+		exit_with_errors();
+		return false;
+	}
+	debugf("Generated File: %.*s\n", LIT(filepath_obj));
+
+	array_add(&gen->output_object_paths, filepath_obj);
+	return true;
+}
+
 
 gb_internal lbProcedure *lb_create_main_procedure(lbModule *m, lbProcedure *startup_runtime, lbProcedure *cleanup_runtime) {
 	LLVMPassManagerRef default_function_pass_manager = LLVMCreateFunctionPassManagerForModule(m->mod);
@@ -3063,6 +3408,10 @@ gb_internal void lb_generate_procedure(lbModule *m, lbProcedure *p) {
 
 	lb_verify_function(m, p, true);
 
+	if (build_context.internal_schedule_by_cost && p->value != nullptr) {
+		m->codegen_cost.fetch_add(lb_count_instructions(p->value), std::memory_order_relaxed);
+	}
+
 	MUTEX_GUARD(&m->generated_procedures_mutex);
 	array_add(&m->generated_procedures, p);
 }
@@ -3132,6 +3481,16 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		LLVMInitializeNativeTarget();
 	}
 
+	if (build_context.pgo_use_path.len != 0) {
+		// NOTE: the C API has no way to pass the profile to `pgo-instr-use`,
+		// so it is set through the option the pass reads by default
+		char const *pgo_args[2] = {
+			"odin",
+			alloc_cstring(permanent_allocator(), concatenate_strings(permanent_allocator(), str_lit("-pgo-test-profile-file="), build_context.pgo_use_path)),
+		};
+		LLVMParseCommandLineOptions(gb_count_of(pgo_args), pgo_args, nullptr);
+	}
+
 	char const *target_triple = alloc_cstring(permanent_allocator(), build_context.metrics.target_triplet);
 	for (auto const &entry : gen->modules) {
 		LLVMSetTarget(entry.value->mod, target_triple);
@@ -3261,7 +3620,7 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 				producer, gb_string_length(producer),
 				is_optimized, "", 0,
 				1, split_name, gb_string_length(split_name),
-				LLVMDWARFEmissionFull,
+				lb_debug_line_tables_only() ? LLVMDWARFEmissionLineTablesOnly : LLVMDWARFEmissionFull,
 				0, split_debug_inlining,
 				debug_info_for_profiling,
 				"", 0, // sys_root
@@ -3493,7 +3852,7 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 
 		if (m->debug_builder) {
 			String global_name = e->token.string;
-			if (global_name.len != 0 && global_name != "_") {
+			if (global_name.len != 0 && global_name != "_" && !lb_debug_skip_variable()) {
 				LLVMMetadataRef llvm_file = lb_get_llvm_metadata(m, e->file);
 				LLVMMetadataRef llvm_scope = llvm_file;
 
@@ -3780,6 +4139,13 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		return false;
 	}
 
+	if (gen->load_sections.count != 0) {
+		TIME_SECTION("LLVM Load Sections Object");
+		if (!lb_emit_load_sections_object(gen)) {
+			return false;
+		}
+	}
+
 
 	if (build_context.sanitizer_flags & SanitizerFlag_Address) {
 		switch (build_context.metrics.os) {
@@ -3827,6 +4193,25 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		}
 	}
 
+	if (build_context.pgo_generate) {
+		switch (build_context.metrics.os) {
+		case TargetOs_windows: {
+			auto paths = array_make<String>(heap_allocator(), 0, 1);
+			String path = concatenate_strings(permanent_allocator(), build_context.ODIN_ROOT, str_lit("\\bin\\llvm\\windows\\clang_rt.profile-x86_64.lib"));
+			array_add(&paths, path);
+			Entity *lib = alloc_entity_library_name(nullptr, make_token_ident("profile_lib"), nullptr, slice_from_array(paths), str_lit("profile_lib"));
+			array_add(&gen->foreign_libraries, lib);
+		} break;
+		default:
+			if (!build_context.extra_linker_flags.text) {
+				build_context.extra_linker_flags = str_lit("-fprofile-generate");
+			} else {
+				build_context.extra_linker_flags = concatenate_strings(permanent_allocator(), build_context.extra_linker_flags, str_lit(" -fprofile-generate"));
+			}
+			break;
+		}
+	}
+
 	array_sort(gen->foreign_libraries, foreign_library_cmp);
 
 	return true;
@@ -15,6 +15,7 @@
 #include <llvm-c/Object.h>
 #include <llvm-c/BitWriter.h>
 #include <llvm-c/DebugInfo.h>
+#include <llvm-c/Support.h>
 #include <llvm-c/Transforms/PassBuilder.h>
 
 
@@ -122,6 +123,7 @@ struct lbModule {
 	CheckerInfo *info;
 	AstPackage *pkg; // possibly associated
 	AstFile *file;   // possibly associated
+	i32 partition;   // non-zero for the extra codegen units of a package split by `lb_partition_package_procedures`
 	char const *module_name;
 
 	PtrMap<u64/*type hash*/, LLVMTypeRef>  types;                  // mutex: types_mutex
@@ -157,6 +159,11 @@ struct lbModule {
 	BlockingMutex generated_procedures_mutex;
 	Array<lbProcedure *> generated_procedures;
 
+	// Estimates of how much work each stage is for this module, used to order the stages' tasks
+	// with `-internal-schedule-by-cost` (see `lb_add_module_task`)
+	i64              source_cost;  // of the procedures to generate, from their size in the source
+	std::atomic<i64> codegen_cost; // of the generated IR, from its instruction count
+
 	lbProcedure *curr_procedure;
 
 	LLVMBuilderRef const_dummy_builder;
@@ -177,6 +184,7 @@ struct lbModule {
 	PtrMap<u64/*type hash*/, lbAddr> map_info_map;      // address of runtime.Map_Cell_Info
 
 	PtrMap<Ast *, lbAddr> exact_value_compound_literal_addr_map; // Key: Ast_CompoundLit
+	PtrMap<Ast *, struct lbConstantMap *> constant_maps; // Key: Ast_CompoundLit
 
 	LLVMPassManagerRef function_pass_managers[lbFunctionPassManager_COUNT];
 
@@ -184,6 +192,27 @@ struct lbModule {
 	Array<lbPadType> pad_types;
 };
 
+// NOTE: a large constant byte payload (in practice `#load` data), stored once per distinct content in a read-only
+// section of a side object file rather than as LLVM constant data, see `lb_find_or_add_load_section`
+struct lbLoadSection {
+	String  data;
+	Hash128 hash;
+	i64     alignment;
+	String  symbol_name;
+};
+
+// NOTE: the read-only table of a constant `map` literal, laid out by a minimal perfect hash built at compile time
+// (hash and displace): the key `k` with hash `h` lives at slot `mix(h ~ displacements[h % bucket_count]) % count`,
+// see `lb_constant_map_slot`
+struct lbConstantMap {
+	isize        count;
+	isize        bucket_count;
+	u64          seed;          // passed to the key's hasher
+	LLVMValueRef keys;          // [count]K, in slot order
+	LLVMValueRef values;        // [count]V, in slot order
+	LLVMValueRef displacements; // [bucket_count]u32
+};
+
 struct lbEntityCorrection {
 	lbModule *  other_module;
 	Entity *    e;
@@ -218,9 +247,22 @@ struct lbGenerator : LinkerData {
 	MPSCQueue<lbObjCGlobal> objc_classes;
 	MPSCQueue<lbObjCGlobal> objc_ivars;
 	MPSCQueue<String> raddebug_section_strings;
+
+	BlockingMutex                 load_sections_mutex;
+	PtrMap<u64, lbLoadSection *> load_sections; // multi-map, the key is `Hash128.lo` of the data
 };
 
 
+// NOTE: reported by -show-timings for -debug builds
+struct lbDebugInfoStats {
+	std::atomic<isize> types;             // type descriptors created
+	std::atomic<isize> variables;         // local, parameter and global variable descriptors created
+	std::atomic<isize> skipped_variables; // variable descriptors left out with -debug:line-tables
+};
+
+gb_global lbDebugInfoStats lb_debug_info_stats;
+
+
 struct lbBlock {
 	LLVMBasicBlockRef block;
 	Scope *scope;
@@ -376,6 +418,8 @@ struct lbProcedure {
 	Array<lbValue> asan_stack_locals;
 
 	void (*generate_body)(lbModule *m, lbProcedure *p);
+	String target_clone;                // @(target_clones) feature set of this body, e.g. "avx2+fma"
+	Array<lbProcedure *> target_clones; // bodies dispatched to, in order of preference
 	Array<lbGlobalVariable> *global_variables;
 	lbProcedure *objc_names;
 
@@ -398,7 +442,7 @@ gb_internal LLVMAttributeRef lb_create_enum_attribute_with_type(LLVMContextRef c
 gb_internal void lb_add_proc_attribute_at_index(lbProcedure *p, isize index, char const *name, u64 value);
 gb_internal void lb_add_proc_attribute_at_index(lbProcedure *p, isize index, char const *name);
 gb_internal void lb_add_nocapture_proc_attribute_at_index(lbProcedure *p, isize index);
-gb_internal lbProcedure *lb_create_procedure(lbModule *module, Entity *entity, bool ignore_body=false);
+gb_internal lbProcedure *lb_create_procedure(lbModule *module, Entity *entity, bool ignore_body=false, String target_clone={});
 
 
 gb_internal LLVMTypeRef lb_type(lbModule *m, Type *type);
@@ -477,6 +521,7 @@ gb_internal lbValue lb_build_call_expr(lbProcedure *p, Ast *expr, lbValue *sret_
 gb_internal lbProcedure *lb_create_dummy_procedure(lbModule *m, String link_name, Type *type);
 gb_internal void lb_begin_procedure_body(lbProcedure *p);
 gb_internal void lb_end_procedure_body(lbProcedure *p);
+gb_internal void lb_generate_procedure(lbModule *m, lbProcedure *p);
 
 gb_internal lbAddr lb_find_or_generate_context_ptr(lbProcedure *p);
 gb_internal lbContextData *lb_push_context_onto_stack(lbProcedure *p, lbAddr ctx);
@@ -644,6 +689,9 @@ gb_internal u64 lb_get_metadata_custom_u64(lbModule *m, LLVMValueRef v_ref, Stri
 #define LB_TYPE_INFO_USINGS_NAME     "__$type_info_usings_data"
 #define LB_TYPE_INFO_TAGS_NAME       "__$type_info_tags_data"
 
+// NOTE: constant byte data at least this large is emitted through a load section, see `lbLoadSection`
+#define LB_LOAD_SECTION_THRESHOLD (64*1024)
+
 
 
 enum lbCallingConventionKind : unsigned {
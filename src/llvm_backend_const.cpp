@@ -57,7 +57,7 @@ gb_internal bool lb_is_expr_constant_zero(Ast *expr) {
 	GB_ASSERT(expr != nullptr);
 	auto v = exact_value_to_integer(expr->tav.value);
 	if (v.kind == ExactValue_Integer) {
-		return big_int_cmp_zero(&v.value_integer) == 0;
+		return exact_value_integer_is_zero(v);
 	}
 	return false;
 }
@@ -556,6 +556,19 @@ gb_internal LLVMValueRef lb_big_int_to_llvm(lbModule *m, Type *original_type, Bi
 	return value;
 }
 
+gb_internal LLVMValueRef lb_exact_value_integer_to_llvm(lbModule *m, Type *original_type, ExactValue const &v) {
+	GB_ASSERT(v.kind == ExactValue_Integer);
+	if (v.is_small_integer && is_type_endian_little(original_type)) {
+		LLVMTypeRef t = lb_type(m, original_type);
+		if (LLVMGetTypeKind(t) == LLVMIntegerTypeKind) {
+			// NOTE: sign extending matches the two's complement packing done by `lb_big_int_to_llvm`
+			return LLVMConstInt(t, cast(unsigned long long)v.value_small_integer, true);
+		}
+	}
+	BigInt i = exact_value_to_big_int(v);
+	return lb_big_int_to_llvm(m, original_type, &i);
+}
+
 gb_internal bool lb_is_nested_possibly_constant(Type *ft, Selection const &sel, Ast *elem) {
 	GB_ASSERT(!sel.indirect);
 	for (i32 index : sel.index) {
@@ -1038,7 +1051,8 @@ gb_internal lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, lb
 				}
 			} else {
 				u32 id = m->global_array_index.fetch_add(1);
-				gbString str = gb_string_make(temporary_allocator(), "csba$");
+				// NOTE: the name outlives any temporary memory, as the entity and `m->members` keep it
+				gbString str = gb_string_make(permanent_allocator(), "csba$");
 				str = gb_string_appendc(str, m->module_name);
 				str = gb_string_append_fmt(str, "$%x", id);
 
@@ -1261,10 +1275,10 @@ gb_internal lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, lb
 	case ExactValue_Integer:
 		if (is_type_pointer(type) || is_type_multi_pointer(type) || is_type_proc(type)) {
 			LLVMTypeRef t = lb_type(m, original_type);
-			LLVMValueRef i = lb_big_int_to_llvm(m, t_uintptr, &value.value_integer);
+			LLVMValueRef i = lb_exact_value_integer_to_llvm(m, t_uintptr, value);
 			res.value = LLVMConstIntToPtr(i, t);
 		} else {
-			res.value = lb_big_int_to_llvm(m, original_type, &value.value_integer);
+			res.value = lb_exact_value_integer_to_llvm(m, original_type, value);
 		}
 		return res;
 	case ExactValue_Float:
@@ -2157,7 +2171,7 @@ gb_internal lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, lb
 					continue;
 				}
 				GB_ASSERT(tav.value.kind == ExactValue_Integer);
-				i64 v = big_int_to_i64(&tav.value.value_integer);
+				i64 v = exact_value_to_i64(tav.value);
 				i64 lower = type->BitSet.lower;
 				u64 index = cast(u64)(v-lower);
 				BigInt bit = {};
@@ -2262,3 +2276,220 @@ gb_internal lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, lb
 
 	return lb_const_nil(m, original_type);
 }
+
+
+// NOTE: must match `runtime.default_hasher` and `runtime.default_hasher_string`, as the lookup hashes the key at runtime
+gb_internal u64 lb_constant_map_key_hash(Type *key_type, ExactValue const &key, u64 seed) {
+	u64 h = seed + 0xcbf29ce484222325ull;
+	if (is_type_string(key_type)) {
+		GB_ASSERT(key.kind == ExactValue_String);
+		String str = key.value_string;
+		for (isize i = 0; i < str.len; i++) {
+			h = (h ^ cast(u64)str.text[i]) * 0x100000001b3ull;
+		}
+	} else {
+		ExactValue v = exact_value_to_integer(key);
+		u64 bits = exact_value_integer_is_neg(v) ? cast(u64)exact_value_to_i64(v) : exact_value_to_u64(v);
+		i64 size = type_size_of(key_type);
+		bool big_endian = is_type_endian_big(key_type);
+		for (i64 i = 0; i < size; i++) {
+			i64 byte_index = big_endian ? size-1-i : i;
+			h = (h ^ ((bits >> (8*byte_index)) & 0xff)) * 0x100000001b3ull;
+		}
+	}
+	h &= (1ull << (8*build_context.metrics.ptr_size - 1)) - 1;
+	return h != 0 ? h : 1;
+}
+
+// NOTE: must match the `uintptr` arithmetic emitted by `lb_emit_constant_map_probe`
+gb_internal isize lb_constant_map_slot(u64 h, u64 displacement, isize count) {
+	u64 x = 0;
+	if (build_context.metrics.ptr_size == 4) {
+		u32 y = cast(u32)(h ^ displacement);
+		y *= 0x9e3779b9u;
+		y ^= y >> 16;
+		x = y;
+	} else {
+		x = h ^ displacement;
+		x *= 0x9e3779b97f4a7c15ull;
+		x ^= x >> 32;
+	}
+	return cast(isize)(x % cast(u64)count);
+}
+
+struct lbConstantMapBucket {
+	isize index;
+	isize offset; // into the keys grouped by bucket
+	isize count;
+};
+
+gb_internal int lb_constant_map_bucket_cmp(void const *a, void const *b) {
+	lbConstantMapBucket const *x = cast(lbConstantMapBucket const *)a;
+	lbConstantMapBucket const *y = cast(lbConstantMapBucket const *)b;
+	if (x->count != y->count) {
+		return x->count > y->count ? -1 : +1;
+	}
+	return x->index < y->index ? -1 : x->index > y->index;
+}
+
+// NOTE: hash and displace: the keys are grouped into buckets by hash, then each bucket, largest first, searches for the
+// smallest displacement which moves all of its keys into free slots
+gb_internal bool lb_constant_map_displace(Slice<u64> const &hashes, isize bucket_count, u32 *displacements, isize *slots) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	isize count = hashes.count;
+
+	auto buckets = array_make<lbConstantMapBucket>(temporary_allocator(), bucket_count);
+	for (isize b = 0; b < bucket_count; b++) {
+		buckets[b] = {b, 0, 0};
+		displacements[b] = 0;
+	}
+	for (u64 h : hashes) {
+		buckets[cast(isize)(h % cast(u64)bucket_count)].count += 1;
+	}
+	isize offset = 0;
+	for (lbConstantMapBucket &b : buckets) {
+		b.offset = offset;
+		offset += b.count;
+	}
+
+	auto members = array_make<isize>(temporary_allocator(), count);
+	auto filled  = array_make<isize>(temporary_allocator(), bucket_count);
+	auto taken   = array_make<bool>(temporary_allocator(), count);
+	auto chosen  = array_make<isize>(temporary_allocator(), count);
+	for (isize b = 0; b < bucket_count; b++) {
+		filled[b] = 0;
+	}
+	for (isize i = 0; i < count; i++) {
+		isize b = cast(isize)(hashes[i] % cast(u64)bucket_count);
+		members[buckets[b].offset + filled[b]++] = i;
+		taken[i] = false;
+	}
+
+	array_sort(buckets, lb_constant_map_bucket_cmp);
+
+	u64 max_displacement = gb_min(gb_max(cast(u64)count*16, 1024ull), 0xffffffffull);
+	for (lbConstantMapBucket const &b : buckets) {
+		if (b.count == 0) {
+			break;
+		}
+		bool placed = false;
+		for (u64 d = 0; d < max_displacement && !placed; d++) {
+			isize j = 0;
+			for (; j < b.count; j++) {
+				isize slot = lb_constant_map_slot(hashes[members[b.offset+j]], d, count);
+				if (taken[slot]) {
+					break;
+				}
+				isize k = 0;
+				while (k < j && chosen[k] != slot) {
+					k++;
+				}
+				if (k < j) {
+					break;
+				}
+				chosen[j] = slot;
+			}
+			if (j == b.count) {
+				for (j = 0; j < b.count; j++) {
+					taken[chosen[j]] = true;
+					slots[members[b.offset+j]] = chosen[j];
+				}
+				displacements[b.index] = cast(u32)d;
+				placed = true;
+			}
+		}
+		if (!placed) {
+			return false;
+		}
+	}
+	return true;
+}
+
+gb_internal LLVMValueRef lb_constant_map_global(lbModule *m, char const *prefix, LLVMValueRef data) {
+	u32 id = m->global_array_index.fetch_add(1);
+	gbString name = gb_string_make(temporary_allocator(), prefix);
+	name = gb_string_appendc(name, m->module_name);
+	name = gb_string_append_fmt(name, "$%x", id);
+
+	LLVMValueRef global_data = LLVMAddGlobal(m->mod, LLVMTypeOf(data), name);
+	LLVMSetInitializer(global_data, data);
+	lb_make_global_private_const(global_data);
+	return global_data;
+}
+
+// NOTE: returns nullptr for an empty map, as every lookup misses
+gb_internal lbConstantMap *lb_find_or_add_constant_map(lbModule *m, Type *map_type, ExactValue const &value) {
+	GB_ASSERT(value.kind == ExactValue_Compound);
+	Ast *compound = value.value_compound;
+	lbConstantMap **found = map_get(&m->constant_maps, compound);
+	if (found) {
+		return *found;
+	}
+
+	map_type = base_type(map_type);
+	GB_ASSERT(map_type->kind == Type_Map);
+	Type *key_type = map_type->Map.key;
+	Type *value_type = map_type->Map.value;
+
+	ast_node(cl, CompoundLit, compound);
+	isize count = cl->elems.count;
+	if (count == 0) {
+		map_set(&m->constant_maps, compound, cast(lbConstantMap *)nullptr);
+		return nullptr;
+	}
+
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	auto hashes = slice_make<u64>(temporary_allocator(), count);
+	auto slots = slice_make<isize>(temporary_allocator(), count);
+	u32 *displacements = nullptr;
+	isize bucket_count = 0;
+	u64 seed = 0;
+
+	// NOTE: the hasher seed is only changed if two keys happen to share a hash, which no displacement can separate
+	bool ok = false;
+	for (seed = 0; seed < 16 && !ok; seed++) {
+		for_array(i, cl->elems) {
+			ast_node(fv, FieldValue, cl->elems[i]);
+			hashes[i] = lb_constant_map_key_hash(key_type, fv->field->tav.value, seed);
+		}
+
+		isize const bucket_counts[3] = {(count+3)/4, (count+1)/2, count};
+		for (isize attempt = 0; attempt < gb_count_of(bucket_counts) && !ok; attempt++) {
+			bucket_count = bucket_counts[attempt];
+			displacements = gb_alloc_array(temporary_allocator(), u32, bucket_count);
+			ok = lb_constant_map_displace(hashes, bucket_count, displacements, slots.data);
+		}
+	}
+	seed -= 1;
+	if (!ok) {
+		error(compound, "Unable to build a perfect hash for the constant map literal");
+		map_set(&m->constant_maps, compound, cast(lbConstantMap *)nullptr);
+		return nullptr;
+	}
+
+	LLVMValueRef *keys   = gb_alloc_array(temporary_allocator(), LLVMValueRef, count);
+	LLVMValueRef *values = gb_alloc_array(temporary_allocator(), LLVMValueRef, count);
+	for_array(i, cl->elems) {
+		ast_node(fv, FieldValue, cl->elems[i]);
+		keys[slots[i]]   = lb_const_value(m, key_type,   fv->field->tav.value).value;
+		values[slots[i]] = lb_const_value(m, value_type, fv->value->tav.value).value;
+	}
+
+	LLVMValueRef *disps = gb_alloc_array(temporary_allocator(), LLVMValueRef, bucket_count);
+	for (isize i = 0; i < bucket_count; i++) {
+		disps[i] = LLVMConstInt(lb_type(m, t_u32), displacements[i], false);
+	}
+
+	lbConstantMap *cm = gb_alloc_item(permanent_allocator(), lbConstantMap);
+	cm->count         = count;
+	cm->bucket_count  = bucket_count;
+	cm->seed          = seed;
+	cm->keys          = lb_constant_map_global(m, "cmapk$", llvm_const_array(m, lb_type(m, key_type), keys, count));
+	cm->values        = lb_constant_map_global(m, "cmapv$", llvm_const_array(m, lb_type(m, value_type), values, count));
+	cm->displacements = lb_constant_map_global(m, "cmapd$", LLVMConstArray(lb_type(m, t_u32), disps, cast(unsigned)bucket_count));
+
+	map_set(&m->constant_maps, compound, cm);
+	return cm;
+}
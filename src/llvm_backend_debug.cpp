@@ -18,6 +18,19 @@ gb_internal void lb_set_llvm_metadata(lbModule *m, void *key, LLVMMetadataRef va
 	}
 }
 
+gb_internal bool lb_debug_line_tables_only(void) {
+	return build_context.debug_info_kind == DebugInfo_LineTables;
+}
+
+gb_internal bool lb_debug_skip_variable(void) {
+	if (lb_debug_line_tables_only()) {
+		lb_debug_info_stats.skipped_variables.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+	lb_debug_info_stats.variables.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
 gb_internal void lb_add_raddbg_string(lbModule *m, String const &str) {
 	mpsc_enqueue(&m->gen->raddebug_section_strings, copy_string(permanent_allocator(), str));
 }
@@ -1186,6 +1199,7 @@ gb_internal LLVMMetadataRef lb_debug_type(lbModule *m, Type *type) {
 
 	LLVMMetadataRef dt = lb_debug_type_internal(m, type);
 	lb_set_llvm_metadata(m, type, dt);
+	lb_debug_info_stats.types.fetch_add(1, std::memory_order_relaxed);
 	return dt;
 }
 
@@ -1232,6 +1246,9 @@ gb_internal void lb_add_debug_local_variable(lbProcedure *p, LLVMValueRef ptr, T
 	LLVMDIFlags flags = LLVMDIFlagZero;
 	LLVMBool always_preserve = build_context.optimization_level == 0;
 
+	if (lb_debug_skip_variable()) {
+		return;
+	}
 	LLVMMetadataRef debug_type = lb_debug_type(m, type);
 
 	LLVMMetadataRef var_info = LLVMDIBuilderCreateAutoVariable(
@@ -1297,6 +1314,9 @@ gb_internal void lb_add_debug_param_variable(lbProcedure *p, LLVMValueRef ptr, T
 	LLVMDIFlags flags = LLVMDIFlagZero;
 	LLVMBool always_preserve = build_context.optimization_level == 0;
 
+	if (lb_debug_skip_variable()) {
+		return;
+	}
 	LLVMMetadataRef debug_type = lb_debug_type(m, type);
 
 	LLVMMetadataRef var_info = LLVMDIBuilderCreateParameterVariable(
@@ -1394,6 +1414,9 @@ gb_internal void lb_add_debug_info_for_global_constant_from_entity(lbGenerator *
 	if (is_blank_ident(e->token)) {
 		return;
 	}
+	if (lb_debug_line_tables_only()) {
+		return;
+	}
 	lbModule *m = &gen->default_module;
 	if (USE_SEPARATE_MODULES) {
 		m = lb_module_of_entity(gen, e, m);
@@ -1406,7 +1429,7 @@ gb_internal void lb_add_debug_info_for_global_constant_from_entity(lbGenerator *
 			LLVMMetadataRef dtype = nullptr;
 			i64 v = 0;
 			bool is_signed = false;
-			if (big_int_is_neg(&value.value_integer)) {
+			if (exact_value_integer_is_neg(value)) {
 				v = exact_value_to_i64(value);
 				is_signed = true;
 			} else {
@@ -1440,7 +1463,7 @@ gb_internal void lb_add_debug_info_for_global_constant_from_entity(lbGenerator *
 		if (value.kind == ExactValue_Integer) {
 			LLVMMetadataRef dtype = lb_debug_type(m, default_type(e->type));
 			i64 v = 0;
-			if (big_int_is_neg(&value.value_integer)) {
+			if (exact_value_integer_is_neg(value)) {
 				v = exact_value_to_i64(value);
 			} else {
 				v = cast(i64)exact_value_to_u64(value);
@@ -1461,7 +1484,7 @@ gb_internal void lb_add_debug_info_for_global_constant_from_entity(lbGenerator *
 gb_internal void lb_add_debug_label(lbProcedure *p, Ast *label, lbBlock *target) {
 // NOTE(tf2spi): LLVM-C DILabel API used only existed for major versions 20+
 #if LLVM_VERSION_MAJOR >= 20
-	if (p == nullptr || p->debug_info == nullptr) {
+	if (p == nullptr || p->debug_info == nullptr || lb_debug_line_tables_only()) {
 		return;
 	}
 	if (target == nullptr || label == nullptr || label->kind != Ast_Label) {
@@ -2084,6 +2084,118 @@ gb_internal bool lb_is_empty_string_constant(Ast *expr) {
 	return false;
 }
 
+// NOTE: a branch-free probe of a constant map's perfect hash, the returned slot is always in range even for a missing key
+gb_internal lbValue lb_emit_constant_map_probe(lbProcedure *p, lbConstantMap *cm, Type *key_type, lbValue key, lbValue *slot_) {
+	lbModule *m = p->module;
+	LLVMTypeRef uintptr_type = lb_type(m, t_uintptr);
+
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	auto args = array_make<lbValue>(temporary_allocator(), 2);
+	args[0] = lb_emit_conv(p, lb_address_from_load_or_generate_local(p, key), t_rawptr);
+	args[1] = lb_const_int(m, t_uintptr, cm->seed);
+	lbValue h = lb_emit_call(p, lb_hasher_proc_for_type(m, key_type), args);
+
+	lbValue bucket = {};
+	bucket.value = LLVMBuildURem(p->builder, h.value, LLVMConstInt(uintptr_type, cm->bucket_count, false), "");
+	bucket.type = t_uintptr;
+
+	lbValue displacements = {cm->displacements, alloc_type_pointer(alloc_type_array(t_u32, cm->bucket_count))};
+	lbValue d = lb_emit_conv(p, lb_emit_load(p, lb_emit_array_ep(p, displacements, bucket)), t_uintptr);
+
+	// NOTE: must match `lb_constant_map_slot`
+	u64 multiplier = 0x9e3779b97f4a7c15ull;
+	u64 shift = 32;
+	if (build_context.metrics.ptr_size == 4) {
+		multiplier = 0x9e3779b9u;
+		shift = 16;
+	}
+	LLVMValueRef x = LLVMBuildXor(p->builder, h.value, d.value, "");
+	x = LLVMBuildMul(p->builder, x, LLVMConstInt(uintptr_type, multiplier, false), "");
+	x = LLVMBuildXor(p->builder, x, LLVMBuildLShr(p->builder, x, LLVMConstInt(uintptr_type, shift, false), ""), "");
+
+	lbValue slot = {};
+	slot.value = LLVMBuildURem(p->builder, x, LLVMConstInt(uintptr_type, cm->count, false), "");
+	slot.type = t_uintptr;
+
+	lbValue keys = {cm->keys, alloc_type_pointer(alloc_type_array(key_type, cm->count))};
+	lbValue stored = lb_emit_load(p, lb_emit_array_ep(p, keys, slot));
+
+	if (slot_) *slot_ = slot;
+	return lb_emit_comp(p, Token_CmpEq, stored, key);
+}
+
+gb_internal lbValue lb_build_constant_map_index(lbProcedure *p, Ast *expr) {
+	ast_node(ie, IndexExpr, expr);
+	lbModule *m = p->module;
+
+	TypeAndValue map_tv = type_and_value_of_expr(ie->expr);
+	Type *t = base_type(map_tv.type);
+	GB_ASSERT(t->kind == Type_Map);
+	Type *result_type = type_of_expr(expr);
+
+	lbValue found = {};
+	lbValue value = {};
+
+	TypeAndValue key_tv = type_and_value_of_expr(ie->index);
+	if (key_tv.mode == Addressing_Constant) {
+		Ast *elem = check_constant_map_find(map_tv.value, key_tv.value);
+		found = lb_const_bool(m, t_bool, elem != nullptr);
+		if (elem != nullptr) {
+			value = lb_const_value(m, t->Map.value, elem->tav.value);
+		} else {
+			value = lb_const_nil(m, t->Map.value);
+		}
+	} else {
+		lbValue key = lb_build_expr(p, ie->index);
+		key = lb_emit_conv(p, key, t->Map.key);
+
+		lbConstantMap *cm = lb_find_or_add_constant_map(m, t, map_tv.value);
+		if (cm == nullptr) {
+			found = lb_const_bool(m, t_bool, false);
+			value = lb_const_nil(m, t->Map.value);
+		} else {
+			lbValue slot = {};
+			found = lb_emit_constant_map_probe(p, cm, t->Map.key, key, &slot);
+
+			lbValue values = {cm->values, alloc_type_pointer(alloc_type_array(t->Map.value, cm->count))};
+			value = lb_emit_load(p, lb_emit_array_ep(p, values, slot));
+			value = lb_emit_select(p, found, value, lb_const_nil(m, t->Map.value));
+		}
+	}
+
+	if (is_type_tuple(result_type)) {
+		lbAddr res = lb_add_local_generated(p, result_type, false);
+		lb_emit_store(p, lb_emit_struct_ep(p, res.addr, 0), value);
+		lb_emit_store(p, lb_emit_struct_ep(p, res.addr, 1), lb_emit_conv(p, found, result_type->Tuple.variables[1]->type));
+		return lb_addr_load(p, res);
+	}
+	return value;
+}
+
+gb_internal lbValue lb_build_constant_map_in(lbProcedure *p, Ast *left, Ast *right, TokenKind op) {
+	lbModule *m = p->module;
+
+	TypeAndValue map_tv = type_and_value_of_expr(right);
+	Type *t = base_type(map_tv.type);
+	GB_ASSERT(t->kind == Type_Map);
+
+	lbValue key = lb_build_expr(p, left);
+	key = lb_emit_conv(p, key, t->Map.key);
+
+	lbValue found = lb_const_bool(m, t_bool, false);
+	lbConstantMap *cm = lb_find_or_add_constant_map(m, t, map_tv.value);
+	if (cm != nullptr) {
+		found = lb_emit_constant_map_probe(p, cm, t->Map.key, key, nullptr);
+	}
+
+	if (op == Token_in) {
+		return lb_emit_conv(p, lb_emit_comp(p, Token_NotEq, found, lb_const_bool(m, t_bool, false)), t_bool);
+	} else {
+		return lb_emit_conv(p, lb_emit_comp(p, Token_CmpEq, found, lb_const_bool(m, t_bool, false)), t_bool);
+	}
+}
+
 gb_internal lbValue lb_build_binary_in(lbProcedure *p, lbValue left, lbValue right, TokenKind op) {
 	Type *rt = base_type(right.type);
 	if (is_type_pointer(rt)) {
@@ -2248,7 +2360,9 @@ gb_internal lbValue lb_build_binary_expr(lbProcedure *p, Ast *expr) {
 
 	case Token_in:
 	case Token_not_in:
-		{
+		if (be->right->tav.mode == Addressing_Constant && is_type_map(type_of_expr(be->right))) {
+			return lb_build_constant_map_in(p, be->left, be->right, be->op.kind);
+		} else {
 			lbValue left = lb_build_expr(p, be->left);
 			lbValue right = lb_build_expr(p, be->right);
 			return lb_build_binary_in(p, left, right, be->op.kind);
@@ -4895,7 +5009,7 @@ gb_internal lbAddr lb_build_array_swizzle_addr(lbProcedure *p, AstCallExpr *ce,
 				GB_ASSERT(is_type_integer(tv.type));
 				GB_ASSERT(tv.value.kind == ExactValue_Integer);
 
-				i64 src_index = big_int_to_i64(&tv.value.value_integer);
+				i64 src_index = exact_value_to_i64(tv.value);
 				indices[index_count++] = cast(u8)src_index;
 			}
 			return lb_addr_swizzle(lb_addr_get_ptr(p, addr), tv.type, index_count, indices);
@@ -4908,7 +5022,7 @@ gb_internal lbAddr lb_build_array_swizzle_addr(lbProcedure *p, AstCallExpr *ce,
 		GB_ASSERT(is_type_integer(tv.type));
 		GB_ASSERT(tv.value.kind == ExactValue_Integer);
 
-		i64 src_index = big_int_to_i64(&tv.value.value_integer);
+		i64 src_index = exact_value_to_i64(tv.value);
 		indices[index_index++] = cast(i32)src_index;
 	}
 	if (addr.kind == lbAddr_SoaVariable) {
@@ -5104,7 +5218,7 @@ gb_internal lbAddr lb_build_addr_soa_elem_index(lbProcedure *p, Ast *expr, lbAdd
 
 	auto const index_tv = type_and_value_of_expr(ie->index);
 	if (index_tv.mode == Addressing_Constant && index_tv.value.kind == ExactValue_Integer) {
-		i64 component = big_int_to_i64(&index_tv.value.value_integer);
+		i64 component = exact_value_to_i64(index_tv.value);
 		GB_ASSERT_MSG(0 <= component && component < component_count, "%s", expr_to_string(expr));
 		return lb_addr_soa_field_elem(lb_soa_field_elem_ptr(p, soa_addr.addr, cast(i32)component, soa_addr.soa.index));
 	}
@@ -5179,6 +5293,14 @@ gb_internal lbAddr lb_build_addr_index_expr(lbProcedure *p, Ast *expr) {
 	GB_ASSERT_MSG(is_type_indexable(t), "%s %s", type_to_string(t), expr_to_string(expr));
 
 	if (is_type_map(t)) {
+		if (ie->expr->tav.mode == Addressing_Constant) {
+			// NOTE: a constant map is read-only, so the result of the lookup is copied into a temporary
+			lbValue res = lb_build_constant_map_index(p, expr);
+			lbAddr addr = lb_add_local_generated(p, res.type, false);
+			lb_addr_store(p, addr, res);
+			return addr;
+		}
+
 		lbAddr map_addr = lb_build_addr(p, ie->expr);
 		lbValue key = lb_build_expr(p, ie->index);
 		key = lb_emit_conv(p, key, t->Map.key);
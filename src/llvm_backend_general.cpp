@@ -78,6 +78,9 @@ gb_internal WORKER_TASK_PROC(lb_init_module_worker_proc) {
 			module_name = gb_string_appendc(module_name, "-");
 		}
 		module_name = gb_string_append_length(module_name, m->pkg->name.text, m->pkg->name.len);
+		if (m->partition != 0) {
+			module_name = gb_string_append_fmt(module_name, "-%d", m->partition);
+		}
 	} else {
 		if (gb_string_length(module_name)) {
 			module_name = gb_string_appendc(module_name, "-");
@@ -92,6 +95,7 @@ gb_internal WORKER_TASK_PROC(lb_init_module_worker_proc) {
 	}
 
 	m->module_name = module_name;
+	TRACE_SCOPE("init module", make_string_c(m->module_name));
 	m->ctx = LLVMContextCreate();
 	LLVMContextSetDiagnosticHandler(m->ctx, lb_llvm_diagnostic_handler, nullptr);
 	m->mod = LLVMModuleCreateWithNameInContext(m->module_name, m->ctx);
@@ -168,6 +172,7 @@ gb_internal WORKER_TASK_PROC(lb_init_module_worker_proc) {
 	map_init(&m->map_info_map, 0);
 	map_init(&m->map_cell_info_map, 0);
 	map_init(&m->exact_value_compound_literal_addr_map, 1024);
+	map_init(&m->constant_maps);
 
 	array_init(&m->pad_types, heap_allocator());
 
@@ -185,6 +190,142 @@ gb_internal void lb_init_module(lbModule *m, bool do_threading) {
 	}
 }
 
+struct lbProcedureCost {
+	Entity *e;
+	i64     cost;
+};
+
+gb_internal GB_COMPARE_PROC(lb_procedure_cost_cmp) {
+	lbProcedureCost *x = cast(lbProcedureCost *)a;
+	lbProcedureCost *y = cast(lbProcedureCost *)b;
+	if (x->e->pkg != y->e->pkg) {
+		return isize_cmp(x->e->pkg->id, y->e->pkg->id);
+	}
+	if (x->cost != y->cost) {
+		return x->cost > y->cost ? -1 : +1;
+	}
+	return token_pos_cmp(x->e->token.pos, y->e->token.pos);
+}
+
+// Roughly how much work it is to generate, optimize and emit the body of `e`, or 0 if it is not
+// generated (or not generated where it is declared)
+gb_internal i64 lb_estimate_procedure_cost(Entity *e) {
+	if (e->kind != Entity_Procedure || e->pkg == nullptr) {
+		return 0;
+	}
+	if (e->Procedure.is_foreign || e->Procedure.generated_from_polymorphic) {
+		return 0;
+	}
+	if (e->min_dep_count.load(std::memory_order_relaxed) == 0) {
+		return 0;
+	}
+	DeclInfo *decl = e->decl_info;
+	if (decl == nullptr || decl->proc_lit == nullptr || decl->proc_lit->kind != Ast_ProcLit) {
+		return 0;
+	}
+	if (is_type_polymorphic(e->type)) {
+		return 0;
+	}
+	Ast *body = decl->proc_lit->ProcLit.body;
+	if (body == nullptr || body->kind != Ast_BlockStmt) {
+		return 0;
+	}
+	// NOTE: the size of the body in the source, which includes any nested procedure literals as they
+	// are generated alongside it, plus a fixed overhead per procedure
+	i64 size = cast(i64)body->BlockStmt.close.pos.offset - cast(i64)body->BlockStmt.open.pos.offset;
+	return 256 + gb_max(size, 0);
+}
+
+// Splits the procedures of any package which would take much more than its share of the code
+// generation into extra modules ("codegen units"), so that every stage after it can be spread evenly
+// over the threads. The procedures of a split package are packed into the units largest first, each
+// one to the unit with the least work so far, and are placed there through `code_gen_module`. Any
+// reference to them from another module is then handled like any other cross-module reference
+// (see `lb_correct_entity_linkage`).
+// NOTE: only done with `-internal-split-packages` for now
+gb_internal void lb_partition_package_procedures(lbGenerator *gen, Checker *c, bool module_per_file, bool do_threading) {
+	isize thread_count = gb_max(build_context.thread_count, 1);
+	if (thread_count <= 1) {
+		return;
+	}
+
+	auto procs = array_make<lbProcedureCost>(heap_allocator(), 0, gen->info->entities.count);
+	defer (array_free(&procs));
+
+	i64 total_cost = 0;
+	for (Entity *e : gen->info->entities) {
+		i64 cost = lb_estimate_procedure_cost(e);
+		if (cost > 0) {
+			array_add(&procs, lbProcedureCost{e, cost});
+			total_cost += cost;
+		}
+	}
+
+	i64 target_cost = total_cost / thread_count;
+	if (target_cost <= 0) {
+		return;
+	}
+
+	array_sort(procs, lb_procedure_cost_cmp);
+
+	auto units = array_make<lbModule *>(heap_allocator(), 0, thread_count);
+	auto loads = array_make<i64>(heap_allocator(), 0, thread_count);
+	defer (array_free(&units));
+	defer (array_free(&loads));
+
+	for (isize lo = 0, hi = 0; lo < procs.count; lo = hi) {
+		AstPackage *pkg = procs[lo].e->pkg;
+		i64 pkg_cost = 0;
+		for (hi = lo; hi < procs.count && procs[hi].e->pkg == pkg; hi++) {
+			pkg_cost += procs[hi].cost;
+		}
+
+		if (pkg->kind == Package_Runtime || module_per_file) {
+			// NOTE: already split per file
+			continue;
+		}
+		isize unit_count = cast(isize)gb_min(cast(i64)thread_count, (pkg_cost + target_cost - 1) / target_cost);
+		if (unit_count < 2) {
+			continue;
+		}
+
+		lbModule *m = map_must_get(&gen->modules, cast(void *)pkg);
+
+		array_clear(&units);
+		array_clear(&loads);
+		array_add(&units, m);
+		array_add(&loads, cast(i64)0);
+		for (isize i = 1; i < unit_count; i++) {
+			auto pm = permanent_alloc_item<lbModule>();
+			pm->pkg       = pkg;
+			pm->gen       = gen;
+			pm->checker   = c;
+			pm->partition = cast(i32)i;
+			pm->polymorphic_module = m->polymorphic_module;
+			map_set(&gen->modules, cast(void *)pm, pm); // point to itself just add it to the list
+			lb_init_module(pm, do_threading);
+
+			array_add(&units, pm);
+			array_add(&loads, cast(i64)0);
+		}
+
+		for (isize i = lo; i < hi; i++) {
+			isize best = 0;
+			for (isize j = 1; j < unit_count; j++) {
+				if (loads[j] < loads[best]) {
+					best = j;
+				}
+			}
+			loads[best] += procs[i].cost;
+			if (best != 0) {
+				procs[i].e->decl_info->code_gen_module.store(units[best], std::memory_order_relaxed);
+			}
+		}
+
+		debugf("Split package '%.*s' (%lld of %lld estimated cost) into %td modules\n", LIT(pkg->name), cast(long long)pkg_cost, cast(long long)total_cost, unit_count);
+	}
+}
+
 gb_internal bool lb_init_generator(lbGenerator *gen, Checker *c) {
 	if (global_error_collector.count != 0) {
 		return false;
@@ -286,6 +427,16 @@ gb_internal bool lb_init_generator(lbGenerator *gen, Checker *c) {
 			}
 		}
 
+		bool pgo = build_context.pgo_generate || build_context.pgo_use_path.len != 0;
+		if (build_context.internal_split_packages && do_threading && !pgo &&
+		    (build_context.optimization_level <= 0 || build_context.lto_kind != LTO_None)) {
+			// NOTE: like `module_per_file`, this is limited to when there is no cross-procedure optimization
+			// at compile time (or it is done at link time), as it cannot happen across modules.
+			// It is skipped with PGO, as the split depends on the thread count and changes the
+			// linkage (and so the profile names) of the procedures it moves.
+			lb_partition_package_procedures(gen, c, module_per_file, do_threading);
+		}
+
 		if (LLVM_WEAK_MONOMORPHIZATION) {
 			lbModule *m = permanent_alloc_item<lbModule>();
 			gen->equal_module = m;
@@ -315,6 +466,8 @@ gb_internal bool lb_init_generator(lbGenerator *gen, Checker *c) {
 	mpsc_init(&gen->objc_ivars, heap_allocator());
 	mpsc_init(&gen->raddebug_section_strings, heap_allocator());
 
+	map_init(&gen->load_sections);
+
 	return true;
 }
 
@@ -3299,10 +3452,104 @@ general_end:;
 
 
 
+// NOTE: the side object is written with module level assembly, so only targets whose object format is known
+// are supported; everything else keeps the payload as LLVM constant data
+gb_internal bool lb_use_load_sections(void) {
+	if (build_context.internal_no_load_sections) {
+		return false;
+	}
+	if (build_context.lto_kind != LTO_None) {
+		return false;
+	}
+	switch (build_context.build_mode) {
+	case BuildMode_Assembly:
+	case BuildMode_LLVM_IR:
+	case BuildMode_Object:
+		// NOTE: the side object is only ever passed to the linker, so it would be missing from these outputs
+		return false;
+	}
+	if (is_arch_wasm()) {
+		return false;
+	}
+	switch (build_context.metrics.os) {
+	case TargetOs_windows:
+	case TargetOs_darwin:
+	case TargetOs_linux:
+	case TargetOs_freebsd:
+	case TargetOs_openbsd:
+	case TargetOs_netbsd:
+		return true;
+	}
+	return false;
+}
+
+// Returns a pointer to the first byte of `data` (followed by a NUL, like `LLVMConstStringInContext`) stored in
+// a load section, deduplicated by content across all modules, or `nullptr` if the caller must emit it itself
+gb_internal LLVMValueRef lb_find_or_add_load_section(lbModule *m, String const &data, i64 alignment) {
+	if (data.len < LB_LOAD_SECTION_THRESHOLD || !lb_use_load_sections()) {
+		return nullptr;
+	}
+
+	lbGenerator *gen = m->gen;
+	Hash128 hash = hash128(data.text, data.len);
+
+	String symbol_name = {};
+	mutex_lock(&gen->load_sections_mutex);
+	// NOTE: different data may share `hash.lo`, but the symbol name has all of the hash so they stay distinct
+	for (auto *entry = multi_map_find_first(&gen->load_sections, hash.lo);
+	     entry != nullptr;
+	     entry = multi_map_find_next(&gen->load_sections, entry)) {
+		lbLoadSection *section = entry->value;
+		if (section->hash == hash) {
+			GB_ASSERT_MSG(section->data == data, "two different #load payloads have the same 128-bit hash");
+			section->alignment = gb_max(section->alignment, alignment);
+			symbol_name = section->symbol_name;
+			break;
+		}
+	}
+	if (symbol_name.len == 0) {
+		lbLoadSection *section = permanent_alloc_item<lbLoadSection>();
+		section->data      = data;
+		section->hash      = hash;
+		section->alignment = alignment;
+
+		gbString name = gb_string_make(permanent_allocator(), "");
+		name = gb_string_append_fmt(name, "__odin_load_%016llx%016llx", cast(unsigned long long)hash.hi, cast(unsigned long long)hash.lo);
+		section->symbol_name = make_string(cast(u8 *)name, gb_string_length(name));
+		symbol_name = section->symbol_name;
+
+		multi_map_insert(&gen->load_sections, hash.lo, section);
+	}
+	mutex_unlock(&gen->load_sections_mutex);
+
+	LLVMTypeRef type = llvm_array_type(LLVMInt8TypeInContext(m->ctx), cast(u64)data.len+1);
+	char const *name = alloc_cstring(temporary_allocator(), symbol_name);
+	LLVMValueRef global_data = LLVMGetNamedGlobal(m->mod, name);
+	if (global_data == nullptr) {
+		global_data = LLVMAddGlobal(m->mod, type, name);
+		LLVMSetLinkage(global_data, LLVMExternalLinkage);
+		LLVMSetGlobalConstant(global_data, true);
+		if (build_context.metrics.os != TargetOs_windows) {
+			LLVMSetVisibility(global_data, LLVMHiddenVisibility);
+		}
+	}
+	LLVMSetAlignment(global_data, cast(unsigned)gb_max(LLVMGetAlignment(global_data), cast(unsigned)alignment));
+
+	LLVMValueRef indices[2] = {llvm_zero(m), llvm_zero(m)};
+	return LLVMConstInBoundsGEP2(type, global_data, indices, 2);
+}
+
 gb_internal LLVMValueRef lb_find_or_add_entity_string_ptr(lbModule *m, String const &str, bool custom_link_section) {
 	StringHashKey key = {};
 	LLVMValueRef *found = nullptr;
 
+	if (!custom_link_section) {
+		LLVMValueRef ptr = lb_find_or_add_load_section(m, str, 1);
+		if (ptr != nullptr) {
+			return ptr;
+		}
+	}
+
 	if (!custom_link_section) {
 		key = string_hash_string(str);
 		found = string_map_get(&m->const_strings, key);
@@ -3330,6 +3577,8 @@ gb_internal LLVMValueRef lb_find_or_add_entity_string_ptr(lbModule *m, String co
 
 		LLVMValueRef ptr = LLVMConstInBoundsGEP2(type, global_data, indices, 2);
 		if (!custom_link_section) {
+			// NOTE: the map keeps the key, which may be in temporary memory
+			key.string = copy_string(permanent_allocator(), str);
 			string_map_set(&m->const_strings, key, ptr);
 		}
 		return ptr;
@@ -3382,6 +3631,9 @@ gb_internal LLVMValueRef lb_find_or_add_entity_string16_ptr(lbModule *m, String1
 
 	LLVMValueRef ptr = LLVMConstInBoundsGEP2(type, global_data, indices, 2);
 	if (!custom_link_section) {
+		// NOTE: the map keeps the key, which may be in temporary memory
+		key.string.text = gb_alloc_array(permanent_allocator(), u16, str.len);
+		gb_memmove(key.string.text, str.text, str.len*gb_size_of(u16));
 		string16_map_set(&m->const_string16s, key, ptr);
 	}
 	return ptr;
@@ -3404,41 +3656,47 @@ gb_internal lbValue lb_find_or_add_entity_string(lbModule *m, String const &str,
 
 gb_internal lbValue lb_find_or_add_entity_string_byte_slice_with_type(lbModule *m, String const &str, Type *slice_type) {
 	GB_ASSERT(is_type_slice(slice_type));
-	LLVMValueRef indices[2] = {llvm_zero(m), llvm_zero(m)};
-	LLVMValueRef data = LLVMConstStringInContext(m->ctx,
-		cast(char const *)str.text,
-		cast(unsigned)str.len,
-		false);
 
+	i64 align = MINIMUM_SLICE_ALIGNMENT;
+	Type *elem = nullptr;
+	if (!is_type_u8_slice(slice_type)) {
+		Type *bt = base_type(slice_type);
+		elem = bt->Slice.elem;
+		align = gb_max(type_align_of(elem), align);
+		GB_ASSERT(align > 0);
+	}
 
-	u32 id = m->global_array_index.fetch_add(1);
-	gbString name = gb_string_make(temporary_allocator(), "csba$");
-	name = gb_string_appendc(name, m->module_name);
-	name = gb_string_append_fmt(name, "$%x", id);
+	i64 data_len = str.len;
+	LLVMValueRef ptr = lb_find_or_add_load_section(m, str, elem != nullptr ? align : 1);
+	if (ptr == nullptr) {
+		LLVMValueRef indices[2] = {llvm_zero(m), llvm_zero(m)};
+		LLVMValueRef data = LLVMConstStringInContext(m->ctx,
+			cast(char const *)str.text,
+			cast(unsigned)str.len,
+			false);
 
-	LLVMTypeRef type = LLVMTypeOf(data);
-	LLVMValueRef global_data = LLVMAddGlobal(m->mod, type, name);
-	LLVMSetInitializer(global_data, data);
-	lb_make_global_private_const(global_data);
-	LLVMSetAlignment(global_data, 1);
 
-	i64 data_len = str.len;
-	LLVMValueRef ptr = nullptr;
-	if (data_len != 0) {
-		ptr = LLVMConstInBoundsGEP2(type, global_data, indices, 2);
-	} else {
-		ptr = LLVMConstNull(lb_type(m, t_u8_ptr));
+		u32 id = m->global_array_index.fetch_add(1);
+		gbString name = gb_string_make(temporary_allocator(), "csba$");
+		name = gb_string_appendc(name, m->module_name);
+		name = gb_string_append_fmt(name, "$%x", id);
+
+		LLVMTypeRef type = LLVMTypeOf(data);
+		LLVMValueRef global_data = LLVMAddGlobal(m->mod, type, name);
+		LLVMSetInitializer(global_data, data);
+		lb_make_global_private_const(global_data);
+		LLVMSetAlignment(global_data, elem != nullptr ? cast(u32)align : 1);
+
+		if (data_len != 0) {
+			ptr = LLVMConstInBoundsGEP2(type, global_data, indices, 2);
+		} else {
+			ptr = LLVMConstNull(lb_type(m, t_u8_ptr));
+		}
 	}
-	i64 align = MINIMUM_SLICE_ALIGNMENT;
-	if (!is_type_u8_slice(slice_type)) {
-		Type *bt = base_type(slice_type);
-		Type *elem = bt->Slice.elem;
+	if (elem != nullptr) {
 		i64 sz = type_size_of(elem);
-		align = gb_max(type_align_of(elem), align);
 		GB_ASSERT(sz > 0);
-		GB_ASSERT(align > 0);
 
-		LLVMSetAlignment(global_data, (u32)align);
 		ptr = LLVMConstPointerCast(ptr, lb_type(m, alloc_type_pointer(elem)));
 		data_len /= sz;
 	}
@@ -3717,6 +3975,9 @@ gb_internal lbAddr lb_add_global_generated_with_name(lbModule *m, Type *type, lb
 	GB_ASSERT(type != nullptr);
 	type = default_type(type);
 
+	// NOTE: the name is kept by the entity and `m->members`, but callers usually build it in temporary memory
+	name = copy_string(permanent_allocator(), name);
+
 	LLVMTypeRef actual_type = lb_type(m, type);
 	if (value.value != nullptr) {
 		LLVMTypeRef value_type = LLVMTypeOf(value.value);
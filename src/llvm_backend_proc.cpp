@@ -70,7 +70,9 @@ gb_internal void lb_mem_copy_non_overlapping(lbProcedure *p, lbValue dst, lbValu
 }
 
 
-gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool ignore_body) {
+gb_internal void lb_create_target_clones(lbModule *m, lbProcedure *p);
+
+gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool ignore_body, String target_clone) {
 	GB_ASSERT(entity != nullptr);
 	GB_ASSERT(entity->kind == Entity_Procedure);
 	// Skip codegen for unspecialized polymorphic procedures
@@ -96,11 +98,20 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 		link_name = lb_get_entity_name(m, entity);
 	}
 
+	if (target_clone.len != 0) {
+		gbString name = gb_string_make_length(permanent_allocator(), link_name.text, link_name.len);
+		name = gb_string_appendc(name, ".");
+		name = gb_string_append_length(name, target_clone.text, target_clone.len);
+		link_name = make_string(cast(u8 *)name, gb_string_length(name));
+	}
+
 	{
 		StringHashKey key = string_hash_string(link_name);
 		lbValue *found = string_map_get(&m->members, key);
 		if (found) {
-			lb_add_entity(m, entity, *found);
+			if (target_clone.len == 0) {
+				lb_add_entity(m, entity, *found);
+			}
 			return string_map_must_get(&m->procedures, key);
 		}
 	}
@@ -108,10 +119,13 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 	lbProcedure *p = permanent_alloc_item<lbProcedure>();
 
 	p->module = m;
-	entity->code_gen_module = m;
-	entity->code_gen_procedure = p;
+	if (target_clone.len == 0) {
+		entity->code_gen_module = m;
+		entity->code_gen_procedure = p;
+	}
 	p->entity = entity;
 	p->name = link_name;
+	p->target_clone = target_clone;
 
 	DeclInfo *decl = entity->decl_info;
 
@@ -125,7 +139,7 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 	p->inlining       = pl->inlining;
 	p->tailing        = pl->tailing;
 	p->is_foreign     = entity->Procedure.is_foreign;
-	p->is_export      = entity->Procedure.is_export;
+	p->is_export      = entity->Procedure.is_export && target_clone.len == 0;
 	p->is_entry_point = false;
 
 	gbAllocator a = heap_allocator();
@@ -235,6 +249,21 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 			feature_str = gb_string_append_length(feature_str, str.text, str.len);
 		}
 
+		lb_add_attribute_to_proc_with_string(m, p->value, make_string_c("target-features"), make_string_c(feature_str));
+	} else if (target_clone.len != 0 && target_clone != "default") {
+		gbString feature_str = gb_string_make(temporary_allocator(), "");
+
+		String_Iterator it = {target_clone, 0};
+		for (;;) {
+			String str = string_split_iterator(&it, '+');
+			if (str == "") break;
+			if (gb_string_length(feature_str) != 0) {
+				feature_str = gb_string_appendc(feature_str, ",");
+			}
+			feature_str = gb_string_appendc(feature_str, "+");
+			feature_str = gb_string_append_length(feature_str, str.text, str.len);
+		}
+
 		lb_add_attribute_to_proc_with_string(m, p->value, make_string_c("target-features"), make_string_c(feature_str));
 	}
 
@@ -328,6 +357,11 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 
 	lb_set_linkage_from_entity_flags(p->module, p->value, entity->flags);
 
+	if (target_clone.len != 0) {
+		// NOTE: clones are only ever called through the dispatcher in the same module
+		LLVMSetLinkage(p->value, LLVMInternalLinkage);
+	}
+
 	// With LTO on all platforms, required procedures with external linkage need to be added to
 	// llvm.used to survive linker-level dead code elimination. This is necessary because
 	// LLVM may generate implicit calls to runtime builtins (e.g., __extendhfsf2 for f16
@@ -350,7 +384,12 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 		LLVMMetadataRef file = nullptr;
 		LLVMMetadataRef type = nullptr;
 		scope = p->module->debug_compile_unit;
-		type = lb_debug_type_internal_proc(m, bt);
+		if (lb_debug_line_tables_only()) {
+			// NOTE: symbolizers and profilers only need the name and the lines, not the signature
+			type = LLVMDIBuilderCreateSubroutineType(m->debug_builder, nullptr, nullptr, 0, LLVMDIFlagZero);
+		} else {
+			type = lb_debug_type_internal_proc(m, bt);
+		}
 
 		Ast *ident = entity->identifier.load();
 		if (entity->file != nullptr) {
@@ -421,10 +460,16 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 	}
 
 	lbValue proc_value = {p->value, p->type};
-	lb_add_entity(m, entity,  proc_value);
+	if (target_clone.len == 0) {
+		lb_add_entity(m, entity,  proc_value);
+	}
 	lb_add_member(m, p->name, proc_value);
 	lb_add_procedure_value(m, p);
 
+	if (p->body != nullptr && target_clone.len == 0 && pt->Proc.target_clones.len != 0) {
+		lb_create_target_clones(m, p);
+	}
+
 	return p;
 }
 
@@ -864,6 +909,156 @@ gb_internal void lb_end_procedure_body(lbProcedure *p) {
 	LLVMDisposeBuilder(p->builder);
 }
 
+gb_internal void lb_target_clones_resolver_generate_body(lbModule *m, lbProcedure *p) {
+	lb_begin_procedure_body(p);
+
+	// NOTE: the clones are in order of preference and the "default" clone is always last
+	for (lbProcedure *clone : p->target_clones) {
+		if (clone->target_clone == "default") {
+			LLVMBuildRet(p->builder, clone->value);
+			break;
+		}
+
+		auto args = array_make<lbValue>(permanent_allocator(), 1);
+		args[0] = lb_const_string(m, clone->target_clone);
+		lbValue supported = lb_emit_runtime_call(p, "__target_clones_supported", args);
+
+		lbBlock *found = lb_create_block(p, "clone.found");
+		lbBlock *next  = lb_create_block(p, "clone.next");
+		lb_emit_if(p, supported, found, next);
+
+		lb_start_block(p, found);
+		LLVMBuildRet(p->builder, clone->value);
+
+		lb_start_block(p, next);
+	}
+
+	lb_end_procedure_body(p);
+}
+
+// NOTE: The dispatcher keeps the procedure's own name and signature and forwards its arguments
+// untouched to the clone picked by the resolver. The choice is cached in a global on the first call,
+// so cpuid is only ever queried once per procedure.
+gb_internal void lb_target_clones_generate_body(lbModule *m, lbProcedure *p) {
+	for (lbProcedure *clone : p->target_clones) {
+		lb_generate_procedure(m, clone);
+	}
+
+	String resolver_name = concatenate_strings(permanent_allocator(), p->name, str_lit(".resolver"));
+	Type *resolver_type = alloc_type_proc_from_types(nullptr, 0, t_rawptr, false, ProcCC_Contextless);
+	lbProcedure *resolver = lb_create_dummy_procedure(m, resolver_name, resolver_type);
+	LLVMSetLinkage(resolver->value, LLVMInternalLinkage);
+	lb_add_attribute_to_proc(m, resolver->value, "noinline");
+	lb_add_attribute_to_proc(m, resolver->value, "cold");
+	resolver->target_clones = p->target_clones;
+	resolver->generate_body = lb_target_clones_resolver_generate_body;
+	lb_generate_procedure(m, resolver);
+
+	// NOTE: entry/exit instrumentation is left to the clones so it fires once per call
+	LLVMRemoveStringAttributeAtIndex(p->value, LLVMAttributeIndex_FunctionIndex, "instrument-function-entry", 25);
+	LLVMRemoveStringAttributeAtIndex(p->value, LLVMAttributeIndex_FunctionIndex, "instrument-function-exit",  24);
+
+	LLVMTypeRef ptr_type = LLVMPointerTypeInContext(m->ctx, 0);
+	unsigned ptr_align = cast(unsigned)build_context.metrics.ptr_size;
+
+	LLVMValueRef cache = nullptr;
+	{
+		TEMPORARY_ALLOCATOR_GUARD();
+		String cache_name = concatenate_strings(temporary_allocator(), p->name, str_lit(".cache"));
+		cache = LLVMAddGlobal(m->mod, ptr_type, alloc_cstring(temporary_allocator(), cache_name));
+	}
+	LLVMSetInitializer(cache, LLVMConstNull(ptr_type));
+	LLVMSetLinkage(cache, LLVMInternalLinkage);
+	LLVMSetAlignment(cache, ptr_align);
+
+	p->builder = LLVMCreateBuilderInContext(m->ctx);
+	LLVMBasicBlockRef entry    = LLVMAppendBasicBlockInContext(m->ctx, p->value, "entry");
+	LLVMBasicBlockRef resolve  = LLVMAppendBasicBlockInContext(m->ctx, p->value, "resolve");
+	LLVMBasicBlockRef dispatch = LLVMAppendBasicBlockInContext(m->ctx, p->value, "dispatch");
+
+	LLVMPositionBuilderAtEnd(p->builder, entry);
+	lb_set_debug_position_to_procedure_begin(p);
+
+	LLVMValueRef cached = LLVMBuildLoad2(p->builder, ptr_type, cache, "");
+	LLVMSetOrdering(cached, LLVMAtomicOrderingMonotonic);
+	LLVMSetAlignment(cached, ptr_align);
+	LLVMBuildCondBr(p->builder, LLVMBuildIsNull(p->builder, cached, ""), resolve, dispatch);
+
+	LLVMPositionBuilderAtEnd(p->builder, resolve);
+	LLVMValueRef resolved = LLVMBuildCall2(p->builder, lb_get_procedure_raw_type(m, resolver->type), resolver->value, nullptr, 0, "");
+	LLVMSetInstructionCallConv(resolved, LLVMGetFunctionCallConv(resolver->value));
+	LLVMValueRef store = LLVMBuildStore(p->builder, resolved, cache);
+	LLVMSetOrdering(store, LLVMAtomicOrderingMonotonic);
+	LLVMSetAlignment(store, ptr_align);
+	LLVMBuildBr(p->builder, dispatch);
+
+	LLVMPositionBuilderAtEnd(p->builder, dispatch);
+	LLVMValueRef target = LLVMBuildPhi(p->builder, ptr_type, "");
+	LLVMValueRef      incoming_values[2] = {cached, resolved};
+	LLVMBasicBlockRef incoming_blocks[2] = {entry,  resolve};
+	LLVMAddIncoming(target, incoming_values, incoming_blocks, 2);
+
+	unsigned param_count = LLVMCountParams(p->value);
+	LLVMValueRef *args = gb_alloc_array(permanent_allocator(), LLVMValueRef, param_count);
+	LLVMGetParams(p->value, args);
+
+	LLVMTypeRef func_type = lb_get_procedure_raw_type(m, p->type);
+	LLVMValueRef call = LLVMBuildCall2(p->builder, func_type, target, args, param_count, "");
+	LLVMSetInstructionCallConv(call, LLVMGetFunctionCallConv(p->value));
+	LLVMSetTailCall(call, true);
+
+	// NOTE: byval/sret and friends must be repeated on the call for the arguments to be passed the same way;
+	// index 0 is the return value and the parameters start at 1
+	for (unsigned index = 0; index <= param_count; index++) {
+		unsigned attr_count = LLVMGetAttributeCountAtIndex(p->value, index);
+		if (attr_count == 0) {
+			continue;
+		}
+		LLVMAttributeRef *attrs = gb_alloc_array(permanent_allocator(), LLVMAttributeRef, attr_count);
+		LLVMGetAttributesAtIndex(p->value, index, attrs);
+		for (unsigned i = 0; i < attr_count; i++) {
+			LLVMAddCallSiteAttribute(call, index, attrs[i]);
+		}
+	}
+
+	if (base_type(p->type)->Proc.diverging) {
+		LLVMBuildUnreachable(p->builder);
+	} else if (LLVMGetTypeKind(LLVMGetReturnType(func_type)) == LLVMVoidTypeKind) {
+		LLVMBuildRetVoid(p->builder);
+	} else {
+		LLVMBuildRet(p->builder, call);
+	}
+
+	LLVMDisposeBuilder(p->builder);
+	p->builder = nullptr;
+}
+
+gb_internal void lb_create_target_clones(lbModule *m, lbProcedure *p) {
+	Type *pt = base_type(p->type);
+
+	lbProcedure *default_clone = nullptr;
+	auto clones = array_make<lbProcedure *>(heap_allocator(), 0, 4);
+
+	String_Iterator it = {pt->Proc.target_clones, 0};
+	for (;;) {
+		String target_clone = string_trim_whitespace(string_split_iterator(&it, ','));
+		if (target_clone == "") break;
+
+		lbProcedure *clone = lb_create_procedure(m, p->entity, false, target_clone);
+		if (target_clone == "default") {
+			default_clone = clone;
+		} else {
+			array_add(&clones, clone);
+		}
+	}
+	GB_ASSERT(default_clone != nullptr);
+	array_add(&clones, default_clone);
+
+	p->target_clones = clones;
+	p->body = nullptr;
+	p->generate_body = lb_target_clones_generate_body;
+}
+
 gb_internal void lb_build_nested_proc(lbProcedure *p, AstProcLit *pd, Entity *e) {
 	GB_ASSERT(pd->body != nullptr);
 	lbModule *m = p->module;
@@ -2779,7 +2974,8 @@ gb_internal lbValue lb_build_builtin_simd_proc(lbProcedure *p, Ast *expr, TypeAn
 			TypeAndValue const &tv = ce->args[1]->tav;
 			ExactValue val = exact_value_to_integer(tv.value);
 			GB_ASSERT(val.kind == ExactValue_Integer);
-			BigInt *bi = &val.value_integer;
+			BigInt bi_val = exact_value_to_big_int(val);
+			BigInt *bi = &bi_val;
 			if (builtin_id == BuiltinProc_simd_lanes_rotate_right) {
 				big_int_neg(bi, bi);
 			}
@@ -3119,7 +3315,7 @@ gb_internal lbValue lb_build_builtin_proc(lbProcedure *p, Ast *expr, TypeAndValu
 				GB_ASSERT(is_type_integer(tv.type));
 				GB_ASSERT(tv.value.kind == ExactValue_Integer);
 
-				u32 index = cast(u32)big_int_to_i64(&tv.value.value_integer);
+				u32 index = cast(u32)exact_value_to_i64(tv.value);
 				mask_elems[i-1] = LLVMConstInt(lb_type(p->module, t_u32), index, false);
 			}
 
@@ -5141,7 +5337,7 @@ gb_internal lbValue lb_build_call_expr_internal(lbProcedure *p, Ast *expr, lbVal
 		switch (v.kind) {
 		case ExactValue_Integer:
 			{
-				u64 u = big_int_to_u64(&v.value_integer);
+				u64 u = exact_value_to_u64(v);
 				lbValue x = {};
 				x.value = LLVMConstInt(lb_type(m, t_uintptr), u, false);
 				x.type = t_uintptr;
@@ -315,7 +315,8 @@ gb_internal void lb_open_scope(lbProcedure *p, Scope *s) {
 			}
 			GB_ASSERT_MSG(scope != nullptr, "%.*s", LIT(p->name));
 
-			if (m->debug_builder) {
+			// NOTE: line tables keep every location in the procedure's own scope
+			if (m->debug_builder && !lb_debug_line_tables_only()) {
 				LLVMMetadataRef res = LLVMDIBuilderCreateLexicalBlock(m->debug_builder, scope,
 					file, line, column
 				);
@@ -1866,6 +1867,44 @@ gb_internal void lb_build_unroll_range_stmt(lbProcedure *p, AstUnrollRangeStmt *
 	lb_close_scope(p, lbDeferExit_Default, nullptr, rs->body);
 }
 
+// NOTE: the most values which constant integer ranges are expanded into as individual cases of a jump table;
+// LLVM turns runs of cases with the same destination back into range checks where that is cheaper
+#define LB_SWITCH_MAX_RANGE_CASES 512
+
+// Returns the bounds of a constant integer range case as a half-open interval
+gb_internal bool lb_switch_case_constant_range(Ast *expr, i64 *lo_, i64 *hi_) {
+	ast_node(ie, BinaryExpr, expr);
+	TypeAndValue lhs = type_and_value_of_expr(ie->left);
+	TypeAndValue rhs = type_and_value_of_expr(ie->right);
+	if (lhs.mode != Addressing_Constant || rhs.mode != Addressing_Constant) {
+		return false;
+	}
+	ExactValue lo = exact_value_to_integer(lhs.value);
+	ExactValue hi = exact_value_to_integer(rhs.value);
+	if (lo.kind != ExactValue_Integer || !lo.is_small_integer ||
+	    hi.kind != ExactValue_Integer || !hi.is_small_integer) {
+		return false;
+	}
+	i64 l = lo.value_small_integer;
+	i64 h = hi.value_small_integer;
+	switch (ie->op.kind) {
+	case Token_Ellipsis:
+	case Token_RangeFull:
+		if (h == I64_MAX) {
+			return false;
+		}
+		h += 1;
+		break;
+	case Token_RangeHalf:
+		break;
+	default:
+		return false;
+	}
+	*lo_ = l;
+	*hi_ = gb_max(l, h);
+	return true;
+}
+
 gb_internal bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, bool *default_found_) {
 	if (ss->tag == nullptr) {
 		return false;
@@ -1881,6 +1920,8 @@ gb_internal bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, boo
 		return false;
 	}
 
+	i64 range_case_count = 0;
+
 	ast_node(body, BlockStmt, ss->body);
 	for (Ast *clause : body->stmts) {
 		ast_node(cc, CaseClause, clause);
@@ -1893,7 +1934,18 @@ gb_internal bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, boo
 		for (Ast *expr : cc->list) {
 			expr = unparen_expr(expr);
 			if (is_ast_range(expr)) {
-				return false;
+				i64 lo = 0;
+				i64 hi = 0;
+				if (is_typeid || !lb_switch_case_constant_range(expr, &lo, &hi)) {
+					return false;
+				}
+				// NOTE: in unsigned, as a range may span more than `I64_MAX` values
+				u64 span = cast(u64)hi - cast(u64)lo;
+				if (span > cast(u64)(LB_SWITCH_MAX_RANGE_CASES - range_case_count)) {
+					return false;
+				}
+				range_case_count += cast(i64)span;
+				continue;
 			}
 			if (expr->tav.mode == Addressing_Type) {
 				GB_ASSERT(is_typeid);
@@ -1903,20 +1955,229 @@ gb_internal bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, boo
 			if (tv.mode != Addressing_Constant) {
 				return false;
 			}
-			if (!is_type_integer(core_type(tv.type))) {
+			if (is_typeid) {
+				if (tv.value.kind != ExactValue_Typeid) {
+					return false;
+				}
+			} else if (!is_type_integer(core_type(tv.type))) {
 				return false;
 			}
 		}
 
 	}
 
-	if (is_typeid) {
+	return true;
+}
+
+// NOTE: a `switch` on a `string` where every case is a constant string is dispatched with an LLVM `switch` on the
+// length, then on the byte which best distinguishes the cases of that length, and a single comparison to confirm,
+// rather than a chain of `string_eq` calls
+gb_internal bool lb_switch_stmt_is_constant_string_switch(AstSwitchStmt *ss) {
+	if (ss->tag == nullptr) {
+		return false;
+	}
+	TypeAndValue tv = type_and_value_of_expr(ss->tag);
+	Type *t = core_type(tv.type);
+	if (t == nullptr || t->kind != Type_Basic || t->Basic.kind != Basic_string) {
 		return false;
 	}
 
-	return true;
+	isize value_count = 0;
+	ast_node(body, BlockStmt, ss->body);
+	for (Ast *clause : body->stmts) {
+		ast_node(cc, CaseClause, clause);
+		for (Ast *expr : cc->list) {
+			expr = unparen_expr(expr);
+			if (is_ast_range(expr)) {
+				return false;
+			}
+			tv = type_and_value_of_expr(expr);
+			if (tv.mode != Addressing_Constant || tv.value.kind != ExactValue_String) {
+				return false;
+			}
+			value_count += 1;
+		}
+	}
+	// NOTE: a handful of comparisons is no slower than the dispatch
+	return value_count >= 4;
 }
 
+struct lbStringSwitchCase {
+	String   value;
+	lbBlock *body;
+	isize    index; // order within the `switch`, as `array_sort` is not stable
+};
+
+gb_internal int lb_string_switch_case_cmp(void const *x, void const *y) {
+	lbStringSwitchCase const *a = cast(lbStringSwitchCase const *)x;
+	lbStringSwitchCase const *b = cast(lbStringSwitchCase const *)y;
+	if (a->value.len != b->value.len) {
+		return a->value.len < b->value.len ? -1 : +1;
+	}
+	i32 cmp = string_compare(a->value, b->value);
+	if (cmp != 0) {
+		return cmp;
+	}
+	return isize_cmp(a->index, b->index);
+}
+
+// Returns whether the `value.len` bytes at `data` are equal to `value`
+gb_internal lbValue lb_emit_string_switch_case_eq(lbProcedure *p, LLVMValueRef data, String const &value) {
+	lbModule *m = p->module;
+	if (value.len > 16) {
+		auto args = array_make<lbValue>(permanent_allocator(), 3);
+		args[0] = lb_emit_conv(p, lbValue{data, t_u8_ptr}, t_rawptr);
+		args[1] = lb_emit_conv(p, lbValue{lb_find_or_add_entity_string_ptr(m, value, false), t_u8_ptr}, t_rawptr);
+		args[2] = lb_const_int(m, t_int, value.len);
+		return lb_emit_runtime_call(p, "memory_equal", args);
+	}
+
+	// NOTE: compare in unaligned integer loads of 8, 4, 2 and 1 bytes
+	LLVMTypeRef llvm_u8 = LLVMInt8TypeInContext(m->ctx);
+	LLVMValueRef cond = nullptr;
+	isize offset = 0;
+	while (offset < value.len) {
+		isize size = 8;
+		while (size > value.len-offset) {
+			size /= 2;
+		}
+
+		u64 expected = 0;
+		for (isize i = 0; i < size; i++) {
+			u64 b = value[offset+i];
+			if (build_context.endian_kind == TargetEndian_Little) {
+				expected |= b << (8*i);
+			} else {
+				expected = (expected << 8) | b;
+			}
+		}
+
+		LLVMTypeRef type = LLVMIntTypeInContext(m->ctx, cast(unsigned)(8*size));
+		LLVMValueRef index = LLVMConstInt(lb_type(m, t_int), offset, false);
+		LLVMValueRef ptr = LLVMBuildGEP2(p->builder, llvm_u8, data, &index, 1, "");
+		LLVMValueRef loaded = LLVMBuildLoad2(p->builder, type, ptr, "");
+		LLVMSetAlignment(loaded, 1);
+
+		LLVMValueRef eq = LLVMBuildICmp(p->builder, LLVMIntEQ, loaded, LLVMConstInt(type, expected, false), "");
+		cond = cond ? LLVMBuildAnd(p->builder, cond, eq, "") : eq;
+		offset += size;
+	}
+	GB_ASSERT(cond != nullptr);
+	return lbValue{cond, t_llvm_bool};
+}
+
+// NOTE: `cases` all have the same length, which is already known to match
+gb_internal void lb_build_string_switch_group(lbProcedure *p, LLVMValueRef data, Slice<lbStringSwitchCase> const &cases, lbBlock *miss) {
+	GB_ASSERT(cases.count > 0);
+	isize len = cases[0].value.len;
+	if (cases.count == 1) {
+		if (len == 0) {
+			lb_emit_jump(p, cases[0].body);
+		} else {
+			lbValue cond = lb_emit_string_switch_case_eq(p, data, cases[0].value);
+			lb_emit_if(p, cond, cases[0].body, miss);
+		}
+		return;
+	}
+
+	isize best_index = -1;
+	isize best_count = 0;
+	for (isize i = 0; i < len && best_count < cases.count; i++) {
+		bool seen[256] = {};
+		isize count = 0;
+		for (lbStringSwitchCase const &c : cases) {
+			u8 b = c.value[i];
+			if (!seen[b]) {
+				seen[b] = true;
+				count += 1;
+			}
+		}
+		if (count > best_count) {
+			best_index = i;
+			best_count = count;
+		}
+	}
+	// NOTE: the cases are distinct, so some byte must differ
+	GB_ASSERT(best_index >= 0 && best_count > 1);
+
+	lbModule *m = p->module;
+	LLVMTypeRef llvm_u8 = LLVMInt8TypeInContext(m->ctx);
+	LLVMValueRef index = LLVMConstInt(lb_type(m, t_int), best_index, false);
+	LLVMValueRef ptr = LLVMBuildGEP2(p->builder, llvm_u8, data, &index, 1, "");
+	LLVMValueRef byte = LLVMBuildLoad2(p->builder, llvm_u8, ptr, "");
+	LLVMSetAlignment(byte, 1);
+
+	LLVMValueRef switch_instr = LLVMBuildSwitch(p->builder, byte, miss->block, cast(unsigned)best_count);
+	auto subset = array_make<lbStringSwitchCase>(temporary_allocator(), 0, cases.count);
+	for (isize b = 0; b < 256; b++) {
+		array_clear(&subset);
+		for (lbStringSwitchCase const &c : cases) {
+			if (c.value[best_index] == b) {
+				array_add(&subset, c);
+			}
+		}
+		if (subset.count == 0) {
+			continue;
+		}
+
+		lbBlock *block = lb_create_block(p, "switch.string.byte");
+		LLVMAddCase(switch_instr, LLVMConstInt(llvm_u8, cast(u64)b, false), block->block);
+		lb_start_block(p, block);
+		lb_build_string_switch_group(p, data, slice_from_array(subset), miss);
+	}
+}
+
+gb_internal void lb_build_constant_string_switch(lbProcedure *p, AstSwitchStmt *ss, lbValue tag, Slice<lbBlock *> const &body_blocks, lbBlock *miss) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	ast_node(body, BlockStmt, ss->body);
+	auto cases = array_make<lbStringSwitchCase>(temporary_allocator(), 0, body->stmts.count);
+	for_array(i, body->stmts) {
+		ast_node(cc, CaseClause, body->stmts[i]);
+		for (Ast *expr : cc->list) {
+			expr = unparen_expr(expr);
+			GB_ASSERT(expr->tav.value.kind == ExactValue_String);
+			array_add(&cases, lbStringSwitchCase{expr->tav.value.value_string, body_blocks[i], cases.count});
+		}
+	}
+	array_sort(cases, lb_string_switch_case_cmp);
+
+	// NOTE: duplicate cases are an error in the checker, but the first one would win as equal values
+	// are sorted by their `index`
+	isize unique_count = 0;
+	for_array(i, cases) {
+		if (unique_count > 0 && cases[unique_count-1].value == cases[i].value) {
+			continue;
+		}
+		cases[unique_count++] = cases[i];
+	}
+	cases.count = unique_count;
+
+	isize len_count = 0;
+	for_array(i, cases) {
+		if (i == 0 || cases[i-1].value.len != cases[i].value.len) {
+			len_count += 1;
+		}
+	}
+
+	LLVMValueRef data = lb_string_elem(p, tag).value;
+	lbValue len = lb_string_len(p, tag);
+	LLVMValueRef switch_instr = LLVMBuildSwitch(p->builder, len.value, miss->block, cast(unsigned)len_count);
+
+	for (isize lo = 0; lo < cases.count; /**/) {
+		isize hi = lo+1;
+		while (hi < cases.count && cases[hi].value.len == cases[lo].value.len) {
+			hi += 1;
+		}
+
+		lbBlock *block = lb_create_block(p, "switch.string.len");
+		LLVMAddCase(switch_instr, LLVMConstInt(lb_type(p->module, t_int), cast(u64)cases[lo].value.len, false), block->block);
+		lb_start_block(p, block);
+		lb_build_string_switch_group(p, data, slice(cases, lo, hi), miss);
+
+		lo = hi;
+	}
+}
 
 gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *scope) {
 	lb_open_scope(p, scope);
@@ -1949,6 +2210,7 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 
 	bool default_found = false;
 	bool is_trivial = lb_switch_stmt_can_be_trivial_jump_table(ss, &default_found);
+	bool is_string_dispatch = !is_trivial && lb_switch_stmt_is_constant_string_switch(ss);
 
 	auto body_blocks = slice_make<lbBlock *>(permanent_allocator(), body->stmts.count);
 	for_array(i, body->stmts) {
@@ -1974,9 +2236,14 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 					bn = gb_string_appendc(bn, "..");
 				}
 
-				Ast *expr = cc->list[i];
+				Ast *expr = unparen_expr(cc->list[i]);
 				if (expr->tav.mode == Addressing_Type) {
 					bn = write_type_to_string(bn, expr->tav.type, false);
+				} else if (is_ast_range(expr)) {
+					ast_node(ie, BinaryExpr, expr);
+					bn = write_exact_value_to_string(bn, ie->left->tav.value, 1024);
+					bn = gb_string_append_length(bn, ie->op.string.text, ie->op.string.len);
+					bn = write_exact_value_to_string(bn, ie->right->tav.value, 1024);
 				} else {
 					ExactValue value = expr->tav.value;
 					if (is_type_rune(expr->tav.type) && value.kind == ExactValue_Integer) {
@@ -2001,12 +2268,24 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 
 
 	LLVMValueRef switch_instr = nullptr;
+	PtrSet<LLVMValueRef> switch_case_values = {};
+	defer (ptr_set_destroy(&switch_case_values));
 	if (is_trivial) {
 		isize num_cases = 0;
 		for (Ast *clause : body->stmts) {
 			ast_node(cc, CaseClause, clause);
-			num_cases += cc->list.count;
+			for (Ast *expr : cc->list) {
+				i64 lo = 0;
+				i64 hi = 0;
+				expr = unparen_expr(expr);
+				if (is_ast_range(expr) && lb_switch_case_constant_range(expr, &lo, &hi)) {
+					num_cases += cast(isize)(cast(u64)hi - cast(u64)lo);
+				} else {
+					num_cases += 1;
+				}
+			}
 		}
+		ptr_set_init(&switch_case_values, num_cases);
 
 		LLVMBasicBlockRef end_block = done->block;
 		if (default_block) {
@@ -2014,7 +2293,10 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 		}
 
 		switch_instr = LLVMBuildSwitch(p->builder, tag.value, end_block, cast(unsigned)num_cases);
+	} else if (is_string_dispatch) {
+		lb_build_constant_string_switch(p, ss, tag, body_blocks, default_block ? default_block : done);
 	}
+	bool is_dispatched = switch_instr != nullptr || is_string_dispatch;
 
 
 	for_array(i, body->stmts) {
@@ -2032,7 +2314,7 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 			default_clause = clause;
 			default_stmts = cc->stmts;
 			default_fall  = fall;
-			if (switch_instr == nullptr) {
+			if (!is_dispatched) {
 				default_block = body;
 			} else {
 				GB_ASSERT(default_block != nullptr);
@@ -2048,6 +2330,21 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 		for (Ast *expr : cc->list) {
 			expr = unparen_expr(expr);
 
+			if (switch_instr != nullptr && is_ast_range(expr)) {
+				i64 lo = 0;
+				i64 hi = 0;
+				bool ok = lb_switch_case_constant_range(expr, &lo, &hi);
+				GB_ASSERT(ok);
+				for (i64 v = lo; v < hi; v++) {
+					lbValue on_val = lb_const_value(p->module, tag.type, exact_value_i64(v));
+					GB_ASSERT(LLVMIsConstant(on_val.value));
+					// NOTE: overlapping cases are an error in the checker, but the first one would win
+					if (!ptr_set_update(&switch_case_values, on_val.value)) {
+						LLVMAddCase(switch_instr, on_val.value, body->block);
+					}
+				}
+				continue;
+			}
 			if (switch_instr != nullptr) {
 				lbValue on_val = {};
 				if (expr->tav.mode == Addressing_Type) {
@@ -2063,7 +2360,12 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 				}
 
 				GB_ASSERT(LLVMIsConstant(on_val.value));
-				LLVMAddCase(switch_instr, on_val.value, body->block);
+				if (!ptr_set_update(&switch_case_values, on_val.value)) {
+					LLVMAddCase(switch_instr, on_val.value, body->block);
+				}
+				continue;
+			}
+			if (is_string_dispatch) {
 				continue;
 			}
 
@@ -2108,13 +2410,13 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 		lb_pop_target_list(p);
 
 		lb_emit_jump(p, done);
-		if (switch_instr == nullptr) {
+		if (!is_dispatched) {
 			lb_start_block(p, next_cond);
 		}
 	}
 
 	if (default_block != nullptr) {
-		if (switch_instr == nullptr) {
+		if (!is_dispatched) {
 			lb_emit_jump(p, default_block);
 		}
 		lb_start_block(p, default_block);
@@ -2424,6 +2726,16 @@ gb_internal void lb_build_static_variables(lbProcedure *p, AstValueDecl *vd) {
 		GB_ASSERT(e->flags & EntityFlag_Static);
 		String name = e->token.string;
 
+		if (p->target_clone.len != 0) {
+			// NOTE: all @(target_clones) bodies share the variables of whichever body was built first
+			rw_mutex_shared_lock(&p->module->values_mutex);
+			lbValue *found = map_get(&p->module->values, e);
+			rw_mutex_shared_unlock(&p->module->values_mutex);
+			if (found != nullptr) {
+				continue;
+			}
+		}
+
 		if (vd->values.count > 0) {
 			GB_ASSERT(vd->names.count == vd->values.count);
 			Ast *ast_value = vd->values[i];
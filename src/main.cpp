@@ -21,21 +21,23 @@ gb_internal void init_global_thread_pool(void) {
 gb_internal bool thread_pool_add_task(WorkerTaskProc *proc, void *data) {
 	return thread_pool_add_task(&global_thread_pool, proc, data);
 }
+gb_internal bool thread_pool_add_task_with_cost(WorkerTaskProc *proc, void *data, i64 cost) {
+	return thread_pool_add_task_with_cost(&global_thread_pool, proc, data, cost);
+}
 gb_internal void thread_pool_wait(void) {
 	thread_pool_wait(&global_thread_pool);
 }
 
+#include "trace.cpp"
 
 gb_internal i64 PRINT_PEAK_USAGE(void) {
 	if (build_context.show_more_timings) {
-	#if defined(GB_SYSTEM_WINDOWS)
-		PROCESS_MEMORY_COUNTERS p = {sizeof(p)};
-		if (GetProcessMemoryInfo(GetCurrentProcess(), &p, sizeof(p))) {
+		i64 peak = platform_peak_resident_memory();
+		if (peak >= 0) {
 			gb_printf("\n");
-			gb_printf("Peak Memory Size: %.3f MiB\n", (cast(f64)p.PeakWorkingSetSize) / cast(f64)(1024ull * 1024ull));
-			return cast(i64)p.PeakWorkingSetSize;
+			gb_printf("Peak Memory Size: %.3f MiB\n", cast(f64)peak / cast(f64)(1024ull * 1024ull));
+			return peak;
 		}
-	#endif
 	}
 	return 0;
 }
@@ -56,6 +58,8 @@ gb_internal void debugf(char const *fmt, ...) {
 }
 
 gb_global Timings global_timings = {0};
+gb_global MemoryStats global_memory_stats = {};
+#define MEMORY_STATS_NEXT_PHASE(label) memory_stats_next_phase(&global_memory_stats, &global_thread_pool, label, build_context.show_memory)
 
 #if defined(GB_SYSTEM_WINDOWS)
 #include "llvm-c/Types.h"
@@ -71,6 +75,7 @@ gb_global Timings global_timings = {0};
 #include "asm_tables.cpp"
 
 #include "parser.cpp"
+#include "ast_snapshot.cpp"
 #include "checker.cpp"
 #include "docs.cpp"
 
@@ -82,6 +87,7 @@ gb_global Timings global_timings = {0};
 #include "llvm_backend.cpp"
 
 #include "bug_report.cpp"
+#include "serve.cpp"
 
 // NOTE(bill): 'name' is used in debugging and profiling modes
 gb_internal i32 system_exec_command_line_app_internal(bool exit_on_err, char const *name, char const *fmt, va_list va) {
@@ -361,6 +367,8 @@ gb_internal void usage(String argv0, String argv1 = {}) {
 	print_usage_line(1, "version           Prints version.");
 	print_usage_line(1, "report            Prints information useful to reporting a bug.");
 	print_usage_line(1, "root              Prints the root path where Odin looks for the builtin collections.");
+	print_usage_line(1, "serve             Runs a compiler server that keeps parsed packages in memory between commands.");
+	print_usage_line(1, "                  Commands are forwarded to it when ODIN_SERVE_SOCKET is set (Unix only).");
 	print_usage_line(0, "");
 	print_usage_line(0, "For further details on a command, invoke command help:");
 	print_usage_line(1, "e.g. `odin build -help` or `odin help build`");
@@ -378,9 +386,11 @@ enum BuildFlagKind {
 	BuildFlag_ShowUnused,
 	BuildFlag_ShowUnusedWithLocation,
 	BuildFlag_ShowMoreTimings,
+	BuildFlag_ShowMemory,
 	BuildFlag_ShowImportGraph,
 	BuildFlag_ExportTimings,
 	BuildFlag_ExportTimingsFile,
+	BuildFlag_ExportTrace,
 	BuildFlag_ExportDependencies,
 	BuildFlag_ExportDependenciesFile,
 	BuildFlag_ShowSystemCalls,
@@ -405,6 +415,10 @@ enum BuildFlagKind {
 	BuildFlag_Linker,
 	BuildFlag_UseSeparateModules,
 	BuildFlag_UseSingleModule,
+	BuildFlag_ObjectCache,
+	BuildFlag_ObjectCacheLimit,
+	BuildFlag_AstCache,
+	BuildFlag_SplitDwarf,
 	BuildFlag_NoThreadedChecker,
 	BuildFlag_ShowDebugMessages,
 	BuildFlag_DidYouMeanLimit,
@@ -490,15 +504,23 @@ enum BuildFlagKind {
 	BuildFlag_InternalIgnorePanic,
 	BuildFlag_InternalModulePerFile,
 	BuildFlag_InternalCached,
+	BuildFlag_InternalCachedContent,
+	BuildFlag_InternalMapFiles,
+	BuildFlag_InternalScheduleByCost,
+	BuildFlag_InternalSplitPackages,
+	BuildFlag_InternalNoLoadSections,
 	BuildFlag_InternalNoInline,
 	BuildFlag_InternalByValue,
 	BuildFlag_InternalWeakMonomorphization,
 	BuildFlag_InternalLLVMVerification,
 	BuildFlag_InternalLLVMNoSROA,
 	BuildFlag_InternalEnableRVO,
+	BuildFlag_InternalPoisonTemporaryMemory,
 
 	BuildFlag_Sanitize,
 	BuildFlag_LTO,
+	BuildFlag_PGOGenerate,
+	BuildFlag_PGOUse,
 
 #if defined(GB_SYSTEM_WINDOWS)
 	BuildFlag_IgnoreVsSearch,
@@ -521,6 +543,7 @@ enum BuildFlagParamKind {
 	BuildFlagParam_Integer,
 	BuildFlagParam_Float,
 	BuildFlagParam_String,
+	BuildFlagParam_OptionalString, // `-flag` or `-flag:<string>`
 
 	BuildFlagParam_COUNT,
 };
@@ -636,9 +659,11 @@ gb_internal bool parse_build_flags(Array<String> args) {
 	add_flag(&build_flags, BuildFlag_OptimizationMode,        str_lit("o"),                         BuildFlagParam_String,  Command__does_build);
 	add_flag(&build_flags, BuildFlag_ShowTimings,             str_lit("show-timings"),              BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_ShowMoreTimings,         str_lit("show-more-timings"),         BuildFlagParam_None,    Command__does_check);
+	add_flag(&build_flags, BuildFlag_ShowMemory,              str_lit("show-memory"),               BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_ShowImportGraph,         str_lit("show-import-graph"),         BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_ExportTimings,           str_lit("export-timings"),            BuildFlagParam_String,  Command__does_check);
 	add_flag(&build_flags, BuildFlag_ExportTimingsFile,       str_lit("export-timings-file"),       BuildFlagParam_String,  Command__does_check);
+	add_flag(&build_flags, BuildFlag_ExportTrace,             str_lit("export-trace"),              BuildFlagParam_String,  Command__does_check);
 	add_flag(&build_flags, BuildFlag_ExportDependencies,      str_lit("export-dependencies"),       BuildFlagParam_String,  Command__does_build);
 	add_flag(&build_flags, BuildFlag_ExportDependenciesFile,  str_lit("export-dependencies-file"),  BuildFlagParam_String,  Command__does_build);
 	add_flag(&build_flags, BuildFlag_ShowUnused,              str_lit("show-unused"),               BuildFlagParam_None,    Command_check);
@@ -652,7 +677,7 @@ gb_internal bool parse_build_flags(Array<String> args) {
 	add_flag(&build_flags, BuildFlag_KeepExecutable,          str_lit("keep-executable"),           BuildFlagParam_None,    Command__does_build | Command_test);
 	add_flag(&build_flags, BuildFlag_Target,                  str_lit("target"),                    BuildFlagParam_String,  Command__does_check);
 	add_flag(&build_flags, BuildFlag_Subtarget,               str_lit("subtarget"),                 BuildFlagParam_String,  Command__does_check);
-	add_flag(&build_flags, BuildFlag_Debug,                   str_lit("debug"),                     BuildFlagParam_None,    Command__does_check);
+	add_flag(&build_flags, BuildFlag_Debug,                   str_lit("debug"),                     BuildFlagParam_OptionalString, Command__does_check);
 	add_flag(&build_flags, BuildFlag_DisableAssert,           str_lit("disable-assert"),            BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_NoBoundsCheck,           str_lit("no-bounds-check"),           BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_WebkitSwitchWorkaround,  str_lit("webkit-switch-workaround"),  BuildFlagParam_None,    Command__does_check);
@@ -666,6 +691,10 @@ gb_internal bool parse_build_flags(Array<String> args) {
 	add_flag(&build_flags, BuildFlag_Linker,                  str_lit("linker"),                    BuildFlagParam_String,  Command__does_build);
 	add_flag(&build_flags, BuildFlag_UseSeparateModules,      str_lit("use-separate-modules"),      BuildFlagParam_None,    Command__does_build);
 	add_flag(&build_flags, BuildFlag_UseSingleModule,         str_lit("use-single-module"),         BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_ObjectCache,             str_lit("object-cache"),              BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_ObjectCacheLimit,        str_lit("object-cache-limit"),        BuildFlagParam_Integer, Command__does_build);
+	add_flag(&build_flags, BuildFlag_AstCache,                str_lit("ast-cache"),                 BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_SplitDwarf,              str_lit("split-dwarf"),               BuildFlagParam_None,    Command__does_build);
 	add_flag(&build_flags, BuildFlag_NoThreadedChecker,       str_lit("no-threaded-checker"),       BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_ShowDebugMessages,       str_lit("show-debug-messages"),       BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_DidYouMeanLimit,         str_lit("did-you-mean-limit"),        BuildFlagParam_Integer, Command__does_check);
@@ -749,16 +778,24 @@ gb_internal bool parse_build_flags(Array<String> args) {
 	add_flag(&build_flags, BuildFlag_InternalIgnorePanic,     str_lit("internal-ignore-panic"),     BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalModulePerFile,   str_lit("internal-module-per-file"),  BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalCached,          str_lit("internal-cached"),           BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_InternalCachedContent,   str_lit("internal-cached-content"),   BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_InternalMapFiles,        str_lit("internal-map-files"),        BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_InternalScheduleByCost,  str_lit("internal-schedule-by-cost"), BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_InternalSplitPackages,   str_lit("internal-split-packages"),   BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_InternalNoLoadSections,  str_lit("internal-no-load-sections"), BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalNoInline,        str_lit("internal-no-inline"),        BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalByValue,         str_lit("internal-by-value"),         BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalWeakMonomorphization, str_lit("internal-weak-monomorphization"), BuildFlagParam_None, Command_all);
 	add_flag(&build_flags, BuildFlag_InternalLLVMVerification, str_lit("internal-ignore-llvm-verification"), BuildFlagParam_None, Command_all);
 	add_flag(&build_flags, BuildFlag_InternalLLVMNoSROA,      str_lit("internal-llvm-no-sroa"), BuildFlagParam_None, Command_all);
 	add_flag(&build_flags, BuildFlag_InternalEnableRVO,       str_lit("internal-enable-rvo"), BuildFlagParam_None, Command_all);
+	add_flag(&build_flags, BuildFlag_InternalPoisonTemporaryMemory, str_lit("internal-poison-temporary-memory"), BuildFlagParam_None, Command_all);
 
 
 	add_flag(&build_flags, BuildFlag_Sanitize,                str_lit("sanitize"),                  BuildFlagParam_String,  Command__does_build, true);
 	add_flag(&build_flags, BuildFlag_LTO,                     str_lit("lto"),                       BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_PGOGenerate,             str_lit("pgo-generate"),              BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_PGOUse,                  str_lit("pgo-use"),                   BuildFlagParam_String,  Command__does_build);
 
 
 #if defined(GB_SYSTEM_WINDOWS)
@@ -837,6 +874,8 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							gb_printf_err("Flag '%.*s' was not expecting a parameter '%.*s'\n", LIT(name), LIT(param));
 							bad_flags = true;
 						}
+					} else if (param.len == 0 && bf.param_kind == BuildFlagParam_OptionalString) {
+						ok = true;
 					} else if (param.len == 0) {
 						gb_printf_err("Flag missing for '%.*s'\n", LIT(name));
 						bad_flags = true;
@@ -865,7 +904,8 @@ gb_internal bool parse_build_flags(Array<String> args) {
 						case BuildFlagParam_Float: {
 							value = exact_value_float_from_string(param);
 						} break;
-						case BuildFlagParam_String: {
+						case BuildFlagParam_String:
+						case BuildFlagParam_OptionalString: {
 							value = exact_value_string(param);
 							if (value.kind == ExactValue_String) {
 								String s = value.value_string;
@@ -914,6 +954,13 @@ gb_internal bool parse_build_flags(Array<String> args) {
 								ok = false;
 							}
 							break;
+						case BuildFlagParam_OptionalString:
+							if (value.kind != ExactValue_String && value.kind != ExactValue_Invalid) {
+								gb_printf_err("%.*s expected a string, got %.*s\n", LIT(name), LIT(param));
+								bad_flags = true;
+								ok = false;
+							}
+							break;
 						}
 
 						if (ok) switch (bf.kind) {
@@ -982,6 +1029,11 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							build_context.show_timings = true;
 							build_context.show_more_timings = true;
 							break;
+						case BuildFlag_ShowMemory:
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.show_timings = true;
+							build_context.show_memory = true;
+							break;
 						case BuildFlag_ShowImportGraph:
 							GB_ASSERT(value.kind == ExactValue_Invalid);
 							build_context.show_import_graph = true;
@@ -1018,6 +1070,19 @@ gb_internal bool parse_build_flags(Array<String> args) {
 
 							break;
 						}
+						case BuildFlag_ExportTrace: {
+							GB_ASSERT(value.kind == ExactValue_String);
+
+							String export_path = string_trim_whitespace(value.value_string);
+							if (is_build_flag_path_valid(export_path)) {
+								build_context.export_trace_file = path_to_full_path(heap_allocator(), export_path);
+							} else {
+								gb_printf_err("Invalid -export-trace path, got %.*s\n", LIT(export_path));
+								bad_flags = true;
+							}
+
+							break;
+						}
 						case BuildFlag_ExportDependencies: {
 							GB_ASSERT(value.kind == ExactValue_String);
 
@@ -1077,7 +1142,7 @@ gb_internal bool parse_build_flags(Array<String> args) {
 						}
 						case BuildFlag_ThreadCount: {
 							GB_ASSERT(value.kind == ExactValue_Integer);
-							isize count = cast(isize)big_int_to_i64(&value.value_integer);
+							isize count = cast(isize)exact_value_to_i64(value);
 							if (count <= 0) {
 								gb_printf_err("%.*s expected a positive non-zero number, got %.*s\n", LIT(name), LIT(param));
 								build_context.thread_count = 1;
@@ -1344,6 +1409,19 @@ gb_internal bool parse_build_flags(Array<String> args) {
 
 						case BuildFlag_Debug:
 							build_context.ODIN_DEBUG = true;
+							if (value.kind == ExactValue_String) {
+								if (value.value_string == "full") {
+									build_context.debug_info_kind = DebugInfo_Full;
+								} else if (value.value_string == "line-tables") {
+									build_context.debug_info_kind = DebugInfo_LineTables;
+								} else {
+									gb_printf_err("Invalid debug information kind for -debug:<string>, got %.*s\n", LIT(value.value_string));
+									gb_printf_err("Valid kinds:\n");
+									gb_printf_err("\tfull\n");
+									gb_printf_err("\tline-tables\n");
+									bad_flags = true;
+								}
+							}
 							break;
 						case BuildFlag_DisableAssert:
 							build_context.ODIN_DISABLE_ASSERT = true;
@@ -1414,6 +1492,30 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							}
 							build_context.use_single_module = true;
 							break;
+						case BuildFlag_ObjectCache:
+							if (build_context.use_single_module) {
+								gb_printf_err("-object-cache cannot be used with -use-single-module\n");
+								bad_flags = true;
+							}
+							build_context.object_cache = true;
+							build_context.use_separate_modules = true;
+							break;
+						case BuildFlag_ObjectCacheLimit: {
+							i64 limit = exact_value_to_i64(value);
+							if (limit <= 0) {
+								gb_printf_err("-%.*s must be greater than 0\n", LIT(bf.name));
+								bad_flags = true;
+							} else {
+								build_context.object_cache_limit_mib = limit;
+							}
+							break;
+						}
+						case BuildFlag_AstCache:
+							build_context.ast_cache = true;
+							break;
+						case BuildFlag_SplitDwarf:
+							build_context.split_dwarf = true;
+							break;
 						case BuildFlag_NoThreadedChecker:
 							build_context.no_threaded_checker = true;
 							break;
@@ -1424,7 +1526,7 @@ gb_internal bool parse_build_flags(Array<String> args) {
 						case BuildFlag_DidYouMeanLimit:
 							{
 								GB_ASSERT(value.kind == ExactValue_Integer);
-								isize count = cast(isize)big_int_to_i64(&value.value_integer);
+								isize count = cast(isize)exact_value_to_i64(value);
 								if (count <= 0) {
 									gb_printf_err("%.*s expected a positive non-zero number, got %.*s\n", LIT(name), LIT(param));
 									build_context.did_you_mean_limit = DEFAULT_DID_YOU_MEAN_LIMIT;
@@ -1692,7 +1794,7 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							break;
 
 						case BuildFlag_MaxErrorCount: {
-							i64 count = big_int_to_i64(&value.value_integer);
+							i64 count = exact_value_to_i64(value);
 							if (count <= 0) {
 								gb_printf_err("-%.*s must be greater than 0", LIT(bf.name));
 								bad_flags = true;
@@ -1772,6 +1874,23 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							build_context.cached = true;
 							build_context.use_separate_modules = true;
 							break;
+						case BuildFlag_InternalCachedContent:
+							build_context.cached = true;
+							build_context.build_cache_data.content_hash = true;
+							build_context.use_separate_modules = true;
+							break;
+						case BuildFlag_InternalMapFiles:
+							build_context.internal_map_files = true;
+							break;
+						case BuildFlag_InternalScheduleByCost:
+							build_context.internal_schedule_by_cost = true;
+							break;
+						case BuildFlag_InternalSplitPackages:
+							build_context.internal_split_packages = true;
+							break;
+						case BuildFlag_InternalNoLoadSections:
+							build_context.internal_no_load_sections = true;
+							break;
 						case BuildFlag_InternalNoInline:
 							build_context.internal_no_inline = true;
 							break;
@@ -1790,6 +1909,9 @@ gb_internal bool parse_build_flags(Array<String> args) {
 						case BuildFlag_InternalEnableRVO:
 							build_context.enable_rvo = true;
 							break;
+						case BuildFlag_InternalPoisonTemporaryMemory:
+							global_arena_poison_rewound_memory = true;
+							break;
 
 
 						case BuildFlag_Sanitize:
@@ -1844,6 +1966,27 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							}
 							break;
 
+						case BuildFlag_PGOGenerate:
+							build_context.pgo_generate = true;
+							break;
+
+						case BuildFlag_PGOUse: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String path = string_trim_whitespace(value.value_string);
+							if (!is_build_flag_path_valid(path)) {
+								gb_printf_err("Invalid -pgo-use path, got %.*s\n", LIT(path));
+								bad_flags = true;
+								break;
+							}
+							if (!gb_file_exists(cast(char const *)path.text)) {
+								gb_printf_err("Invalid -pgo-use path %.*s, file does not exist\n", LIT(path));
+								bad_flags = true;
+								break;
+							}
+							build_context.pgo_use_path = path_to_full_path(heap_allocator(), path);
+							break;
+						}
+
 
 					#if defined(GB_SYSTEM_WINDOWS)
 						case BuildFlag_IgnoreVsSearch: {
@@ -2099,6 +2242,27 @@ gb_internal void timings_export_all(Timings *t, Checker *c, bool timings_are_fin
 
 		gb_fprintf(&f, "\t],\n");
 
+		if (build_context.show_memory) {
+			gb_fprintf(&f, "\t\"memory\": [\n");
+			for (MemorySnapshot const &s : global_memory_stats.snapshots) {
+				gb_fprintf(&f, "\t\t{\"name\": \"%.*s\", \"permanent_arena\": %td, \"temporary_arena\": %td, \"heap\": %td, \"other_malloc\": %lld, \"peak_rss\": %lld, \"threads\": [",
+				    LIT(s.label),
+				    s.arena_committed[ThreadArena_Permanent],
+				    s.arena_committed[ThreadArena_Temporary],
+				    s.heap_allocated,
+				    cast(long long)memory_snapshot_other_malloc(s),
+				    cast(long long)s.peak_resident);
+				for (isize i = 0; i < s.thread_arena_committed.count; i += ThreadArena_COUNT) {
+					gb_fprintf(&f, "%s{\"permanent_arena\": %td, \"temporary_arena\": %td}",
+					    i == 0 ? "" : ", ",
+					    s.thread_arena_committed[i + ThreadArena_Permanent],
+					    s.thread_arena_committed[i + ThreadArena_Temporary]);
+				}
+				gb_fprintf(&f, "]},\n");
+			}
+			gb_fprintf(&f, "\t],\n");
+		}
+
 		gb_fprintf(&f, "}\n");
 	} else if (build_context.export_timings_format == TimingsExportCSV) {
 		/*
@@ -2331,10 +2495,54 @@ gb_internal void show_timings(Checker *c, Timings *t) {
 		}
 	}
 
+	if (build_context.show_memory) {
+		memory_stats_next_phase(&global_memory_stats, &global_thread_pool, {}, true);
+	}
+
 	timings_print_all(t);
 
 	PRINT_PEAK_USAGE();
 
+	if (build_context.show_memory) {
+		memory_stats_print_all(&global_memory_stats);
+	}
+
+	if (build_context.show_more_timings) {
+		LoadedFileStats *stats = &global_loaded_file_stats;
+		f64 load_time = cast(f64)stats->total_time.load() / cast(f64)t->freq;
+		isize file_count = stats->file_count.load();
+		gb_printf_err("\nLoaded Files - %td (%td mapped, %td copied), %.3f MiB in %.3f ms\n",
+		              file_count, stats->mapped_count.load(), file_count - stats->mapped_count.load(),
+		              cast(f64)stats->total_bytes.load() / cast(f64)(1024ull * 1024ull),
+		              1000.0*load_time);
+	}
+
+	if (build_context.object_cache) {
+		BuildCacheData *cache = &build_context.build_cache_data;
+		gb_printf_err("\nObject Cache - %td hits, %td misses\n", cache->object_cache_hits.load(), cache->object_cache_misses.load());
+	}
+
+	if (build_context.ast_cache) {
+		BuildCacheData *cache = &build_context.build_cache_data;
+		gb_printf_err("\nAST Cache - %td hits, %td misses\n", cache->ast_cache_hits.load(), cache->ast_cache_misses.load());
+	}
+
+	if (build_context.ODIN_DEBUG && (build_context.command_kind & Command__does_build) != 0) {
+		// NOTE: compare against a -debug:full build of the same project to see what line tables save
+		lbDebugInfoStats *stats = &lb_debug_info_stats;
+		if (build_context.debug_info_kind == DebugInfo_LineTables) {
+			gb_printf_err("\nDebug Info - line tables only, skipped %td variable descriptors and every type descriptor\n", stats->skipped_variables.load());
+		} else {
+			gb_printf_err("\nDebug Info - full, %td type descriptors, %td variable descriptors\n", stats->types.load(), stats->variables.load());
+		}
+
+		String output = path_to_string(heap_allocator(), build_context.build_paths[BuildPath_Output]);
+		i64 output_size = get_file_size(output);
+		if (output_size >= 0) {
+			gb_printf_err("Output Size - %.3f MiB (%lld bytes)\n", cast(f64)output_size / cast(f64)(1024ull * 1024ull), cast(long long)output_size);
+		}
+	}
+
 	if (!(build_context.export_timings_format == TimingsExportUnspecified)) {
 		timings_export_all(t, c, true);
 	}
@@ -2778,6 +2986,13 @@ gb_internal int print_show_help(String const arg0, String command, String option
 		}
 	}
 
+	if (build) {
+		if (print_flag("-ast-cache")) {
+			print_usage_line(2, "Reuses the parsed form of files in the 'base', 'core' and 'vendor' collections from a previous build.");
+			print_usage_line(2, "Snapshots are stored in '.odin-cache/ast' next to the output, keyed on a hash of the file and the parser settings.");
+		}
+	}
+
 	if (check) {
 		if (print_flag("-bedrock")) {
 			print_usage_line(2, "Disables numerous features. List of disabled features:");
@@ -2834,6 +3049,9 @@ gb_internal int print_show_help(String const arg0, String command, String option
 	if (run_or_build) {
 		if (print_flag("-debug")) {
 			print_usage_line(2, "Enables debug information, and defines the global constant ODIN_DEBUG to be 'true'. Sets -o:none by default.");
+			print_usage_line(2, "Available options:");
+				print_usage_line(3, "-debug:full         Types, variables, procedures and line locations (the default)");
+				print_usage_line(3, "-debug:line-tables  Only procedures and line locations, enough for symbolized stack traces and profilers");
 		}
 	}
 
@@ -2931,6 +3149,12 @@ gb_internal int print_show_help(String const arg0, String command, String option
 			print_usage_line(2, "Specifies the filename for `-export-timings`.");
 			print_usage_line(2, "Example: -export-timings-file:timings.json");
 		}
+
+		if (print_flag("-export-trace:<filename>")) {
+			print_usage_line(2, "Exports what each thread of the compiler did over time in the Chrome Trace Event format.");
+			print_usage_line(2, "The trace can be viewed with chrome://tracing or https://ui.perfetto.dev.");
+			print_usage_line(2, "Example: -export-trace:trace.json");
+		}
 	}
 
 	if (run_or_build) {
@@ -3117,6 +3341,19 @@ gb_internal int print_show_help(String const arg0, String command, String option
 			print_usage_line(2, "The default is -o:minimal. If -debug is set, the default is -o:none.");
 		}
 
+		if (print_flag("-object-cache")) {
+			print_usage_line(2, "Reuses the object file of every build unit whose LLVM module has not changed since a previous build.");
+			print_usage_line(2, "Object files are stored in '.odin-cache/objects' next to the output, keyed on a hash of the module and target.");
+			print_usage_line(2, "This also enables '-use-separate-modules' (if not already set).");
+			print_usage_line(2, "After each build, the least recently used objects are removed until the cache fits in '-object-cache-limit'.");
+		}
+
+		if (print_flag("-object-cache-limit:<integer>")) {
+			print_usage_line(2, "Sets the size in MiB that '-object-cache' keeps the cache directory within.");
+			print_usage_line(2, "The default is 4096. The whole cache can also be removed by deleting '.odin-cache/objects'.");
+			print_usage_line(3, "Example: -object-cache-limit:1024");
+		}
+
 
 		if (print_flag("-source-code-locations:<string>")) {
 			print_usage_line(2, "Processes the file and procedure strings, and line and column numbers, stored with a 'runtime.Source_Code_Location' value.");
@@ -3153,6 +3390,20 @@ gb_internal int print_show_help(String const arg0, String command, String option
 	#endif
 	}
 
+	if (run_or_build) {
+		if (print_flag("-pgo-generate")) {
+			print_usage_line(2, "Instruments the generated code to record an execution profile for profile-guided optimization.");
+			print_usage_line(2, "Running the program writes 'default.profraw', or the file named by the LLVM_PROFILE_FILE environment variable.");
+			print_usage_line(2, "Merge the raw profiles with 'llvm-profdata merge -o <file.profdata>' and pass the result to -pgo-use.");
+		}
+
+		if (print_flag("-pgo-use:<filepath>")) {
+			print_usage_line(2, "Optimizes the generated code using a profile recorded from a -pgo-generate build.");
+			print_usage_line(2, "The profile must have been trained with the same flags and package layout.");
+			print_usage_line(2, "Example: -pgo-use:app.profdata");
+		}
+	}
+
 	if (build) {
 		if (print_flag("-print-linker-flags")) {
 			print_usage_line(2, "Prints the all of the flags/arguments that will be passed to the linker.");
@@ -3169,6 +3420,13 @@ gb_internal int print_show_help(String const arg0, String command, String option
 				print_usage_line(3, "-reloc-mode:dynamic-no-pic");
 		}
 
+		if (print_flag("-split-dwarf")) {
+			print_usage_line(2, "[Linux, FreeBSD, OpenBSD and NetBSD only]");
+			print_usage_line(2, "Requires -debug. Writes the debug information of each module to a .dwo file next to the output,");
+			print_usage_line(2, "leaving only a skeleton compile unit in the object files, which makes linking debug builds faster.");
+			print_usage_line(2, "Code generation is done by clang, or the one pointed to by the ODIN_CLANG_PATH environment variable.");
+		}
+
 		if (print_flag("-stack-protector:<string>")) {
 			print_usage_line(2, "Specifies the stack protector.");
 			print_usage_line(2, "Available options:");
@@ -3229,6 +3487,12 @@ gb_internal int print_show_help(String const arg0, String command, String option
 		if (print_flag("-show-more-timings")) {
 			print_usage_line(2, "Shows an advanced overview of the timings of different stages within the compiler in milliseconds.");
 		}
+
+		if (print_flag("-show-memory")) {
+			print_usage_line(2, "Shows the timings along with the memory in use at the end of each stage within the compiler in MiB:");
+			print_usage_line(3, "the committed permanent and temporary arena memory, also per thread,");
+			print_usage_line(3, "the memory of the heap allocator, the rest of malloc (mostly LLVM), and the peak resident memory.");
+		}
 	}
 
 	if (check_only) {
@@ -3543,15 +3807,15 @@ gb_internal gbFileError write_file_with_stripped_tokens(gbFile *f, AstFile *file
 	u8 const *file_data = file->tokenizer.start;
 	i32 prev_offset = 0;
 	i32 const end_offset = cast(i32)(file->tokenizer.end - file->tokenizer.start);
-	for (Token const &token : file->tokens) {
+	for (PackedToken const &token : file->tokens) {
 		if (token.flags & (TokenFlag_Remove|TokenFlag_Replace)) {
-			i32 offset = token.pos.offset;
+			i32 offset = cast(i32)token.offset;
 			i32 to_write = offset-prev_offset;
 			if (!gb_file_write(f, file_data+prev_offset, to_write)) {
 				return gbFileError_Invalid;
 			}
 			written += to_write;
-			prev_offset = token_pos_end(token).offset;
+			prev_offset = cast(i32)(token.offset + token.len);
 		}
 		if (token.flags & TokenFlag_Replace) {
 			if (token.kind == Token_Ellipsis) {
@@ -3587,7 +3851,7 @@ gb_internal int strip_semicolons(Parser *parser) {
 	for (AstPackage *pkg : parser->packages) {
 		for (AstFile *file : pkg->files) {
 			bool nothing_to_change = true;
-			for (Token const &token : file->tokens) {
+			for (PackedToken const &token : file->tokens) {
 				if (token.flags) {
 					nothing_to_change = false;
 					break;
@@ -3785,7 +4049,7 @@ gb_internal void init_terminal(void) {
 	}
 }
 
-int main(int arg_count, char const **arg_ptr) {
+gb_internal int odin_main(int arg_count, char const **arg_ptr) {
 	if (arg_count < 2) {
 		usage(make_string_c(arg_ptr[0]));
 		return 1;
@@ -4311,6 +4575,9 @@ int main(int arg_count, char const **arg_ptr) {
 	TIME_SECTION("init thread pool");
 	init_global_thread_pool();
 	defer (thread_pool_destroy(&global_thread_pool));
+	defer (if (trace_enabled()) {
+		trace_export_all(&global_timings);
+	});
 
 	TIME_SECTION("init universal");
 	init_universal();
@@ -4328,6 +4595,9 @@ int main(int arg_count, char const **arg_ptr) {
 	if (!init_parser(parser)) {
 		return 1;
 	}
+	if (build_context.ast_cache) {
+		ast_cache_init_directory();
+	}
 	defer (destroy_parser(parser));
 
 	// TODO(jeroen): Remove the `init_filename` param.
@@ -4342,11 +4612,15 @@ int main(int arg_count, char const **arg_ptr) {
 		return 1;
 	}
 
+	// NOTE: in an `odin serve` worker, this keeps the parsed files and only returns in a fork per request
+	serve_worker_loop(parser);
+
 	checker->parser = parser;
 	init_checker(checker);
 	defer (destroy_checker(checker)); // this is here because of a `goto`
 
-	if (build_context.cached && parser->total_seen_load_directive_count.load() == 0) {
+	// NOTE: the content hash manifest records the `#load` inputs, so it can be checked before the `#load` directives have been seen
+	if (build_context.cached && (build_context.build_cache_data.content_hash || parser->total_seen_load_directive_count.load() == 0)) {
 		MAIN_TIME_SECTION("check cached build (pre-semantic check)");
 		if (try_cached_build(checker, args)) {
 			goto end_of_code_gen;
@@ -4542,3 +4816,14 @@ end_of_code_gen:;
 	}
 	return 0;
 }
+
+int main(int arg_count, char const **arg_ptr) {
+	if (arg_count >= 2 && gb_strcmp(arg_ptr[1], "serve") == 0) {
+		return serve_main(arg_count, arg_ptr);
+	}
+	int exit_code = 0;
+	if (serve_forward(arg_count, arg_ptr, &exit_code)) {
+		return exit_code;
+	}
+	return odin_main(arg_count, arg_ptr);
+}
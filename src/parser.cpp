@@ -838,8 +838,7 @@ gb_internal Ast *ast_matrix_index_expr(AstFile *f, Ast *expr, Token open, Token
 gb_internal Ast *ast_ident(AstFile *f, Token token) {
 	Ast *result = alloc_ast_node(f, Ast_Ident);
 	result->Ident.token    = token;
-	result->Ident.hash     = string_hash(token.string);
-	result->Ident.interned = string_interner_insert(token.string);
+	result->Ident.interned = string_interner_insert(token.string, 0, &result->Ident.hash);
 	return result;
 }
 
@@ -1525,9 +1524,93 @@ gb_internal Ast *ast_attribute(AstFile *f, Token token, Token open, Token close,
 }
 
 
+gb_internal PackedToken pack_token(Token const &token) {
+	PackedToken packed = {};
+	packed.offset = cast(u32)token.pos.offset;
+	packed.len    = cast(u32)token.string.len;
+	packed.kind   = token.kind;
+	packed.flags  = token.flags;
+	return packed;
+}
+
+gb_internal void ast_file_init_line_offsets(AstFile *f) {
+	u8 const *start = f->tokenizer.start;
+	u8 const *end   = f->tokenizer.end;
+	array_init(&f->line_offsets, ast_allocator(f), 0, gb_max(f->tokenizer.line_count, 1));
+	array_add(&f->line_offsets, cast(u32)0);
+	for (u8 const *p = start; p < end; /**/) {
+		u8 const *nl = cast(u8 const *)gb_memchr(p, '\n', end-p);
+		if (nl == nullptr) {
+			break;
+		}
+		p = nl+1;
+		array_add(&f->line_offsets, cast(u32)(p-start));
+	}
+}
+
+// Rebuilds the full `Token` from `f->tokens[index]`
+// NOTE: The parser unpacks tokens mostly in order, so the line and column of the previous unpack are used
+// as the starting point rather than searching the line table from the beginning.
+gb_internal Token ast_file_unpack_token(AstFile *f, isize index) {
+	PackedToken packed = f->tokens[index];
+	u32 offset = packed.offset;
+
+	Token token = {};
+	token.kind        = packed.kind;
+	token.flags       = packed.flags;
+	token.string.text = f->tokenizer.start + offset;
+	token.string.len  = packed.len;
+	if (token.kind == Token_Semicolon && f->tokenizer.start + offset == f->tokenizer.end) {
+		// NOTE: the semicolon implicitly inserted at the end of the file
+		token.string = str_lit("\n");
+	}
+
+	Array<u32> const &lines = f->line_offsets;
+	isize prev_line = f->unpack_line_hint;
+	isize line = prev_line;
+	while (line+1 < lines.count && lines[line+1] <= offset) {
+		line++;
+	}
+	while (line > 0 && lines[line] > offset) {
+		line--;
+	}
+
+	u32 from = lines[line];
+	i32 runes_before = 0;
+	if (line == prev_line && from <= f->unpack_column_offset && f->unpack_column_offset <= offset) {
+		from = f->unpack_column_offset;
+		runes_before = f->unpack_column;
+	}
+	u8 const *p = f->tokenizer.start + from;
+	u8 const *q = f->tokenizer.start + offset;
+	while (p < q) {
+		if (*p < 0x80) {
+			p++;
+		} else {
+			Rune r = 0;
+			p += utf8_decode(p, f->tokenizer.end-p, &r);
+		}
+		runes_before++;
+	}
+
+	f->unpack_line_hint     = line;
+	f->unpack_column_offset = offset;
+	f->unpack_column        = runes_before;
+
+	token.pos.file_id = f->id;
+	token.pos.offset  = cast(i32)offset;
+	token.pos.line    = cast(i32)line + 1;
+	token.pos.column  = runes_before + 1;
+	if (offset > 0 && f->tokenizer.start + offset == f->tokenizer.end) {
+		// NOTE: the tokenizer does not advance the column when it reaches the end of the file
+		token.pos.column = runes_before;
+	}
+	return token;
+}
+
 gb_internal bool next_token0(AstFile *f) {
 	if (f->curr_token_index+1 < f->tokens.count) {
-		f->curr_token = f->tokens[++f->curr_token_index];
+		f->curr_token = ast_file_unpack_token(f, ++f->curr_token_index);
 		return true;
 	}
 	syntax_error(f->curr_token, "Token is EOF");
@@ -1640,25 +1723,21 @@ gb_internal Token advance_token(AstFile *f) {
 
 gb_internal Token peek_token(AstFile *f) {
 	for (isize i = f->curr_token_index+1; i < f->tokens.count; i++) {
-		Token tok = f->tokens[i];
-		if (tok.kind == Token_Comment) {
+		if (f->tokens[i].kind == Token_Comment) {
 			continue;
 		}
-		return tok;
+		return ast_file_unpack_token(f, i);
 	}
 	return {};
 }
 
 gb_internal Token peek_token_n(AstFile *f, isize n) {
-	Token found = {};
 	for (isize i = f->curr_token_index+1; i < f->tokens.count; i++) {
-		Token tok = f->tokens[i];
-		if (tok.kind == Token_Comment) {
+		if (f->tokens[i].kind == Token_Comment) {
 			continue;
 		}
-		found = tok;
 		if (n-- == 0) {
-			return found;
+			return ast_file_unpack_token(f, i);
 		}
 	}
 	return {};
@@ -1912,8 +1991,10 @@ gb_internal Token expect_closing(AstFile *f, TokenKind kind, String const &conte
 
 gb_internal void assign_removal_flag_to_semicolon(AstFile *f) {
 	// NOTE(bill): this is used for rewriting files to strip unneeded semicolons
-	Token *prev_token = &f->tokens[f->prev_token_index];
-	Token *curr_token = &f->tokens[f->curr_token_index];
+	Token prev_token_ = ast_file_unpack_token(f, f->prev_token_index);
+	Token curr_token_ = ast_file_unpack_token(f, f->curr_token_index);
+	Token *prev_token = &prev_token_;
+	Token *curr_token = &curr_token_;
 	GB_ASSERT(prev_token->kind == Token_Semicolon);
 	if (prev_token->string != ";") {
 		return;
@@ -1937,7 +2018,7 @@ gb_internal void assign_removal_flag_to_semicolon(AstFile *f) {
 	if (build_context.strict_style || (ast_file_vet_flags(f) & VetFlag_Semicolon)) {
 		syntax_error(*prev_token, "Found unneeded semicolon");
 	}
-	prev_token->flags |= TokenFlag_Remove;
+	f->tokens[f->prev_token_index].flags |= TokenFlag_Remove;
 }
 
 gb_internal void expect_semicolon(AstFile *f) {
@@ -2214,7 +2295,7 @@ gb_internal Ast *convert_stmt_to_expr(AstFile *f, Ast *statement, String const &
 	syntax_error(f->curr_token, "Expected '%.*s', found a simple statement.", LIT(kind));
 	Token end = f->curr_token;
 	if (f->tokens.count < f->curr_token_index) {
-		end = f->tokens[f->curr_token_index+1];
+		end = ast_file_unpack_token(f, f->curr_token_index+1);
 	}
 	return ast_bad_expr(f, f->curr_token, end);
 }
@@ -5254,7 +5335,7 @@ if_else_chain:;
 			break;
 		default:
 			syntax_error(f->curr_token, "Expected if statement block statement");
-			else_stmt = ast_bad_stmt(f, f->curr_token, f->tokens[f->curr_token_index+1]);
+			else_stmt = ast_bad_stmt(f, f->curr_token, ast_file_unpack_token(f, f->curr_token_index+1));
 			break;
 		}
 	}
@@ -5312,7 +5393,7 @@ gb_internal Ast *parse_when_stmt(AstFile *f) {
 		} break;
 		default:
 			syntax_error(f->curr_token, "Expected when statement block statement");
-			else_stmt = ast_bad_stmt(f, f->curr_token, f->tokens[f->curr_token_index+1]);
+			else_stmt = ast_bad_stmt(f, f->curr_token, ast_file_unpack_token(f, f->curr_token_index+1));
 			break;
 		}
 	}
@@ -6170,39 +6251,45 @@ gb_internal ParseFileError init_ast_file(AstFile *f, String const &fullpath, Tok
 
 	}
 
-	isize file_size = f->tokenizer.end - f->tokenizer.start;
-
-	// NOTE(bill): Determine allocation size required for tokens
-	isize token_cap = file_size/3ll;
-	isize pow2_cap = gb_max(cast(isize)prev_pow2(cast(i64)token_cap)/2, 16);
-	token_cap = ((token_cap + pow2_cap-1)/pow2_cap) * pow2_cap;
+	u64 start = time_stamp_time_now();
 
-	isize init_token_cap = gb_max(token_cap, 16);
-	array_init(&f->tokens, ast_allocator(f), 0, gb_max(init_token_cap, 16));
+	if (err != TokenizerInit_Empty && ast_snapshot_begin(f) && ast_snapshot_load(f)) {
+		// NOTE: the tokens and the line table come from the snapshot, see `ast_snapshot.cpp`
+	} else {
+		isize file_size = f->tokenizer.end - f->tokenizer.start;
 
-	if (err == TokenizerInit_Empty) {
-		Token token = {Token_EOF};
-		token.pos.file_id = f->id;
-		token.pos.line    = 1;
-		token.pos.column  = 1;
-		array_add(&f->tokens, token);
-		return ParseFile_None;
-	}
+		// NOTE(bill): Determine allocation size required for tokens
+		isize token_cap = file_size/3ll;
+		isize pow2_cap = gb_max(cast(isize)prev_pow2(cast(i64)token_cap)/2, 16);
+		token_cap = ((token_cap + pow2_cap-1)/pow2_cap) * pow2_cap;
 
-	u64 start = time_stamp_time_now();
+		isize init_token_cap = gb_max(token_cap, 16);
+		array_init(&f->tokens, ast_allocator(f), 0, gb_max(init_token_cap, 16));
 
-	for (;;) {
-		Token *token = array_add_and_get(&f->tokens);
-		tokenizer_get_token(&f->tokenizer, token);
-		if (token->kind == Token_Invalid) {
-			err_pos->line   = token->pos.line;
-			err_pos->column = token->pos.column;
-			return ParseFile_InvalidToken;
+		if (err == TokenizerInit_Empty) {
+			PackedToken token = {};
+			token.kind = Token_EOF;
+			array_add(&f->tokens, token);
+			ast_file_init_line_offsets(f);
+			return ParseFile_None;
 		}
 
-		if (token->kind == Token_EOF) {
-			break;
+		for (;;) {
+			Token token = {};
+			tokenizer_get_token(&f->tokenizer, &token);
+			array_add(&f->tokens, pack_token(token));
+			if (token.kind == Token_Invalid) {
+				err_pos->line   = token.pos.line;
+				err_pos->column = token.pos.column;
+				return ParseFile_InvalidToken;
+			}
+
+			if (token.kind == Token_EOF) {
+				break;
+			}
 		}
+
+		ast_file_init_line_offsets(f);
 	}
 
 	u64 end = time_stamp_time_now();
@@ -6210,8 +6297,8 @@ gb_internal ParseFileError init_ast_file(AstFile *f, String const &fullpath, Tok
 
 	f->prev_token_index = 0;
 	f->curr_token_index = 0;
-	f->prev_token = f->tokens[f->prev_token_index];
-	f->curr_token = f->tokens[f->curr_token_index];
+	f->prev_token = ast_file_unpack_token(f, f->prev_token_index);
+	f->curr_token = ast_file_unpack_token(f, f->curr_token_index);
 
 	array_init(&f->comments, ast_allocator(f), 0, 0);
 	array_init(&f->imports,  ast_allocator(f), 0, 0);
@@ -6224,6 +6311,7 @@ gb_internal ParseFileError init_ast_file(AstFile *f, String const &fullpath, Tok
 gb_internal void destroy_ast_file(AstFile *f) {
 	GB_ASSERT(f != nullptr);
 	array_free(&f->tokens);
+	array_free(&f->line_offsets);
 	array_free(&f->comments);
 	array_free(&f->imports);
 }
@@ -6260,6 +6348,7 @@ gb_internal ParseFileError process_imported_file(Parser *p, ImportedFile importe
 
 gb_internal WORKER_TASK_PROC(parser_worker_proc) {
 	ParserWorkerData *wd = cast(ParserWorkerData *)data;
+	TRACE_SCOPE("parse file", wd->imported_file.fi.fullpath);
 	ParseFileError err = process_imported_file(wd->parser, wd->imported_file);
 	if (err != ParseFile_None) {
 		auto *node = permanent_alloc_item<ParseFileErrorNode>();
@@ -6291,6 +6380,7 @@ gb_internal void parser_add_file_to_process(Parser *p, AstPackage *pkg, FileInfo
 gb_internal WORKER_TASK_PROC(foreign_file_worker_proc) {
 	ForeignFileWorkerData *wd = cast(ForeignFileWorkerData *)data;
 	ImportedFile *imp = &wd->imported_file;
+	TRACE_SCOPE("read foreign file", imp->fi.fullpath);
 	AstPackage *pkg = imp->pkg;
 
 	AstForeignFile foreign_file = {wd->foreign_kind};
@@ -7263,6 +7353,8 @@ gb_internal bool parse_file(Parser *p, AstFile *f) {
 	}
 
 	u64 start = time_stamp_time_now();
+	i64 error_count_before   = global_error_collector.count.load();
+	i64 warning_count_before = global_error_collector.warning_count.load();
 
 	String filepath = f->tokenizer.fullpath;
 	String base_dir = dir_from_path(filepath);
@@ -7341,7 +7433,12 @@ gb_internal bool parse_file(Parser *p, AstFile *f) {
 	expect_semicolon(f);
 	f->pkg_decl = pd;
 
-	if (f->error_count == 0) {
+	isize prefix_comment_count = f->comments.count;
+
+	if (f->error_count == 0 && f->snapshot != nullptr) {
+		ast_snapshot_apply(f);
+		parse_setup_file_decls(p, f, base_dir, f->decls);
+	} else if (f->error_count == 0) {
 		auto decls = array_make<Ast *>(ast_allocator(f));
 
 		while (f->curr_token.kind != Token_EOF) {
@@ -7373,6 +7470,12 @@ gb_internal bool parse_file(Parser *p, AstFile *f) {
 		array_init(f->delayed_decls_queues+i, ast_allocator(f), 0, f->delayed_decl_count);
 	}
 
+	// NOTE: only a parse without any diagnostics is stored, as loading a snapshot does not report them again
+	if (f->snapshot_enabled && f->snapshot == nullptr && f->error_count == 0 &&
+	    global_error_collector.count.load() == error_count_before &&
+	    global_error_collector.warning_count.load() == warning_count_before) {
+		ast_snapshot_store(f, prefix_comment_count);
+	}
 
 	return f->error_count == 0;
 }
@@ -118,7 +118,11 @@ struct AstFile {
 	String       directory;
 
 	Tokenizer    tokenizer;
-	Array<Token> tokens;
+	Array<PackedToken> tokens;
+	Array<u32>   line_offsets; // byte offset of the start of each line, used to unpack `tokens`
+	isize        unpack_line_hint;
+	u32          unpack_column_offset;
+	i32          unpack_column;
 	isize        curr_token_index;
 	isize        prev_token_index;
 	Token        curr_token;
@@ -164,6 +168,11 @@ struct AstFile {
 
 	std::atomic<isize> seen_load_directive_count;
 
+	// -ast-cache
+	bool                    snapshot_enabled;
+	Hash128                 snapshot_key;
+	struct AstSnapshotRoot *snapshot; // set when the file was loaded from its snapshot rather than parsed
+
 #define PARSER_MAX_FIX_COUNT 6
 	isize    fix_count;
 	TokenPos fix_prev_pos;
@@ -985,6 +994,11 @@ gb_internal gb_inline gbAllocator ast_allocator(AstFile *f) {
 
 gb_internal Ast *alloc_ast_node(AstFile *f, AstKind kind);
 
+gb_internal bool ast_snapshot_begin(AstFile *f);
+gb_internal bool ast_snapshot_load(AstFile *f);
+gb_internal void ast_snapshot_store(AstFile *f, isize prefix_comment_count);
+gb_internal void ast_snapshot_apply(AstFile *f);
+
 gb_internal gbString expr_to_string(Ast *expression);
 gb_internal bool allow_field_separator(AstFile *f);
 
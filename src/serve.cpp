@@ -0,0 +1,1014 @@
+/*
+	`odin serve`: a persistent compiler server on a local Unix socket.
+
+	The server itself holds no compiler state. Each distinct command line (with its working directory
+	and the environment variables the compiler reads) gets a worker process, forked from the server,
+	which runs the compiler as normal up to the end of parsing and then stays alive holding the
+	`Parser` and all of its `AstFile`s. Every request is run in a fork of that worker, with the
+	request's own environment, so the checker and backend are free to mutate the AST and the worker
+	always stays as it was straight after parsing.
+
+	Before forking, the worker checks the mtime (and on a change, the content hash) of every file it
+	parsed and re-parses only those that changed. If the change cannot be applied in place (a file
+	was added or removed, an import changed, a file no longer parses), the worker reports itself as
+	stale and the server replaces it with a fresh one, which parses everything again.
+
+	The client is `odin` itself: with `ODIN_SERVE_SOCKET` set, the command line, the working directory,
+	the environment, and the standard file descriptors are forwarded to the server, and the exit code
+	is returned. If the server cannot be reached, the command is run locally instead.
+
+	The server waits on every busy worker at once, so a long build does not hold up requests for
+	other command lines; requests for a busy worker are queued until it is done.
+
+	The client hands over its environment and its file descriptors, so both sides only talk to a peer
+	running as the same user, and the default socket lives in a directory only that user can enter.
+*/
+
+gb_internal int odin_main(int arg_count, char const **arg_ptr);
+
+#if defined(GB_SYSTEM_WINDOWS)
+
+gb_internal int serve_main(int arg_count, char const **arg_ptr) {
+	gb_printf_err("'odin serve' is only supported on Unix-like systems\n");
+	return 1;
+}
+
+gb_internal bool serve_forward(int arg_count, char const **arg_ptr, int *exit_code_) {
+	return false;
+}
+
+gb_internal void serve_worker_loop(Parser *p) {
+}
+
+#else
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+enum ServeReplyKind : i32 {
+	ServeReply_Done,    // the worker stays warm for the next request
+	ServeReply_Exiting, // the command finished before parsing was done, so the worker has nothing to keep
+	ServeReply_Stale,   // the parsed files could not be updated in place; the request was not run
+};
+
+struct ServeReply {
+	ServeReplyKind kind;
+	i32            exit_code;
+};
+
+enum {
+	SERVE_MAX_WORKERS = 4,
+};
+
+// A request is the working directory, the environment, an empty string, and then the command line,
+// each NUL terminated, preceded by the total length. The client's stdin, stdout, and stderr travel
+// with it as `SCM_RIGHTS` ancillary data.
+struct ServeRequest {
+	String payload;
+	int    fds[3];
+};
+
+struct ServeCommand {
+	char const *        cwd;
+	Array<char const *> env; // nullptr terminated, to be used as `environ`
+	Array<char const *> args;
+};
+
+// A request from a client which is waiting for its exit code
+struct ServeJob {
+	int          conn;
+	ServeRequest req;
+	String       key;
+	int          attempts;
+};
+
+struct ServeWorker {
+	pid_t    pid;
+	int      fd;
+	String   key;
+	u64      last_used;
+	bool     warm; // has answered a request, so it only runs them in forked children
+	bool     busy;
+	ServeJob job;
+};
+
+struct ServeFileStamp {
+	AstFile *file; // nullptr for files that were read but not parsed into the package (assembly, excluded by tags)
+	String   fullpath;
+	i64      mtime_ns;
+	i64      size;
+	u64      hash;
+};
+
+struct ServeDirStamp {
+	String fullpath;
+	u64    listing_hash;
+};
+
+// NOTE: the environment variables the compiler reads before the end of parsing, which a worker
+// keeps from its first request; a worker is only reused by requests which agree on all of them
+gb_global char const *serve_keyed_env_vars[] = {
+	"ODIN_ROOT",
+	"ODIN_ERROR_POS_STYLE",
+	"ODIN_TERMINAL",
+	"ODIN_ANDROID_NDK",
+	"ODIN_ANDROID_NDK_TOOLCHAIN",
+	"ODIN_ANDROID_SDK",
+	"NO_COLOR",
+	"FORCE_COLOR",
+	"TERM",
+	"TMPDIR",
+	"PATH",
+};
+
+gb_global int                   serve_worker_fd = -1;
+gb_global Array<ServeFileStamp> serve_file_stamps;
+gb_global Array<ServeDirStamp>  serve_dir_stamps;
+
+
+// A directory which is not a symbolic link, is owned by this user, and cannot be entered by anyone else
+gb_internal bool serve_is_private_directory(char const *path) {
+	struct stat st = {};
+	if (lstat(path, &st) != 0) {
+		return false;
+	}
+	return S_ISDIR(st.st_mode) && st.st_uid == getuid() && (st.st_mode & 077) == 0;
+}
+
+// `$ODIN_SERVE_SOCKET`, otherwise a socket in `$XDG_RUNTIME_DIR` or in a private directory under `/tmp`
+gb_internal String serve_socket_path(void) {
+	char const *env = getenv("ODIN_SERVE_SOCKET");
+	if (env != nullptr && env[0] != 0) {
+		return make_string_c(env);
+	}
+
+	char dir[4096] = {};
+	char const *runtime_dir = getenv("XDG_RUNTIME_DIR");
+	if (runtime_dir != nullptr && runtime_dir[0] != 0) {
+		gb_snprintf(dir, gb_size_of(dir), "%s", runtime_dir);
+	} else {
+		gb_snprintf(dir, gb_size_of(dir), "/tmp/odin-serve-%u", cast(unsigned)getuid());
+		if (mkdir(dir, 0700) != 0 && errno != EEXIST) {
+			gb_printf_err("Unable to create %s: %s\n", dir, strerror(errno));
+			return {};
+		}
+	}
+	if (!serve_is_private_directory(dir)) {
+		gb_printf_err("%s must be a directory owned by this user and not accessible to anyone else\n", dir);
+		return {};
+	}
+
+	char buf[4096+32] = {};
+	gb_snprintf(buf, gb_size_of(buf), "%s/odin-serve.sock", dir);
+	return copy_string(heap_allocator(), make_string_c(buf));
+}
+
+// Whether the process on the other end of a connected socket runs as this user
+gb_internal bool serve_is_same_user(int fd) {
+	uid_t uid = 0;
+#if defined(GB_SYSTEM_LINUX)
+	struct ucred cred = {};
+	socklen_t len = gb_size_of(cred);
+	if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) {
+		return false;
+	}
+	uid = cred.uid;
+#else
+	gid_t gid = 0;
+	if (getpeereid(fd, &uid, &gid) != 0) {
+		return false;
+	}
+#endif
+	return uid == getuid();
+}
+
+gb_internal bool serve_write_all(int fd, void const *data, isize size) {
+	u8 const *ptr = cast(u8 const *)data;
+	while (size > 0) {
+		ssize_t n = write(fd, ptr, size);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		ptr  += n;
+		size -= n;
+	}
+	return true;
+}
+
+gb_internal bool serve_read_all(int fd, void *data, isize size) {
+	u8 *ptr = cast(u8 *)data;
+	while (size > 0) {
+		ssize_t n = read(fd, ptr, size);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		ptr  += n;
+		size -= n;
+	}
+	return true;
+}
+
+gb_internal bool serve_send_request(int fd, ServeRequest const &req) {
+	u32 len = cast(u32)req.payload.len;
+
+	struct iovec iov = {};
+	iov.iov_base = &len;
+	iov.iov_len  = gb_size_of(len);
+
+	union {
+		struct cmsghdr align;
+		char buf[CMSG_SPACE(gb_size_of(req.fds))];
+	} control = {};
+
+	struct msghdr msg = {};
+	msg.msg_iov        = &iov;
+	msg.msg_iovlen     = 1;
+	msg.msg_control    = control.buf;
+	msg.msg_controllen = gb_size_of(control.buf);
+
+	struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type  = SCM_RIGHTS;
+	cmsg->cmsg_len   = CMSG_LEN(gb_size_of(req.fds));
+	gb_memmove(CMSG_DATA(cmsg), req.fds, gb_size_of(req.fds));
+
+	ssize_t n = 0;
+	do {
+		n = sendmsg(fd, &msg, 0);
+	} while (n < 0 && errno == EINTR);
+	if (n != gb_size_of(len)) {
+		return false;
+	}
+	return serve_write_all(fd, req.payload.text, req.payload.len);
+}
+
+gb_internal bool serve_recv_request(int fd, ServeRequest *req) {
+	u32 len = 0;
+
+	struct iovec iov = {};
+	iov.iov_base = &len;
+	iov.iov_len  = gb_size_of(len);
+
+	union {
+		struct cmsghdr align;
+		char buf[CMSG_SPACE(gb_size_of(req->fds))];
+	} control = {};
+
+	struct msghdr msg = {};
+	msg.msg_iov        = &iov;
+	msg.msg_iovlen     = 1;
+	msg.msg_control    = control.buf;
+	msg.msg_controllen = gb_size_of(control.buf);
+
+	ssize_t n = 0;
+	do {
+		n = recvmsg(fd, &msg, 0);
+	} while (n < 0 && errno == EINTR);
+	if (n != gb_size_of(len)) {
+		return false;
+	}
+
+	struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+	if (cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(gb_size_of(req->fds))) {
+		return false;
+	}
+	gb_memmove(req->fds, CMSG_DATA(cmsg), gb_size_of(req->fds));
+
+	req->payload.text = gb_alloc_array(heap_allocator(), u8, len+1);
+	req->payload.len  = len;
+	req->payload.text[len] = 0;
+	if (len == 0 || !serve_read_all(fd, req->payload.text, len)) {
+		return false;
+	}
+	return true;
+}
+
+gb_internal ServeCommand serve_parse_request(ServeRequest const &req) {
+	ServeCommand cmd = {};
+	cmd.env  = array_make<char const *>(heap_allocator(), 0, 64);
+	cmd.args = array_make<char const *>(heap_allocator(), 0, 16);
+
+	char const *text = cast(char const *)req.payload.text;
+	isize i = 0;
+	cmd.cwd = text;
+	i += gb_strlen(text+i)+1;
+	while (i < req.payload.len) {
+		char const *entry = text+i;
+		i += gb_strlen(entry)+1;
+		if (entry[0] == 0) {
+			break;
+		}
+		array_add(&cmd.env, entry);
+	}
+	array_add(&cmd.env, cast(char const *)nullptr);
+	while (i < req.payload.len) {
+		char const *arg = text+i;
+		i += gb_strlen(arg)+1;
+		array_add(&cmd.args, arg);
+	}
+	return cmd;
+}
+
+gb_internal void serve_command_free(ServeCommand *cmd) {
+	array_free(&cmd->env);
+	array_free(&cmd->args);
+}
+
+// The working directory, the keyed environment variables, and the command line, which must all
+// match for a worker to be reused
+gb_internal String serve_request_key(ServeRequest const &req) {
+	ServeCommand cmd = serve_parse_request(req);
+	defer (serve_command_free(&cmd));
+
+	gbString key = gb_string_make_reserve(heap_allocator(), req.payload.len);
+	key = gb_string_append_length(key, cmd.cwd, gb_strlen(cmd.cwd)+1);
+	for (char const *name : serve_keyed_env_vars) {
+		isize name_len = gb_strlen(name);
+		for (isize i = 0; i < cmd.env.count-1; i++) {
+			char const *entry = cmd.env[i];
+			if (gb_strncmp(entry, name, name_len) == 0 && entry[name_len] == '=') {
+				key = gb_string_append_length(key, entry, gb_strlen(entry)+1);
+				break;
+			}
+		}
+	}
+	key = gb_string_append_length(key, "", 1);
+	for (char const *arg : cmd.args) {
+		key = gb_string_append_length(key, arg, gb_strlen(arg)+1);
+	}
+
+	String result = copy_string(heap_allocator(), make_string(cast(u8 *)key, gb_string_length(key)));
+	gb_string_free(key);
+	return result;
+}
+
+gb_internal void serve_request_close(ServeRequest *req) {
+	for (int i = 0; i < gb_count_of(req->fds); i++) {
+		if (req->fds[i] >= 0) {
+			close(req->fds[i]);
+			req->fds[i] = -1;
+		}
+	}
+	gb_free(heap_allocator(), req->payload.text);
+	req->payload = {};
+}
+
+// Replaces stdin, stdout, and stderr with the request's, closing the originals
+gb_internal void serve_redirect_stdio(int fds[3]) {
+	fflush(stdout);
+	fflush(stderr);
+	for (int i = 0; i < 3; i++) {
+		dup2(fds[i], i);
+		close(fds[i]);
+		fds[i] = -1;
+	}
+}
+
+gb_internal void serve_close_fds_except(int keep) {
+	long max_fd = gb_clamp(sysconf(_SC_OPEN_MAX), 256, 4096);
+	for (int fd = 3; fd < max_fd; fd++) {
+		if (fd != keep) {
+			close(fd);
+		}
+	}
+}
+
+gb_internal void serve_redirect_stdio_to_null(void) {
+	fflush(stdout);
+	fflush(stderr);
+	int null_fd = open("/dev/null", O_RDWR);
+	if (null_fd >= 0) {
+		for (int i = 0; i < 3; i++) {
+			dup2(null_fd, i);
+		}
+		close(null_fd);
+	}
+}
+
+gb_internal int serve_exit_code_from_status(int status) {
+	if (WIFEXITED(status)) {
+		return WEXITSTATUS(status);
+	} else if (WIFSIGNALED(status)) {
+		return 128 + WTERMSIG(status);
+	}
+	return 1;
+}
+
+
+gb_internal bool serve_stat(String const &fullpath, i64 *mtime_ns, i64 *size) {
+	char const *c_path = alloc_cstring(temporary_allocator(), fullpath);
+	struct stat st = {};
+	if (stat(c_path, &st) != 0) {
+		return false;
+	}
+#if defined(GB_SYSTEM_OSX)
+	*mtime_ns = cast(i64)st.st_mtimespec.tv_sec*1000000000ll + cast(i64)st.st_mtimespec.tv_nsec;
+#else
+	*mtime_ns = cast(i64)st.st_mtim.tv_sec*1000000000ll + cast(i64)st.st_mtim.tv_nsec;
+#endif
+	*size = cast(i64)st.st_size;
+	return true;
+}
+
+gb_internal bool serve_hash_file(String const &fullpath, u64 *hash) {
+	char const *c_path = alloc_cstring(temporary_allocator(), fullpath);
+	gbFileContents fc = gb_file_read_contents(heap_allocator(), false, c_path);
+	if (fc.data == nullptr && fc.size != 0) {
+		return false;
+	}
+	*hash = fnv64a(fc.data, fc.size);
+	gb_file_free_contents(&fc);
+	return true;
+}
+
+gb_internal bool serve_is_package_file(String const &name) {
+	String ext = path_extension(name);
+	return ext == ".odin" || ext == ".S" || ext == ".s";
+}
+
+// Order independent hash of the names of the files a package could be made of
+gb_internal u64 serve_directory_listing_hash(String const &fullpath) {
+	Array<FileInfo> list = {};
+	ReadDirectoryError rd_err = read_directory(fullpath, &list);
+	defer (array_free(&list));
+	if (rd_err != ReadDirectory_None) {
+		return 0;
+	}
+
+	u64 hash = 0;
+	u64 count = 0;
+	for (FileInfo const &fi : list) {
+		if (!fi.is_dir && serve_is_package_file(fi.name)) {
+			hash ^= fnv64a(fi.name.text, fi.name.len);
+			count += 1;
+		}
+	}
+	return hash ^ (count * 0x9e3779b97f4a7c15ull);
+}
+
+gb_internal void serve_add_file_stamp(AstFile *file, String const &fullpath) {
+	ServeFileStamp stamp = {};
+	stamp.file     = file;
+	stamp.fullpath = copy_string(permanent_allocator(), fullpath);
+	serve_stat(stamp.fullpath, &stamp.mtime_ns, &stamp.size);
+	if (file != nullptr) {
+		stamp.hash = fnv64a(file->tokenizer.start, file->tokenizer.end - file->tokenizer.start);
+
+		// NOTE: the file may have changed between being read and being stamped, in which case
+		// its mtime is already newer than its contents; clear it so the next request re-checks it
+		u64 disk_hash = 0;
+		if (!serve_hash_file(stamp.fullpath, &disk_hash) || disk_hash != stamp.hash) {
+			stamp.mtime_ns = 0;
+		}
+	} else {
+		serve_hash_file(stamp.fullpath, &stamp.hash);
+	}
+	array_add(&serve_file_stamps, stamp);
+}
+
+// Records every file and package directory the parse depended upon
+gb_internal void serve_stamp_files(Parser *p) {
+	array_init(&serve_file_stamps, heap_allocator());
+	array_init(&serve_dir_stamps,  heap_allocator());
+
+	StringSet parsed = {};
+	string_set_init(&parsed);
+	defer (string_set_destroy(&parsed));
+
+	for (AstPackage *pkg : p->packages) {
+		for (AstFile *file : pkg->files) {
+			string_set_add(&parsed, file->fullpath);
+			serve_add_file_stamp(file, file->fullpath);
+		}
+	}
+
+	for (AstPackage *pkg : p->packages) {
+		if (pkg->is_single_file) {
+			continue;
+		}
+		ServeDirStamp dir = {};
+		dir.fullpath     = pkg->fullpath;
+		dir.listing_hash = serve_directory_listing_hash(pkg->fullpath);
+		array_add(&serve_dir_stamps, dir);
+
+		Array<FileInfo> list = {};
+		read_directory(pkg->fullpath, &list);
+		defer (array_free(&list));
+		for (FileInfo const &fi : list) {
+			if (!fi.is_dir && serve_is_package_file(fi.name) && !string_set_exists(&parsed, fi.fullpath)) {
+				serve_add_file_stamp(nullptr, fi.fullpath);
+			}
+		}
+	}
+}
+
+gb_internal bool serve_same_imports(AstFile *a, AstFile *b) {
+	if (a->imports.count != b->imports.count) {
+		return false;
+	}
+	for_array(i, a->imports) {
+		Ast *x = a->imports[i];
+		Ast *y = b->imports[i];
+		if (x->kind != y->kind) {
+			return false;
+		}
+		if (x->kind == Ast_ImportDecl && x->ImportDecl.fullpath != y->ImportDecl.fullpath) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Re-parses a changed file in place, keeping its id and its position in the package
+gb_internal bool serve_reparse_file(Parser *p, ServeFileStamp *stamp) {
+	AstFile *old  = stamp->file;
+	AstPackage *pkg = old->pkg;
+
+	AstFile *file = permanent_alloc_item<AstFile>();
+	file->pkg = pkg;
+	file->id  = old->id;
+
+	// NOTE: `init_ast_file` only fills an empty slot, but error messages must quote the new source;
+	// on any failure below the worker is replaced, so the old file is not needed again
+	thread_safe_replace_ast_file_from_id(file->id, file, old->fullpath);
+
+	TokenPos err_pos = {};
+	if (init_ast_file(file, old->fullpath, &err_pos) != ParseFile_None) {
+		return false;
+	}
+	if (!parse_file(p, file) || file->error_count != 0) {
+		return false;
+	}
+	if (file->package_name != old->package_name || !serve_same_imports(file, old)) {
+		return false;
+	}
+
+	isize index = -1;
+	for_array(i, pkg->files) {
+		if (pkg->files[i] == old) {
+			index = i;
+			break;
+		}
+	}
+	if (index < 0) {
+		return false;
+	}
+	pkg->files[index] = file;
+
+	p->total_line_count.fetch_add(file->tokenizer.line_count - old->tokenizer.line_count);
+	p->total_token_count.fetch_add(file->tokens.count - old->tokens.count);
+	p->total_seen_load_directive_count += file->seen_load_directive_count - old->seen_load_directive_count;
+
+	stamp->file = file;
+	stamp->hash = fnv64a(file->tokenizer.start, file->tokenizer.end - file->tokenizer.start);
+	return true;
+}
+
+// Brings the parsed files up to date with the disk, returning false if that cannot be done in place
+gb_internal bool serve_refresh_files(Parser *p) {
+	for (ServeDirStamp const &dir : serve_dir_stamps) {
+		if (serve_directory_listing_hash(dir.fullpath) != dir.listing_hash) {
+			return false;
+		}
+	}
+
+	for (ServeFileStamp &stamp : serve_file_stamps) {
+		i64 mtime_ns = 0;
+		i64 size = 0;
+		if (!serve_stat(stamp.fullpath, &mtime_ns, &size)) {
+			return false;
+		}
+		if (mtime_ns == stamp.mtime_ns && size == stamp.size) {
+			continue;
+		}
+
+		u64 hash = 0;
+		if (!serve_hash_file(stamp.fullpath, &hash)) {
+			return false;
+		}
+		if (hash != stamp.hash) {
+			if (stamp.file == nullptr || !serve_reparse_file(p, &stamp)) {
+				return false;
+			}
+		}
+		stamp.mtime_ns = mtime_ns;
+		stamp.size     = size;
+	}
+	return true;
+}
+
+// NOTE: called straight after parsing. In a worker process, this only returns in a forked child
+// which has taken over the request's standard file descriptors and then continues as a normal build.
+gb_internal void serve_worker_loop(Parser *p) {
+	if (!build_context.serve_worker) {
+		return;
+	}
+
+	serve_stamp_files(p);
+
+	// NOTE: threads do not survive a fork, so the pool only exists while there is work for it
+	thread_pool_destroy(&global_thread_pool);
+
+	ServeRequest req = {};
+	req.fds[0] = req.fds[1] = req.fds[2] = -1;
+
+	for (bool first = true; /**/; first = false) {
+		if (!first) {
+			if (!serve_recv_request(serve_worker_fd, &req)) {
+				_exit(0);
+			}
+
+			init_global_thread_pool();
+			bool ok = serve_refresh_files(p);
+			thread_pool_destroy(&global_thread_pool);
+
+			if (!ok || any_errors()) {
+				ServeReply reply = {ServeReply_Stale, 1};
+				serve_write_all(serve_worker_fd, &reply, gb_size_of(reply));
+				_exit(0);
+			}
+
+			serve_redirect_stdio(req.fds);
+		}
+
+		fflush(stdout);
+		fflush(stderr);
+		pid_t pid = fork();
+		if (pid == 0) {
+			close(serve_worker_fd);
+			serve_worker_fd = -1;
+			if (!first) {
+				// NOTE: the payload is kept alive for the rest of the process, as it is now the environment
+				ServeCommand cmd = serve_parse_request(req);
+				environ = cast(char **)cmd.env.data;
+			}
+
+			init_global_thread_pool();
+			timings_destroy(&global_timings);
+			timings_init(&global_timings, str_lit("Total Time"), 2048);
+			return;
+		}
+
+		serve_redirect_stdio_to_null();
+		serve_request_close(&req);
+
+		ServeReply reply = {ServeReply_Done, 1};
+		if (pid > 0) {
+			int wstatus = 0;
+			while (waitpid(pid, &wstatus, 0) < 0 && errno == EINTR) {
+			}
+			reply.exit_code = serve_exit_code_from_status(wstatus);
+		}
+		if (!serve_write_all(serve_worker_fd, &reply, gb_size_of(reply))) {
+			_exit(0);
+		}
+	}
+}
+
+// Runs in a freshly forked worker, which already has the request's standard file descriptors:
+// the first request is handled by the compiler as normal
+gb_internal void serve_worker_main(int fd, ServeRequest *req) {
+	serve_worker_fd = fd;
+
+	ServeCommand cmd = serve_parse_request(*req);
+	environ = cast(char **)cmd.env.data;
+
+	ServeReply reply = {ServeReply_Exiting, 1};
+	if (chdir(cmd.cwd) != 0) {
+		gb_printf_err("Unable to change the directory to %s: %s\n", cmd.cwd, strerror(errno));
+	} else {
+		build_context.serve_worker = true;
+		reply.exit_code = odin_main(cast(int)cmd.args.count, cmd.args.data);
+	}
+
+	if (serve_worker_fd < 0) {
+		// NOTE: a request's child, returning from `serve_worker_loop` and then from `odin_main`
+		exit(reply.exit_code);
+	}
+
+	// NOTE: the command finished before parsing was done (errors, `odin version`, etc.)
+	fflush(stdout);
+	fflush(stderr);
+	serve_write_all(fd, &reply, gb_size_of(reply));
+	_exit(0);
+}
+
+gb_internal void serve_worker_stop(ServeWorker *w) {
+	if (w->pid > 0) {
+		close(w->fd);
+		kill(w->pid, SIGTERM);
+		while (waitpid(w->pid, nullptr, 0) < 0 && errno == EINTR) {
+		}
+	}
+	gb_free(heap_allocator(), w->key.text);
+	*w = {};
+}
+
+gb_internal bool serve_worker_start(ServeWorker *w, String const &key, ServeRequest *req) {
+	int sv[2] = {};
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+		return false;
+	}
+
+	fflush(stdout);
+	fflush(stderr);
+	pid_t pid = fork();
+	if (pid < 0) {
+		close(sv[0]);
+		close(sv[1]);
+		return false;
+	}
+	if (pid == 0) {
+		// NOTE: drops the listening socket, the client connection, and every other worker's socket
+		serve_redirect_stdio(req->fds);
+		serve_close_fds_except(sv[1]);
+		serve_worker_main(sv[1], req);
+	}
+
+	close(sv[1]);
+	w->pid = pid;
+	w->fd  = sv[0];
+	w->key = copy_string(heap_allocator(), key);
+	return true;
+}
+
+// Replies to the client with the exit code (unless it is negative) and drops the connection
+gb_internal void serve_job_finish(ServeJob *job, i32 status) {
+	if (status >= 0) {
+		serve_write_all(job->conn, &status, gb_size_of(status));
+	}
+	close(job->conn);
+	serve_request_close(&job->req);
+	gb_free(heap_allocator(), job->key.text);
+	*job = {};
+}
+
+// Hands the job to its worker, starting one if there is none. Returns false if the job has to wait
+// for a worker to be free; a job which cannot be run at all is finished with an error here.
+gb_internal bool serve_dispatch(ServeWorker workers[SERVE_MAX_WORKERS], ServeJob *job, u64 *tick) {
+	while (job->attempts < 2) {
+		ServeWorker *w = nullptr;
+		for (isize i = 0; i < SERVE_MAX_WORKERS; i++) {
+			if (workers[i].pid > 0 && workers[i].key == job->key) {
+				w = &workers[i];
+				break;
+			}
+		}
+
+		bool sent = false;
+		if (w != nullptr) {
+			if (w->busy) {
+				return false;
+			}
+			sent = serve_send_request(w->fd, job->req);
+		} else {
+			for (isize i = 0; i < SERVE_MAX_WORKERS; i++) {
+				ServeWorker *it = &workers[i];
+				if (it->pid <= 0) {
+					w = it;
+					break;
+				} else if (!it->busy && (w == nullptr || it->last_used < w->last_used)) {
+					w = it;
+				}
+			}
+			if (w == nullptr) {
+				return false;
+			}
+			serve_worker_stop(w);
+			sent = serve_worker_start(w, job->key, &job->req);
+		}
+
+		job->attempts += 1;
+		if (!sent) {
+			serve_worker_stop(w);
+			continue;
+		}
+
+		*tick += 1;
+		w->last_used = *tick;
+		w->busy      = true;
+		w->job       = *job;
+		*job = {};
+		return true;
+	}
+
+	serve_job_finish(job, 1);
+	return true;
+}
+
+gb_internal int serve_main(int arg_count, char const **arg_ptr) {
+	if (arg_count > 2) {
+		gb_printf_err("Usage: %s serve\n", arg_ptr[0]);
+		gb_printf_err("\tListens on $ODIN_SERVE_SOCKET, or if it is not set, on odin-serve.sock in $XDG_RUNTIME_DIR or /tmp/odin-serve-<uid>.\n");
+		gb_printf_err("\tSet ODIN_SERVE_SOCKET for 'odin build/check/run/test' to be forwarded to the server.\n");
+		return 1;
+	}
+
+	String path = serve_socket_path();
+	if (path.len == 0) {
+		return 1;
+	}
+
+	struct sockaddr_un addr = {};
+	addr.sun_family = AF_UNIX;
+	if (path.len >= gb_size_of(addr.sun_path)) {
+		gb_printf_err("Socket path is too long: %.*s\n", LIT(path));
+		return 1;
+	}
+	gb_memmove(addr.sun_path, path.text, path.len);
+
+	int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listen_fd < 0) {
+		gb_printf_err("Unable to create a socket: %s\n", strerror(errno));
+		return 1;
+	}
+
+	if (connect(listen_fd, cast(struct sockaddr *)&addr, gb_size_of(addr)) == 0) {
+		gb_printf_err("A server is already listening on %.*s\n", LIT(path));
+		return 1;
+	}
+	close(listen_fd);
+	unlink(addr.sun_path);
+
+	listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (bind(listen_fd, cast(struct sockaddr *)&addr, gb_size_of(addr)) != 0 || listen(listen_fd, 16) != 0) {
+		gb_printf_err("Unable to listen on %.*s: %s\n", LIT(path), strerror(errno));
+		return 1;
+	}
+	fcntl(listen_fd, F_SETFD, FD_CLOEXEC);
+	chmod(addr.sun_path, 0600);
+
+	signal(SIGPIPE, SIG_IGN);
+
+	gb_printf("Listening on %.*s\n", LIT(path));
+
+	ServeWorker workers[SERVE_MAX_WORKERS] = {};
+	Array<ServeJob> queue = {};
+	array_init(&queue, heap_allocator());
+	u64 tick = 0;
+
+	for (;;) {
+		for (isize i = 0; i < queue.count; /**/) {
+			if (serve_dispatch(workers, &queue[i], &tick)) {
+				array_ordered_remove(&queue, i);
+			} else {
+				i += 1;
+			}
+		}
+
+		struct pollfd fds[1+SERVE_MAX_WORKERS] = {};
+		ServeWorker *polled[1+SERVE_MAX_WORKERS] = {};
+		nfds_t fd_count = 0;
+		fds[fd_count++].fd = listen_fd;
+		for (ServeWorker &w : workers) {
+			if (w.busy) {
+				polled[fd_count] = &w;
+				fds[fd_count++].fd = w.fd;
+			}
+		}
+		for (nfds_t i = 0; i < fd_count; i++) {
+			fds[i].events = POLLIN;
+		}
+		if (poll(fds, fd_count, -1) < 0) {
+			continue;
+		}
+
+		for (nfds_t i = 1; i < fd_count; i++) {
+			if (fds[i].revents == 0) {
+				continue;
+			}
+			ServeWorker *w = polled[i];
+			ServeJob job = w->job;
+			w->busy = false;
+			w->job  = {};
+
+			ServeReply reply = {};
+			if (!serve_read_all(w->fd, &reply, gb_size_of(reply))) {
+				// NOTE: a warm worker which is lost died while refreshing its files (the parser exits
+				// on an unexpected end of file), so the request never ran and can be retried
+				bool warm = w->warm;
+				serve_worker_stop(w);
+				if (!warm) {
+					serve_job_finish(&job, 1);
+					continue;
+				}
+				reply.kind = ServeReply_Stale;
+			}
+			if (reply.kind == ServeReply_Done) {
+				w->warm = true;
+			} else {
+				serve_worker_stop(w);
+			}
+			if (reply.kind != ServeReply_Stale) {
+				serve_job_finish(&job, reply.exit_code);
+			} else if (!serve_dispatch(workers, &job, &tick)) {
+				array_add(&queue, job);
+			}
+		}
+
+		if (fds[0].revents != 0) {
+			int conn = accept(listen_fd, nullptr, nullptr);
+			if (conn < 0) {
+				continue;
+			}
+			fcntl(conn, F_SETFD, FD_CLOEXEC);
+			if (!serve_is_same_user(conn)) {
+				close(conn);
+				continue;
+			}
+
+			ServeJob job = {};
+			job.conn = conn;
+			job.req.fds[0] = job.req.fds[1] = job.req.fds[2] = -1;
+			if (!serve_recv_request(conn, &job.req)) {
+				serve_job_finish(&job, -1);
+				continue;
+			}
+			job.key = serve_request_key(job.req);
+			array_add(&queue, job);
+		}
+	}
+}
+
+// Forwards the command to a server if `ODIN_SERVE_SOCKET` is set and one is listening there
+gb_internal bool serve_forward(int arg_count, char const **arg_ptr, int *exit_code_) {
+	char const *env = getenv("ODIN_SERVE_SOCKET");
+	if (env == nullptr || env[0] == 0) {
+		return false;
+	}
+
+	struct sockaddr_un addr = {};
+	addr.sun_family = AF_UNIX;
+	if (gb_strlen(env) >= gb_size_of(addr.sun_path)) {
+		return false;
+	}
+	gb_strncpy(addr.sun_path, env, gb_size_of(addr.sun_path)-1);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		return false;
+	}
+	if (connect(fd, cast(struct sockaddr *)&addr, gb_size_of(addr)) != 0) {
+		close(fd);
+		return false;
+	}
+	if (!serve_is_same_user(fd)) {
+		gb_printf_err("Not forwarding to %s, the server there runs as another user\n", env);
+		close(fd);
+		return false;
+	}
+
+	char cwd[4096] = {};
+	if (getcwd(cwd, gb_size_of(cwd)) == nullptr) {
+		close(fd);
+		return false;
+	}
+
+	gbString payload = gb_string_make_reserve(heap_allocator(), 1024);
+	defer (gb_string_free(payload));
+	payload = gb_string_append_length(payload, cwd, gb_strlen(cwd)+1);
+	for (char **entry = environ; entry != nullptr && *entry != nullptr; entry++) {
+		if ((*entry)[0] != 0) {
+			payload = gb_string_append_length(payload, *entry, gb_strlen(*entry)+1);
+		}
+	}
+	payload = gb_string_append_length(payload, "", 1);
+	for (int i = 0; i < arg_count; i++) {
+		payload = gb_string_append_length(payload, arg_ptr[i], gb_strlen(arg_ptr[i])+1);
+	}
+
+	ServeRequest req = {};
+	req.payload = make_string(cast(u8 *)payload, gb_string_length(payload));
+	req.fds[0] = 0;
+	req.fds[1] = 1;
+	req.fds[2] = 2;
+
+	signal(SIGPIPE, SIG_IGN);
+	if (!serve_send_request(fd, req)) {
+		close(fd);
+		return false;
+	}
+
+	i32 status = 1;
+	if (!serve_read_all(fd, &status, gb_size_of(status))) {
+		gb_printf_err("Lost the connection to the compiler server at %s\n", env);
+		status = 1;
+	}
+	close(fd);
+
+	*exit_code_ = status;
+	return true;
+}
+
+#endif
@@ -13,7 +13,8 @@ struct String16HashKey {
 	}
 };
 gb_internal gb_inline u32 string_hash(String16 const &s) {
-	u32 res = fnv32a(s.text, s.len*gb_size_of(u16)) & 0x7fffffff;
+	u64 h = hash64(s.text, s.len*gb_size_of(u16));
+	u32 res = cast(u32)(h ^ (h >> 32)) & 0x7fffffff;
 	return res | (res == 0);
 }
 
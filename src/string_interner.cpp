@@ -4,6 +4,7 @@
 #define STRING_INTERNER_THREAD_LOCAL_SIZE (1024 * 1024 * 2)
 #define STRING_INTERN_CACHE_LINE (2*GB_CACHE_LINE_SIZE)
 
+// NOTE: `value` is the offset from the interner of a `StringInternHeader` followed by the text and a NUL
 struct InternedString {
 	u32 value;
 	bool operator==(InternedString other) const {
@@ -16,6 +17,11 @@ struct InternedString {
 
 	bool is_blank() const;
 };
+struct StringInternHeader {
+	u32 len;
+	u32 hash; // `string_hash` of the text, so that `InternedString::hash` is a single load
+};
+
 struct alignas(STRING_INTERN_CACHE_LINE) StringInternCell {
 	std::atomic<u64>                hashes [STRING_INTERNER_CELL_WIDTH];
 	InternedString                  offsets[STRING_INTERNER_CELL_WIDTH];
@@ -78,10 +84,9 @@ gb_internal String string_interner_load(InternedString interned) {
 	if (interned.value == 0) {
 		return {};
 	}
-	u8 *base = cast(u8 *)interner + interned.value;
-	u32 str_len = *cast(u32 *)base;
-	u8 *text = base + 4;
-	String str = { text, cast(isize)str_len };
+	StringInternHeader *header = cast(StringInternHeader *)(cast(u8 *)interner + interned.value);
+	u8 *text = cast(u8 *)(header + 1);
+	String str = { text, cast(isize)header->len };
 	return str;
 }
 
@@ -90,10 +95,8 @@ gb_internal char const *string_interner_load_cstring(InternedString interned) {
 	if (interned.value == 0) {
 		return "";
 	}
-	u8 *base = cast(u8 *)interner + interned.value;
-	// u32 str_len = *cast(u32 *)base;
-	u8 *text = base + 4;
-	return cast(char const *)text;
+	StringInternHeader *header = cast(StringInternHeader *)(cast(u8 *)interner + interned.value);
+	return cast(char const *)(header + 1);
 }
 
 String InternedString::string() const {
@@ -103,8 +106,11 @@ char const *InternedString::cstring() const {
 	return string_interner_load_cstring(*this);
 }
 u32 InternedString::hash() const {
-	String s = string_interner_load(*this);
-	return string_hash(s);
+	if (this->value == 0) {
+		return string_hash(String{});
+	}
+	StringInternHeader *header = cast(StringInternHeader *)(cast(u8 *)g_string_interner + this->value);
+	return header->hash;
 }
 bool InternedString::is_blank() const {
 	return this->value == g_interned_blank_ident.value;
@@ -160,13 +166,14 @@ gb_internal InternedString string_interner_insert(String str, u32 hash, u32 *new
 		cell = cell->next.load(std::memory_order_relaxed);
 	}
 
-	u64 data_to_allocate = 4 + str.len + 1;
-	u8 *data = cast(u8 *)string_interner_thread_local_arena_alloc(&g_interner_arena, data_to_allocate, 8);
-	u32 str_len = cast(u32)str.len;
-	gb_memcopy(data, &str_len, 4);
-	gb_memcopy(&data[4], str.text, str_len);
-	data[4+str_len] = 0;
-	InternedString offset = { cast(u32)(cast(u8 *)data - cast(u8 *)interner) };
+	u64 data_to_allocate = gb_size_of(StringInternHeader) + str.len + 1;
+	StringInternHeader *header = cast(StringInternHeader *)string_interner_thread_local_arena_alloc(&g_interner_arena, data_to_allocate, 8);
+	header->len  = cast(u32)str.len;
+	header->hash = hash;
+	u8 *text = cast(u8 *)(header + 1);
+	gb_memcopy(text, str.text, str.len);
+	text[str.len] = 0;
+	InternedString offset = { cast(u32)(cast(u8 *)header - cast(u8 *)interner) };
 
 	for (i32 i = 0; i < STRING_INTERNER_CELL_WIDTH; i += 1) {
 		if (load_cell->hashes[i].load(std::memory_order_relaxed) == 0) {
@@ -21,6 +21,7 @@ gb_internal Thread *get_current_thread(void) {
 gb_internal void thread_pool_init(ThreadPool *pool, isize worker_count, char const *worker_name);
 gb_internal void thread_pool_destroy(ThreadPool *pool);
 gb_internal bool thread_pool_add_task(ThreadPool *pool, WorkerTaskProc *proc, void *data);
+gb_internal bool thread_pool_add_task_with_cost(ThreadPool *pool, WorkerTaskProc *proc, void *data, i64 cost);
 gb_internal void thread_pool_wait(ThreadPool *pool);
 
 enum GrabState {
@@ -34,6 +35,15 @@ enum BroadcastWaitState {
 	Someone_Waiting = 1,
 };
 
+// A task added with an estimate of how long it will take. These are shared by the whole pool and
+// always handed out most expensive first, ahead of the per-thread queues, so that the longest
+// tasks of a stage start as early as possible rather than whichever happens to be taken last
+// setting the time for the whole stage.
+struct CostedWorkerTask {
+	WorkerTask task;
+	i64        cost;
+};
+
 struct ThreadPool {
 	gbAllocator       threads_allocator;
 	Slice<Thread>     threads;
@@ -41,8 +51,24 @@ struct ThreadPool {
 
 	Futex tasks_available;
 	Futex tasks_left;
+
+	BlockingMutex                    costed_tasks_mutex;
+	PriorityQueue<CostedWorkerTask>  costed_tasks;       // mutex: costed_tasks_mutex
+	std::atomic<isize>               costed_tasks_count;
 };
 
+gb_internal int costed_worker_task_cmp(CostedWorkerTask *q, isize i, isize j) {
+	i64 x = q[i].cost;
+	i64 y = q[j].cost;
+	return x > y ? -1 : x < y ? +1 : 0;
+}
+
+gb_internal void costed_worker_task_swap(CostedWorkerTask *q, isize i, isize j) {
+	CostedWorkerTask tmp = q[i];
+	q[i] = q[j];
+	q[j] = tmp;
+}
+
 gb_internal isize current_thread_index(void) {
 	return current_thread ? current_thread->idx : 0;
 }
@@ -51,6 +77,8 @@ gb_internal void thread_pool_init(ThreadPool *pool, isize worker_count, char con
 	pool->threads_allocator = permanent_allocator();
 	slice_init(&pool->threads, pool->threads_allocator, worker_count + 1);
 
+	pool->costed_tasks = priority_queue_create(array_make<CostedWorkerTask>(heap_allocator(), 0, 64), costed_worker_task_cmp, costed_worker_task_swap);
+
 	// NOTE: this needs to be initialized before any thread starts
 	pool->running.store(true, std::memory_order_seq_cst);
 
@@ -75,6 +103,7 @@ gb_internal void thread_pool_destroy(ThreadPool *pool) {
 	}
 
 	gb_free(pool->threads_allocator, pool->threads.data);
+	array_free(&pool->costed_tasks.queue);
 }
 
 TaskRingBuffer *task_ring_grow(TaskRingBuffer *ring, isize bottom, isize top) {
@@ -174,12 +203,51 @@ gb_internal bool thread_pool_add_task(ThreadPool *pool, WorkerTaskProc *proc, vo
 	return true;
 }	
 
+// NOTE: `cost` is only meaningful relative to the other tasks added with a cost while the pool is
+// busy; it is only a hint to the order in which they are started
+gb_internal bool thread_pool_add_task_with_cost(ThreadPool *pool, WorkerTaskProc *proc, void *data, i64 cost) {
+	CostedWorkerTask ct = {};
+	ct.task.do_work = proc;
+	ct.task.data = data;
+	ct.cost = cost;
+
+	// NOTE: counted before it can be taken, so `tasks_left` can never drop to zero while it is pending
+	pool->tasks_left.fetch_add(1, std::memory_order_release);
+
+	mutex_lock(&pool->costed_tasks_mutex);
+	priority_queue_push(&pool->costed_tasks, ct);
+	pool->costed_tasks_count.fetch_add(1, std::memory_order_seq_cst);
+	mutex_unlock(&pool->costed_tasks_mutex);
+
+	i32 state = Someone_Waiting;
+	if (pool->tasks_available.compare_exchange_strong(state, Nobody_Waiting)) {
+		futex_broadcast(&pool->tasks_available);
+	}
+	return true;
+}
+
+gb_internal bool thread_pool_take_costed_task(ThreadPool *pool, WorkerTask *task) {
+	if (pool->costed_tasks_count.load(std::memory_order_acquire) == 0) {
+		return false;
+	}
+
+	bool ok = false;
+	mutex_lock(&pool->costed_tasks_mutex);
+	if (pool->costed_tasks.queue.count > 0) {
+		*task = priority_queue_pop(&pool->costed_tasks).task;
+		pool->costed_tasks_count.fetch_sub(1, std::memory_order_release);
+		ok = true;
+	}
+	mutex_unlock(&pool->costed_tasks_mutex);
+	return ok;
+}
+
 gb_internal void thread_pool_wait(ThreadPool *pool) {
 	WorkerTask task;
 
 	while (pool->tasks_left.load(std::memory_order_acquire)) {
-		// if we've got tasks on our queue, run them
-		while (!thread_pool_queue_take(current_thread, &task)) {
+		// if there are shared tasks with a cost or we've got tasks on our queue, run them
+		while (thread_pool_take_costed_task(pool, &task) || !thread_pool_queue_take(current_thread, &task)) {
 			task.do_work(task.data);
 			pool->tasks_left.fetch_sub(1, std::memory_order_release);
 		}
@@ -208,7 +276,7 @@ gb_internal THREAD_PROC(thread_pool_thread_proc) {
 		usize finished_tasks = 0;
 		i32 state;
 
-		while (!thread_pool_queue_take(current_thread, &task)) {
+		while (thread_pool_take_costed_task(pool, &task) || !thread_pool_queue_take(current_thread, &task)) {
 			task.do_work(task.data);
 			pool->tasks_left.fetch_sub(1, std::memory_order_release);
 
@@ -260,6 +328,12 @@ gb_internal THREAD_PROC(thread_pool_thread_proc) {
 			futex_broadcast(&pool->tasks_available);
 			break;
 		}
+		if (pool->costed_tasks_count.load(std::memory_order_seq_cst) != 0) {
+			// a task with a cost was added after we last looked; its producer may have already
+			// checked `tasks_available` before we published that we were waiting
+			pool->tasks_available.store(Nobody_Waiting);
+			continue;
+		}
 		futex_wait(&pool->tasks_available, Someone_Waiting);
 
 		main_loop_continue:;
@@ -146,12 +146,157 @@ gb_internal f64 time_stamp_as_us(TimeStamp const &ts, u64 freq) {
 	return 1000000.0*time_stamp_as_s(ts, freq);
 }
 
-#define MAIN_TIME_SECTION(str)               do { debugf("[Section] %s\n", str);                                      timings_start_section(&global_timings, str_lit(str));                } while (0)
-#define MAIN_TIME_SECTION_WITH_LEN(str, len) do { debugf("[Section] %s\n", str);                                      timings_start_section(&global_timings, make_string((u8 *)str, len)); } while (0)
+#define MAIN_TIME_SECTION(str)               do { debugf("[Section] %s\n", str); MEMORY_STATS_NEXT_PHASE(str_lit(str));                timings_start_section(&global_timings, str_lit(str));                } while (0)
+#define MAIN_TIME_SECTION_WITH_LEN(str, len) do { debugf("[Section] %s\n", str); MEMORY_STATS_NEXT_PHASE(make_string((u8 *)str, len)); timings_start_section(&global_timings, make_string((u8 *)str, len)); } while (0)
 #define TIME_SECTION(str)                    do { debugf("[Section] %s\n", str); if (build_context.show_more_timings) timings_start_section(&global_timings, str_lit(str));                } while (0)
 #define TIME_SECTION_WITH_LEN(str, len)      do { debugf("[Section] %s\n", str); if (build_context.show_more_timings) timings_start_section(&global_timings, make_string((u8 *)str, len)); } while (0)
 
 
+// Memory in use at the end of each phase, i.e. at every `MAIN_TIME_SECTION` boundary (-show-memory)
+struct MemorySnapshot {
+	String       label;
+	isize        arena_committed[ThreadArena_COUNT];
+	Slice<isize> thread_arena_committed; // [thread*ThreadArena_COUNT + kind], the first thread is the arenas used outside of the thread pool
+	isize        heap_allocated;
+	i64          malloc_in_use;           // -1 if unknown
+	i64          peak_resident;           // -1 if unknown
+};
+
+struct MemoryStats {
+	String                phase;
+	Array<MemorySnapshot> snapshots;
+};
+
+gb_internal void memory_stats_take_snapshot(MemoryStats *stats, ThreadPool *pool, String const &label) {
+	if (stats->snapshots.allocator.proc == nullptr) {
+		array_init(&stats->snapshots, heap_allocator(), 0, 16);
+	}
+
+	MemorySnapshot s = {};
+	s.label = label;
+	slice_init(&s.thread_arena_committed, heap_allocator(), (pool->threads.count+1)*cast(isize)ThreadArena_COUNT);
+
+	for (isize i = 0; i <= pool->threads.count; i++) {
+		for (isize kind = 0; kind < cast(isize)ThreadArena_COUNT; kind++) {
+			Arena *arena = nullptr;
+			if (i == 0) {
+				arena = kind == ThreadArena_Permanent ? &default_permanent_arena : &default_temporary_arena;
+			} else {
+				Thread *t = &pool->threads[i-1];
+				arena = kind == ThreadArena_Permanent ? t->permanent_arena : t->temporary_arena;
+			}
+			isize committed = arena ? arena->committed.load(std::memory_order_relaxed) : 0;
+			s.thread_arena_committed[i*cast(isize)ThreadArena_COUNT + kind] = committed;
+			s.arena_committed[kind] += committed;
+		}
+	}
+
+	s.heap_allocated = total_heap_memory_allocated.load(std::memory_order_relaxed);
+	s.malloc_in_use  = platform_malloc_in_use();
+	s.peak_resident  = platform_peak_resident_memory();
+
+	array_add(&stats->snapshots, s);
+}
+
+// NOTE: the phase is tracked even when -show-memory is not set, as the first phase starts before the flags are parsed
+gb_internal void memory_stats_next_phase(MemoryStats *stats, ThreadPool *pool, String const &next_phase, bool take_snapshot) {
+	if (take_snapshot && stats->phase.len != 0) {
+		memory_stats_take_snapshot(stats, pool, stats->phase);
+	}
+	stats->phase = next_phase;
+}
+
+// Bytes allocated through `malloc` which the `heap_allocator` did not account for, which is mostly LLVM
+gb_internal i64 memory_snapshot_other_malloc(MemorySnapshot const &s) {
+	if (s.malloc_in_use < 0) {
+		return -1;
+	}
+	return gb_max(s.malloc_in_use - cast(i64)s.heap_allocated, 0);
+}
+
+// NOTE: the `*` width of `gb_printf` does not pad strings, so pad by hand
+gb_internal void memory_stats_print_padded(String const &str, isize width, bool align_left) {
+	isize const SPACES_LEN = 256;
+	char SPACES[SPACES_LEN+1] = {0};
+	gb_memset(SPACES, ' ', SPACES_LEN);
+
+	isize padding = gb_clamp(width - str.len, 0, SPACES_LEN);
+	if (align_left) {
+		gb_printf_err("%.*s%.*s", LIT(str), cast(int)padding, SPACES);
+	} else {
+		gb_printf_err("%.*s%.*s", cast(int)padding, SPACES, LIT(str));
+	}
+}
+
+gb_internal void memory_stats_print_mib(i64 bytes) {
+	char buf[32] = {};
+	isize len = 1;
+	buf[0] = '-';
+	if (bytes >= 0) {
+		len = gb_snprintf(buf, gb_size_of(buf), "%.3f", cast(f64)bytes / cast(f64)(1024ull * 1024ull)) - 1;
+	}
+	gb_printf_err(" ");
+	memory_stats_print_padded(make_string(cast(u8 *)buf, len), 12, false);
+}
+
+gb_internal void memory_stats_print_header(isize label_width, char const *label, isize column_count, char const **columns) {
+	memory_stats_print_padded(make_string_c(label), label_width, true);
+	for (isize i = 0; i < column_count; i++) {
+		gb_printf_err(" ");
+		memory_stats_print_padded(make_string_c(columns[i]), 12, false);
+	}
+	gb_printf_err("\n");
+}
+
+gb_internal void memory_stats_print_all(MemoryStats *stats) {
+	if (stats->snapshots.count == 0) {
+		return;
+	}
+
+	isize max_len = gb_size_of("Thread (MiB)")-1;
+	for (MemorySnapshot const &s : stats->snapshots) {
+		max_len = gb_max(max_len, s.label.len);
+	}
+
+	char const *columns[] = {"Perm Arena", "Temp Arena", "Heap", "Other Malloc", "Peak RSS"};
+	gb_printf_err("\n");
+	memory_stats_print_header(max_len, "Memory (MiB)", gb_count_of(columns), columns);
+	for (MemorySnapshot const &s : stats->snapshots) {
+		memory_stats_print_padded(s.label, max_len, true);
+		memory_stats_print_mib(s.arena_committed[ThreadArena_Permanent]);
+		memory_stats_print_mib(s.arena_committed[ThreadArena_Temporary]);
+		memory_stats_print_mib(s.heap_allocated);
+		memory_stats_print_mib(memory_snapshot_other_malloc(s));
+		memory_stats_print_mib(s.peak_resident);
+		gb_printf_err("\n");
+	}
+
+	// NOTE: arenas only grow apart from temporary rewinds, so the last snapshot is close to the most used per thread
+	MemorySnapshot const &last = stats->snapshots[stats->snapshots.count-1];
+	gb_printf_err("\nArena memory per thread at the end of %.*s\n", LIT(last.label));
+	memory_stats_print_header(max_len, "Thread (MiB)", 2, columns);
+	isize thread_count = last.thread_arena_committed.count/ThreadArena_COUNT;
+	for (isize i = 0; i < thread_count; i++) {
+		isize permanent = last.thread_arena_committed[i*ThreadArena_COUNT + ThreadArena_Permanent];
+		isize temporary = last.thread_arena_committed[i*ThreadArena_COUNT + ThreadArena_Temporary];
+		if (permanent == 0 && temporary == 0) {
+			continue;
+		}
+		char buf[32] = {};
+		isize len = 0;
+		if (i == 0) {
+			len = gb_snprintf(buf, gb_size_of(buf), "no thread") - 1;
+		} else {
+			len = gb_snprintf(buf, gb_size_of(buf), "%td", i-1) - 1;
+		}
+		memory_stats_print_padded(make_string(cast(u8 *)buf, len), max_len, true);
+		memory_stats_print_mib(permanent);
+		memory_stats_print_mib(temporary);
+		gb_printf_err("\n");
+	}
+}
+
+
 enum TimingUnit {
 	TimingUnit_Second,
 	TimingUnit_Millisecond,
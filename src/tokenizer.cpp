@@ -246,6 +246,17 @@ struct Token {
 	TokenPos  pos;
 };
 
+// NOTE: The compact form of a `Token` stored in `AstFile::tokens`. The string is always a slice of the
+// file's buffer at `offset`, and the line and column are recomputed from the file's line table when the
+// token is unpacked with `ast_file_unpack_token`.
+struct PackedToken {
+	u32       offset;
+	u32       len;
+	TokenKind kind;
+	u8        flags;
+};
+GB_STATIC_ASSERT(gb_size_of(PackedToken) == 12);
+
 Token empty_token = {Token_Invalid};
 Token blank_token = {Token_Ident, 0, {cast(u8 *)"_", 1}};
 
@@ -378,6 +389,157 @@ gb_internal void advance_to_next_rune(Tokenizer *t) {
 	}
 }
 
+// NOTE: Fast paths for long runs of ASCII bytes (whitespace, identifiers, comments, and string bodies).
+// Each `tokenizer_span_*` procedure returns the number of bytes from `p` which belong to the run. A run
+// never contains '\n', NUL, or any non-ASCII byte, so line counting, error reporting, and UTF-8
+// decoding are always left to `advance_to_next_rune`.
+#if defined(GB_CPU_X86) && (defined(__SSE2__) || defined(GB_COMPILER_MSVC))
+#include <emmintrin.h>
+#define TOKENIZER_SSE2 1
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TOKENIZER_AVX2 1
+#endif
+#endif
+
+// NOTE: `x` must be non-zero
+gb_internal gb_inline u32 tokenizer_trailing_zeros_u32(u32 x) {
+#if defined(GB_COMPILER_MSVC)
+	unsigned long index = 0;
+	_BitScanForward(&index, x);
+	return cast(u32)index;
+#else
+	return cast(u32)__builtin_ctz(x);
+#endif
+}
+
+gb_internal gb_inline bool tokenizer_byte_is_ident(u8 c) {
+	u8 lower = c | 0x20;
+	return ('a' <= lower && lower <= 'z') || ('0' <= c && c <= '9') || c == '_';
+}
+
+gb_internal gb_inline bool tokenizer_byte_is_special(u8 c, u8 c0, u8 c1, u8 c2) {
+	// NUL and non-ASCII bytes always end a run
+	return c == c0 || c == c1 || c == c2 || c == 0 || c >= 0x80;
+}
+
+#if defined(TOKENIZER_SSE2)
+gb_internal gb_inline __m128i tokenizer_sse2_in_range(__m128i x, char lo, char hi) {
+	// NOTE: signed comparisons are fine as non-ASCII bytes are negative and never within an ASCII range
+	return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(cast(char)(lo-1))),
+	                     _mm_cmplt_epi8(x, _mm_set1_epi8(cast(char)(hi+1))));
+}
+#endif
+
+gb_internal isize tokenizer_span_ident(u8 const *p, u8 const *end) {
+	u8 const *start = p;
+#if defined(TOKENIZER_AVX2)
+	for (; end-p >= 32; p += 32) {
+		__m256i x     = _mm256_loadu_si256(cast(__m256i const *)p);
+		__m256i lower = _mm256_or_si256(x, _mm256_set1_epi8(0x20));
+		__m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a'-1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z'+1), lower));
+		__m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(x, _mm256_set1_epi8('0'-1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9'+1), x));
+		__m256i under = _mm256_cmpeq_epi8(x, _mm256_set1_epi8('_'));
+		u32 mask = ~cast(u32)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(alpha, digit), under));
+		if (mask != 0) {
+			return (p - start) + cast(isize)tokenizer_trailing_zeros_u32(mask);
+		}
+	}
+#endif
+#if defined(TOKENIZER_SSE2)
+	for (; end-p >= 16; p += 16) {
+		__m128i x     = _mm_loadu_si128(cast(__m128i const *)p);
+		__m128i alpha = tokenizer_sse2_in_range(_mm_or_si128(x, _mm_set1_epi8(0x20)), 'a', 'z');
+		__m128i digit = tokenizer_sse2_in_range(x, '0', '9');
+		__m128i under = _mm_cmpeq_epi8(x, _mm_set1_epi8('_'));
+		u32 mask = ~cast(u32)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(alpha, digit), under)) & 0xffff;
+		if (mask != 0) {
+			return (p - start) + cast(isize)tokenizer_trailing_zeros_u32(mask);
+		}
+	}
+#endif
+	while (p < end && tokenizer_byte_is_ident(*p)) {
+		p++;
+	}
+	return p - start;
+}
+
+gb_internal isize tokenizer_span_whitespace(u8 const *p, u8 const *end) {
+	u8 const *start = p;
+#if defined(TOKENIZER_SSE2)
+	for (; end-p >= 16; p += 16) {
+		__m128i x  = _mm_loadu_si128(cast(__m128i const *)p);
+		__m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')),
+		                                       _mm_cmpeq_epi8(x, _mm_set1_epi8('\t'))),
+		                          _mm_cmpeq_epi8(x, _mm_set1_epi8('\r')));
+		u32 mask = ~cast(u32)_mm_movemask_epi8(ws) & 0xffff;
+		if (mask != 0) {
+			return (p - start) + cast(isize)tokenizer_trailing_zeros_u32(mask);
+		}
+	}
+#endif
+	while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+		p++;
+	}
+	return p - start;
+}
+
+// Returns the number of bytes before the first `c0`, `c1`, `c2`, NUL, or non-ASCII byte
+gb_internal isize tokenizer_span_until(u8 const *p, u8 const *end, u8 c0, u8 c1, u8 c2) {
+	u8 const *start = p;
+#if defined(TOKENIZER_AVX2)
+	{
+		__m256i v0  = _mm256_set1_epi8(cast(char)c0);
+		__m256i v1  = _mm256_set1_epi8(cast(char)c1);
+		__m256i v2  = _mm256_set1_epi8(cast(char)c2);
+		__m256i one = _mm256_set1_epi8(1);
+		for (; end-p >= 32; p += 32) {
+			__m256i x = _mm256_loadu_si256(cast(__m256i const *)p);
+			__m256i stop = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, v0), _mm256_cmpeq_epi8(x, v1)),
+			                               _mm256_or_si256(_mm256_cmpeq_epi8(x, v2), _mm256_cmpgt_epi8(one, x)));
+			u32 mask = cast(u32)_mm256_movemask_epi8(stop);
+			if (mask != 0) {
+				return (p - start) + cast(isize)tokenizer_trailing_zeros_u32(mask);
+			}
+		}
+	}
+#endif
+#if defined(TOKENIZER_SSE2)
+	{
+		__m128i v0  = _mm_set1_epi8(cast(char)c0);
+		__m128i v1  = _mm_set1_epi8(cast(char)c1);
+		__m128i v2  = _mm_set1_epi8(cast(char)c2);
+		__m128i one = _mm_set1_epi8(1);
+		for (; end-p >= 16; p += 16) {
+			__m128i x = _mm_loadu_si128(cast(__m128i const *)p);
+			// NOTE: `1 > x` (signed) catches both NUL and every byte >= 0x80
+			__m128i stop = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, v0), _mm_cmpeq_epi8(x, v1)),
+			                            _mm_or_si128(_mm_cmpeq_epi8(x, v2), _mm_cmpgt_epi8(one, x)));
+			u32 mask = cast(u32)_mm_movemask_epi8(stop);
+			if (mask != 0) {
+				return (p - start) + cast(isize)tokenizer_trailing_zeros_u32(mask);
+			}
+		}
+	}
+#endif
+	while (p < end && !tokenizer_byte_is_special(*p, c0, c1, c2)) {
+		p++;
+	}
+	return p - start;
+}
+
+// Moves the tokenizer forward over `n` bytes previously accepted by a `tokenizer_span_*` procedure,
+// leaving `curr_rune` as the last of them. The current rune must not be '\n' as the line would not be counted.
+gb_internal gb_inline void tokenizer_skip_ascii_run(Tokenizer *t, isize n) {
+	GB_ASSERT(t->curr_rune != '\n');
+	if (n > 0) {
+		t->curr = t->read_curr + n - 1;
+		t->read_curr += n;
+		t->curr_rune = *t->curr;
+		t->column_minus_one += cast(i32)n;
+	}
+}
+
 gb_internal void init_tokenizer_with_data(Tokenizer *t, String const &fullpath, void const *data, isize size) {
 	t->fullpath = fullpath;
 	t->column_minus_one = -1;
@@ -651,6 +813,7 @@ gb_internal bool scan_escape(Tokenizer *t) {
 
 gb_internal gb_inline void tokenizer_skip_line(Tokenizer *t) {
 	while (t->curr_rune != '\n' && t->curr_rune != GB_RUNE_EOF) {
+		tokenizer_skip_ascii_run(t, tokenizer_span_until(t->read_curr, t->end, '\n', '\n', '\n'));
 		advance_to_next_rune(t);
 	}
 }
@@ -662,6 +825,7 @@ gb_internal gb_inline void tokenizer_skip_whitespace(Tokenizer *t, bool on_newli
 			case ' ':
 			case '\t':
 			case '\r':
+				tokenizer_skip_ascii_run(t, tokenizer_span_whitespace(t->read_curr, t->end));
 				advance_to_next_rune(t);
 				continue;
 			}
@@ -671,9 +835,12 @@ gb_internal gb_inline void tokenizer_skip_whitespace(Tokenizer *t, bool on_newli
 		for (;;) {
 			switch (t->curr_rune) {
 			case '\n':
+				advance_to_next_rune(t);
+				continue;
 			case ' ':
 			case '\t':
 			case '\r':
+				tokenizer_skip_ascii_run(t, tokenizer_span_whitespace(t->read_curr, t->end));
 				advance_to_next_rune(t);
 				continue;
 			}
@@ -699,6 +866,7 @@ gb_internal void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 	if (rune_is_letter(curr_rune)) {
 		token->kind = Token_Ident;
 		while (rune_is_letter_or_digit(t->curr_rune)) {
+			tokenizer_skip_ascii_run(t, tokenizer_span_ident(t->read_curr, t->end));
 			advance_to_next_rune(t);
 		}
 
@@ -803,6 +971,9 @@ gb_internal void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 							tokenizer_err(t, "Triple-quote multi-line string literal not terminated");
 							break;
 						}
+						if (r != quote && r != '\\' && r != '\n') {
+							tokenizer_skip_ascii_run(t, tokenizer_span_until(t->read_curr, t->end, '"', '\\', '\n'));
+						}
 						advance_to_next_rune(t);
 						// A closing `"""` is three consecutive quotes: `r` plus the
 						// next two runes. `t->curr_rune` is now the second quote and
@@ -825,6 +996,9 @@ gb_internal void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 						tokenizer_err(t, "String literal not terminated");
 						break;
 					}
+					if (r != quote && r != '\\') {
+						tokenizer_skip_ascii_run(t, tokenizer_span_until(t->read_curr, t->end, '"', '\\', '\n'));
+					}
 					advance_to_next_rune(t);
 					if (r == quote) {
 						break;
@@ -843,6 +1017,9 @@ gb_internal void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 							tokenizer_err(t, "Triple-quote multi-line string literal not terminated");
 							break;
 						}
+						if (r != quote && r != '\n') {
+							tokenizer_skip_ascii_run(t, tokenizer_span_until(t->read_curr, t->end, '`', '\n', '\n'));
+						}
 						advance_to_next_rune(t);
 						if (r == quote && t->curr_rune == '`' && peek_byte(t, 0) == '`') {
 							advance_to_next_rune(t); // consume the second closing ```
@@ -859,6 +1036,9 @@ gb_internal void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 						tokenizer_err(t, "String literal not terminated");
 						break;
 					}
+					if (r != quote && r != '\n') {
+						tokenizer_skip_ascii_run(t, tokenizer_span_until(t->read_curr, t->end, '`', '\n', '\n'));
+					}
 					advance_to_next_rune(t);
 					if (r == quote) {
 						break;
@@ -1033,6 +1213,9 @@ gb_internal void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 							comment_scope--;
 						}
 					} else {
+						if (t->curr_rune != '\n') {
+							tokenizer_skip_ascii_run(t, tokenizer_span_until(t->read_curr, t->end, '/', '*', '\n'));
+						}
 						advance_to_next_rune(t);
 					}
 				}
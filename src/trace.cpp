@@ -0,0 +1,207 @@
+// Records what each thread of the compiler is doing for `-export-trace:<filename>`, which is written
+// out in the Chrome Trace Event format (viewable with chrome://tracing, Perfetto, Speedscope, etc).
+//
+// Each thread appends its events to its own buffer, so recording an event never takes a lock. The
+// buffers are only read once all of the work has finished, when the trace is exported.
+
+enum : isize {
+	TRACE_CHUNK_EVENT_COUNT = 1024,
+	TRACE_TEXT_BLOCK_SIZE   = 64*1024,
+};
+
+struct TraceEvent {
+	char const *name;
+	String      detail;
+	u64         start;
+	u64         finish;
+};
+
+struct TraceChunk {
+	TraceChunk *next;
+	isize       count;
+	TraceEvent  events[TRACE_CHUNK_EVENT_COUNT];
+};
+
+struct TraceThreadBuffer {
+	TraceThreadBuffer *next;
+	isize              thread_index;
+	TraceChunk *       first;
+	TraceChunk *       last;
+
+	// NOTE: the details are copied as the strings they point to may not live until the export
+	u8 *  text;
+	isize text_remaining;
+};
+
+gb_global std::atomic<TraceThreadBuffer *> trace_thread_buffers;
+gb_global gb_thread_local TraceThreadBuffer *trace_local_buffer;
+
+gb_internal gb_inline bool trace_enabled(void) {
+	return build_context.export_trace_file.len > 0;
+}
+
+gb_internal TraceThreadBuffer *trace_get_local_buffer(void) {
+	TraceThreadBuffer *buffer = trace_local_buffer;
+	if (buffer == nullptr) {
+		buffer = gb_alloc_item(heap_allocator(), TraceThreadBuffer);
+		buffer->thread_index = current_thread_index();
+
+		TraceThreadBuffer *head = trace_thread_buffers.load(std::memory_order_relaxed);
+		do {
+			buffer->next = head;
+		} while (!trace_thread_buffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+
+		trace_local_buffer = buffer;
+	}
+	return buffer;
+}
+
+gb_internal String trace_copy_detail(TraceThreadBuffer *buffer, String detail) {
+	if (detail.len <= 0) {
+		return {};
+	}
+	detail.len = gb_min(detail.len, TRACE_TEXT_BLOCK_SIZE);
+	if (buffer->text_remaining < detail.len) {
+		buffer->text = cast(u8 *)gb_alloc(heap_allocator(), TRACE_TEXT_BLOCK_SIZE);
+		buffer->text_remaining = TRACE_TEXT_BLOCK_SIZE;
+	}
+	String copy = {buffer->text, detail.len};
+	gb_memmove(copy.text, detail.text, detail.len);
+	buffer->text           += detail.len;
+	buffer->text_remaining -= detail.len;
+	return copy;
+}
+
+gb_internal u64 trace_begin(void) {
+	if (!trace_enabled()) {
+		return 0;
+	}
+	return time_stamp_time_now();
+}
+
+// `name` must be a string literal, `detail` is copied
+gb_internal void trace_end(u64 start, char const *name, String detail) {
+	if (start == 0) {
+		return;
+	}
+	u64 finish = time_stamp_time_now();
+
+	TraceThreadBuffer *buffer = trace_get_local_buffer();
+	TraceChunk *chunk = buffer->last;
+	if (chunk == nullptr || chunk->count == TRACE_CHUNK_EVENT_COUNT) {
+		TraceChunk *next = gb_alloc_item(heap_allocator(), TraceChunk);
+		if (chunk) {
+			chunk->next = next;
+		} else {
+			buffer->first = next;
+		}
+		buffer->last = next;
+		chunk = next;
+	}
+
+	TraceEvent *event = &chunk->events[chunk->count++];
+	event->name   = name;
+	event->detail = trace_copy_detail(buffer, detail);
+	event->start  = start;
+	event->finish = finish;
+}
+
+struct TraceScope {
+	char const *name;
+	String      detail;
+	u64         start;
+
+	TraceScope(char const *name, String const &detail) : name{name}, detail{detail}, start{trace_begin()} {}
+	~TraceScope() {
+		trace_end(this->start, this->name, this->detail);
+	}
+};
+
+// Records the enclosing scope as an event of the current thread
+#define TRACE_SCOPE(name, detail) TraceScope GB_DEFER_3(_trace_scope_){name, detail}
+
+gb_internal void trace_write_json_string(gbFile *f, String s) {
+	gb_file_write(f, "\"", 1);
+	isize run_start = 0;
+	for (isize i = 0; i < s.len; i++) {
+		u8 c = s[i];
+		if (c >= 0x20 && c != '"' && c != '\\') {
+			continue;
+		}
+		gb_file_write(f, s.text+run_start, i-run_start);
+		run_start = i+1;
+		switch (c) {
+		case '"':  gb_file_write(f, "\\\"", 2); break;
+		case '\\': gb_file_write(f, "\\\\", 2); break;
+		case '\n': gb_file_write(f, "\\n",  2); break;
+		case '\t': gb_file_write(f, "\\t",  2); break;
+		default:   gb_fprintf(f, "\\u%04x", c); break;
+		}
+	}
+	gb_file_write(f, s.text+run_start, s.len-run_start);
+	gb_file_write(f, "\"", 1);
+}
+
+gb_internal void trace_write_event(gbFile *f, bool *first, u64 origin, u64 freq, isize tid, char const *cat, String name, String detail, u64 start, u64 finish) {
+	if (finish < start) {
+		finish = start;
+	}
+	f64 ts  = 1.0e6 * cast(f64)(start - gb_min(start, origin)) / cast(f64)freq;
+	f64 dur = 1.0e6 * cast(f64)(finish - start) / cast(f64)freq;
+
+	gb_fprintf(f, "%s\n\t\t{\"ph\": \"X\", \"pid\": 1, \"tid\": %td, \"cat\": \"%s\", \"ts\": %.3f, \"dur\": %.3f, \"name\": ", *first ? "" : ",", tid, cat, ts, dur);
+	trace_write_json_string(f, name);
+	if (detail.len > 0) {
+		gb_fprintf(f, ", \"args\": {\"detail\": ");
+		trace_write_json_string(f, detail);
+		gb_fprintf(f, "}");
+	}
+	gb_fprintf(f, "}");
+	*first = false;
+}
+
+// Writes the events of every thread and the sections of `t` (on the main thread). This must only be
+// called once no more tasks are running.
+gb_internal void trace_export_all(Timings *t) {
+	GB_ASSERT(trace_enabled());
+
+	char const *filename = alloc_cstring(heap_allocator(), build_context.export_trace_file);
+	defer (gb_free(heap_allocator(), cast(void *)filename));
+
+	gbFile f = {};
+	if (gb_file_open_mode(&f, gbFileMode_Write, filename) != gbFileError_None) {
+		gb_printf_err("Failed to export the trace to: %s\n", filename);
+		return;
+	}
+	defer (gb_file_close(&f));
+
+	u64 origin = t->total.start;
+	u64 freq   = t->freq;
+	u64 now    = time_stamp_time_now();
+
+	isize thread_count = global_thread_pool.threads.count;
+
+	gb_fprintf(&f, "{\n\t\"displayTimeUnit\": \"ms\",\n\t\"traceEvents\": [");
+	bool first = true;
+	for (isize i = 0; i < thread_count; i++) {
+		gb_fprintf(&f, "%s\n\t\t{\"ph\": \"M\", \"pid\": 1, \"tid\": %td, \"name\": \"thread_name\", \"args\": {\"name\": \"%s %td\"}}",
+		           first ? "" : ",", i, i == 0 ? "Main Thread" : "Worker", i);
+		first = false;
+	}
+
+	for (TimeStamp const &ts : t->sections) {
+		u64 finish = ts.finish != 0 ? ts.finish : now;
+		trace_write_event(&f, &first, origin, freq, 0, "section", ts.label, {}, ts.start, finish);
+	}
+
+	for (TraceThreadBuffer *buffer = trace_thread_buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next) {
+		for (TraceChunk *chunk = buffer->first; chunk != nullptr; chunk = chunk->next) {
+			for (isize i = 0; i < chunk->count; i++) {
+				TraceEvent const &e = chunk->events[i];
+				trace_write_event(&f, &first, origin, freq, buffer->thread_index, "task", make_string_c(e.name), e.detail, e.start, e.finish);
+			}
+		}
+	}
+
+	gb_fprintf(&f, "\n\t]\n}\n");
+}
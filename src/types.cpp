@@ -199,6 +199,7 @@ struct TypeProc {
 	i32      variadic_index;
 	String   require_target_feature;
 	String   enable_target_feature;
+	String   target_clones;
 	// TODO(bill): Make this a flag set rather than bools
 	bool     variadic;
 	bool     require_results;
@@ -3456,6 +3457,146 @@ gb_internal bool are_types_identical_internal(Type *x, Type *y, bool check_tuple
 	return false;
 }
 
+gb_internal gb_inline u64 type_hash_identical_mix(u64 hash, u64 value) {
+	return (hash ^ value) * 0x100000001b3ull;
+}
+
+// A hash for which `are_types_identical(x, y)` implies `type_hash_identical(x) == type_hash_identical(y)`.
+// Named types are hashed by their entity and are not walked into, so no string is built (unlike
+// `type_hash_canonical_type`) and the hash stays the same while a named record is still being checked.
+gb_internal u64 type_hash_identical(Type *type) {
+	while (type != nullptr && type->kind == Type_Named && type->Named.type_name->TypeName.is_type_alias) {
+		type = type->Named.base;
+	}
+	if (type == nullptr) {
+		return 0;
+	}
+
+	u64 h = type_hash_identical_mix(0xcbf29ce484222325ull, type->kind);
+	switch (type->kind) {
+	case Type_Generic:
+		h = type_hash_identical_mix(h, type_hash_identical(type->Generic.specialized));
+		break;
+
+	case Type_Basic:
+		h = type_hash_identical_mix(h, type->Basic.kind);
+		break;
+
+	case Type_Named:
+		h = type_hash_identical_mix(h, cast(u64)cast(uintptr)type->Named.type_name);
+		break;
+
+	case Type_Pointer:      h = type_hash_identical_mix(h, type_hash_identical(type->Pointer.elem));      break;
+	case Type_MultiPointer: h = type_hash_identical_mix(h, type_hash_identical(type->MultiPointer.elem)); break;
+	case Type_SoaPointer:   h = type_hash_identical_mix(h, type_hash_identical(type->SoaPointer.elem));   break;
+	case Type_Slice:        h = type_hash_identical_mix(h, type_hash_identical(type->Slice.elem));        break;
+	case Type_DynamicArray: h = type_hash_identical_mix(h, type_hash_identical(type->DynamicArray.elem)); break;
+
+	case Type_Array:
+		h = type_hash_identical_mix(h, cast(u64)type->Array.count);
+		h = type_hash_identical_mix(h, type_hash_identical(type->Array.elem));
+		break;
+
+	case Type_FixedCapacityDynamicArray:
+		h = type_hash_identical_mix(h, cast(u64)type->FixedCapacityDynamicArray.capacity);
+		h = type_hash_identical_mix(h, type_hash_identical(type->FixedCapacityDynamicArray.elem));
+		break;
+
+	case Type_EnumeratedArray:
+		h = type_hash_identical_mix(h, type_hash_identical(type->EnumeratedArray.index));
+		h = type_hash_identical_mix(h, type_hash_identical(type->EnumeratedArray.elem));
+		break;
+
+	case Type_Matrix:
+		h = type_hash_identical_mix(h, cast(u64)type->Matrix.row_count);
+		h = type_hash_identical_mix(h, cast(u64)type->Matrix.column_count);
+		h = type_hash_identical_mix(h, type->Matrix.is_row_major);
+		h = type_hash_identical_mix(h, type_hash_identical(type->Matrix.elem));
+		break;
+
+	case Type_Map:
+		h = type_hash_identical_mix(h, type_hash_identical(type->Map.key));
+		h = type_hash_identical_mix(h, type_hash_identical(type->Map.value));
+		break;
+
+	case Type_SimdVector:
+		h = type_hash_identical_mix(h, cast(u64)type->SimdVector.count);
+		h = type_hash_identical_mix(h, type_hash_identical(type->SimdVector.elem));
+		break;
+
+	case Type_BitSet:
+		// NOTE: the bounds are not hashed, they are ignored for enum elements
+		h = type_hash_identical_mix(h, type_hash_identical(type->BitSet.elem));
+		h = type_hash_identical_mix(h, type_hash_identical(type->BitSet.underlying));
+		break;
+
+	case Type_Enum:
+		h = type_hash_identical_mix(h, type_hash_identical(type->Enum.base_type));
+		h = type_hash_identical_mix(h, cast(u64)type->Enum.fields.count);
+		for (Entity *f : type->Enum.fields) {
+			h = type_hash_identical_mix(h, string_hash(f->token.string));
+		}
+		break;
+
+	case Type_Union:
+		h = type_hash_identical_mix(h, type->Union.kind);
+		h = type_hash_identical_mix(h, cast(u64)type->Union.variants.count);
+		for (Type *variant : type->Union.variants) {
+			h = type_hash_identical_mix(h, type_hash_identical(variant));
+		}
+		break;
+
+	case Type_Struct:
+		h = type_hash_identical_mix(h, type->Struct.is_raw_union);
+		h = type_hash_identical_mix(h, type->Struct.is_packed);
+		h = type_hash_identical_mix(h, type->Struct.is_all_or_none);
+		h = type_hash_identical_mix(h, type->Struct.soa_kind);
+		h = type_hash_identical_mix(h, cast(u64)type->Struct.soa_count);
+		h = type_hash_identical_mix(h, type_hash_identical(type->Struct.soa_elem));
+		h = type_hash_identical_mix(h, cast(u64)type->Struct.fields.count);
+		for (Entity *f : type->Struct.fields) {
+			h = type_hash_identical_mix(h, string_hash(f->token.string));
+			h = type_hash_identical_mix(h, type_hash_identical(f->type));
+		}
+		break;
+
+	case Type_Tuple:
+		h = type_hash_identical_mix(h, type->Tuple.is_packed);
+		h = type_hash_identical_mix(h, cast(u64)type->Tuple.variables.count);
+		for (Entity *e : type->Tuple.variables) {
+			h = type_hash_identical_mix(h, e->kind);
+			h = type_hash_identical_mix(h, type_hash_identical(e->type));
+			if (e->kind == Entity_Constant) {
+				h = type_hash_identical_mix(h, hash_exact_value_for_equality(e->Constant.value));
+			}
+		}
+		break;
+
+	case Type_Proc:
+		h = type_hash_identical_mix(h, type->Proc.calling_convention);
+		h = type_hash_identical_mix(h, type->Proc.c_vararg);
+		h = type_hash_identical_mix(h, type->Proc.variadic);
+		h = type_hash_identical_mix(h, type->Proc.diverging);
+		h = type_hash_identical_mix(h, type->Proc.optional_ok);
+		h = type_hash_identical_mix(h, type_hash_identical(type->Proc.params));
+		h = type_hash_identical_mix(h, type_hash_identical(type->Proc.results));
+		break;
+
+	case Type_BitField:
+		h = type_hash_identical_mix(h, type_hash_identical(type->BitField.backing_type));
+		h = type_hash_identical_mix(h, cast(u64)type->BitField.fields.count);
+		for_array(i, type->BitField.fields) {
+			Entity *f = type->BitField.fields[i];
+			h = type_hash_identical_mix(h, string_hash(f->token.string));
+			h = type_hash_identical_mix(h, type_hash_identical(f->type));
+			h = type_hash_identical_mix(h, type->BitField.bit_sizes[i]);
+			h = type_hash_identical_mix(h, type->BitField.bit_offsets[i]);
+		}
+		break;
+	}
+	return h;
+}
+
 gb_internal Type *default_type(Type *type) {
 	if (type == nullptr) {
 		return t_invalid;
@@ -0,0 +1,85 @@
+#!/usr/bin/env bash
+set -eu
+
+# `-ast-cache` round trip.
+#
+# The first build stores a snapshot of every library file it parses, the second one loads them.
+# Both must give the same program and the same errors as a build without the cache, also when a
+# snapshot has been damaged.
+
+here=$(cd "$(dirname "$0")" && pwd)
+: "${ODIN:=$here/../../odin}"
+
+rm -rf "$here/build"
+mkdir -p "$here/build/ok" "$here/build/bad"
+pushd "$here/build" > /dev/null
+
+cat > ok/main.odin <<'ODIN'
+package main
+
+import "core:encoding/json"
+import "core:fmt"
+import "core:slice"
+import "core:strings"
+
+main :: proc() {
+	xs := []int{3, 1, 2}
+	slice.sort(xs)
+	data, _ := json.marshal(xs)
+	fmt.println(strings.to_upper("sorted"), string(data))
+}
+ODIN
+cat > bad/main.odin <<'ODIN'
+package main
+
+import "core:slice"
+
+S :: struct { x: int }
+
+main :: proc() {
+	s: []S
+	slice.sort(s)
+}
+ODIN
+
+set -x
+
+want=$($ODIN run ok -out:ok_main)
+$ODIN build bad -out:bad_main > bad_want.txt 2>&1 && exit 1
+
+$ODIN build ok -ast-cache -out:ok_main
+count=$(ls .odin-cache/ast | wc -l)
+[ "$count" -gt 0 ]
+
+[ "$($ODIN run ok -ast-cache -out:ok_main)" = "$want" ]
+[ "$(ls .odin-cache/ast | wc -l)" -eq "$count" ]
+
+# errors point into the library files that were loaded from their snapshots
+$ODIN build bad -ast-cache -out:bad_main > bad_got.txt 2>&1 && exit 1
+diff bad_want.txt bad_got.txt
+
+# a snapshot whose pointers lead outside of it is parsed again
+python3 - .odin-cache/ast/*.odin-ast <<'PY'
+import struct, sys
+for path in sys.argv[1:]:
+	data = bytearray(open(path, 'rb').read())
+	# AstSnapshotHeader: magic, version, ast_size, layout, key, source_len, line_count, then (offset, count) per section
+	blob_offset, blob_size = struct.unpack_from('<II', data, 48 + 8*2)
+	relocs_offset, relocs_count = struct.unpack_from('<II', data, 48 + 8*3)
+	if relocs_count > 0:
+		at = struct.unpack_from('<I', data, relocs_offset)[0]
+		struct.pack_into('<Q', data, blob_offset + at, blob_size + 4096)
+		open(path, 'wb').write(data)
+PY
+[ "$($ODIN run ok -ast-cache -out:ok_main)" = "$want" ]
+
+# a damaged snapshot is parsed again
+for f in .odin-cache/ast/*.odin-ast; do
+	head -c 100 "$f" > "$f.tmp" && mv "$f.tmp" "$f"
+done
+[ "$($ODIN run ok -ast-cache -out:ok_main)" = "$want" ]
+
+set +x
+
+popd > /dev/null
+echo "SUCCESSFUL 1/1"
@@ -5,4 +5,5 @@ package benchmarks
 @(require) import "hash"
 @(require) import "math"
 @(require) import "text/regex"
-@(require) import "strings"
\ No newline at end of file
+@(require) import "strings"
+@(require) import "string_switch"
\ No newline at end of file
@@ -0,0 +1,140 @@
+package benchmark_string_switch
+
+import "core:fmt"
+import "core:log"
+import "core:testing"
+import "core:strings"
+import "core:text/table"
+import "core:time"
+
+RUNS :: 200_000
+
+keys := [?]string {
+	"GET", "PUT", "POST", "HEAD", "PATCH", "TRACE", "DELETE", "OPTIONS", "CONNECT",
+	"Accept", "Cookie", "Expect", "Origin", "Referer", "Upgrade", "Host", "Range",
+	"Content-Type", "Content-Length", "Cache-Control", "Connection", "User-Agent",
+	"Authorization", "Transfer-Encoding",
+	"X-Unknown", "", "Hosts", "content-type",
+}
+
+// A `switch` on constant strings, which uses the length and byte dispatch.
+switch_lookup :: proc "contextless" (s: string) -> int {
+	switch s {
+	case "GET":               return 1
+	case "PUT":               return 2
+	case "POST":              return 3
+	case "HEAD":              return 4
+	case "PATCH":             return 5
+	case "TRACE":             return 6
+	case "DELETE":            return 7
+	case "OPTIONS":           return 8
+	case "CONNECT":           return 9
+	case "Accept":            return 10
+	case "Cookie":            return 11
+	case "Expect":            return 12
+	case "Origin":            return 13
+	case "Referer":           return 14
+	case "Upgrade":           return 15
+	case "Host":              return 16
+	case "Range":             return 17
+	case "Content-Type":      return 18
+	case "Content-Length":    return 19
+	case "Cache-Control":     return 20
+	case "Connection":        return 21
+	case "User-Agent":        return 22
+	case "Authorization":     return 23
+	case "Transfer-Encoding": return 24
+	}
+	return 0
+}
+
+// The same lookup as a chain of string comparisons, which is what the `switch` used to lower to.
+chain_lookup :: proc "contextless" (s: string) -> int {
+	if s == "GET"               { return 1  }
+	if s == "PUT"               { return 2  }
+	if s == "POST"              { return 3  }
+	if s == "HEAD"              { return 4  }
+	if s == "PATCH"             { return 5  }
+	if s == "TRACE"             { return 6  }
+	if s == "DELETE"            { return 7  }
+	if s == "OPTIONS"           { return 8  }
+	if s == "CONNECT"           { return 9  }
+	if s == "Accept"            { return 10 }
+	if s == "Cookie"            { return 11 }
+	if s == "Expect"            { return 12 }
+	if s == "Origin"            { return 13 }
+	if s == "Referer"           { return 14 }
+	if s == "Upgrade"           { return 15 }
+	if s == "Host"              { return 16 }
+	if s == "Range"             { return 17 }
+	if s == "Content-Type"      { return 18 }
+	if s == "Content-Length"    { return 19 }
+	if s == "Cache-Control"     { return 20 }
+	if s == "Connection"        { return 21 }
+	if s == "User-Agent"        { return 22 }
+	if s == "Authorization"     { return 23 }
+	if s == "Transfer-Encoding" { return 24 }
+	return 0
+}
+
+run_trial :: proc(lookup: proc "contextless" (string) -> int, runs: int) -> (timing: time.Duration, accumulator: int) {
+	// Copy the keys so that they do not share their data with the constants in the procedures.
+	inputs := make([]string, len(keys))
+	defer {
+		for s in inputs {
+			delete(s)
+		}
+		delete(inputs)
+	}
+	for key, i in keys {
+		inputs[i] = strings.clone(key)
+	}
+
+	watch: time.Stopwatch
+
+	time.stopwatch_start(&watch)
+	for _ in 0..<runs {
+		for s in inputs {
+			accumulator += lookup(s)
+		}
+	}
+	time.stopwatch_stop(&watch)
+	timing = time.stopwatch_duration(watch)
+	return
+}
+
+@test
+benchmark_string_switch :: proc(t: ^testing.T) {
+	for key in keys {
+		testing.expect_value(t, switch_lookup(key), chain_lookup(key))
+	}
+
+	chain_timing,  chain_accumulator  := run_trial(chain_lookup,  RUNS)
+	switch_timing, switch_accumulator := run_trial(switch_lookup, RUNS)
+	testing.expect_value(t, switch_accumulator, chain_accumulator)
+
+	string_buffer := strings.builder_make()
+	defer strings.builder_destroy(&string_buffer)
+
+	tbl: table.Table
+	table.init(&tbl)
+	defer table.destroy(&tbl)
+
+	table.aligned_header_of_values(&tbl, .Right, "Keys", "Iterations", "Chain", "Switch", "Switch Relative (x)")
+	table.aligned_row_of_values(
+		&tbl,
+		.Right,
+		len(keys),
+		RUNS,
+		fmt.tprintf("%8M", chain_timing),
+		fmt.tprintf("%8M", switch_timing),
+		fmt.tprintf("%.3f x", 1 / (f64(switch_timing) / f64(chain_timing))),
+	)
+
+	builder_writer := strings.to_writer(&string_buffer)
+
+	fmt.sbprintln(&string_buffer)
+	table.write_plain_table(builder_writer, &tbl)
+
+	log.info(strings.to_string(string_buffer))
+}
@@ -0,0 +1,109 @@
+package test_internal
+
+import "core:testing"
+
+@(private="file")
+COLORS :: map[string]int{
+	"red"     = 0xff0000,
+	"green"   = 0x00ff00,
+	"blue"    = 0x0000ff,
+	"black"   = 0x000000,
+	"white"   = 0xffffff,
+	"cyan"    = 0x00ffff,
+	"magenta" = 0xff00ff,
+	"yellow"  = 0xffff00,
+	""        = -1,
+}
+
+@(private="file")
+Point :: struct {
+	x, y: i16,
+}
+
+@(private="file")
+CORNERS :: map[i64]Point{
+	-1          = {-1, -1},
+	0           = {0, 0},
+	1           = {1, 1},
+	1 << 40     = {40, 40},
+	min(i64)    = {-64, -64},
+	max(i64)    = {64, 64},
+}
+
+@(private="file")
+EMPTY :: map[u8]bool{}
+
+@test
+test_constant_map_string_keys :: proc(t: ^testing.T) {
+	names := []string{"red", "green", "blue", "black", "white", "cyan", "magenta", "yellow", ""}
+	for name in names {
+		v, ok := COLORS[name]
+		testing.expect(t, ok)
+		testing.expect(t, name in COLORS)
+		testing.expect_value(t, v, COLORS[name])
+	}
+	testing.expect_value(t, COLORS["red"], 0xff0000)
+	testing.expect_value(t, COLORS["yellow"], 0xffff00)
+
+	missing := []string{"Red", "gree", "blues", "orange", " "}
+	for name in missing {
+		v, ok := COLORS[name]
+		testing.expect(t, !ok)
+		testing.expect_value(t, v, 0)
+		testing.expect(t, name not_in COLORS)
+		testing.expect_value(t, COLORS[name] or_else 7, 7)
+	}
+
+	testing.expect_value(t, len(COLORS), 9)
+	#assert("cyan" in COLORS)
+	#assert("purple" not_in COLORS)
+}
+
+@test
+test_constant_map_integer_keys :: proc(t: ^testing.T) {
+	keys := []i64{-1, 0, 1, 1 << 40, min(i64), max(i64)}
+	for key in keys {
+		p, ok := CORNERS[key]
+		testing.expect(t, ok)
+		testing.expect(t, key in CORNERS)
+		testing.expect_value(t, p, CORNERS[key])
+	}
+	testing.expect_value(t, CORNERS[1 << 40].x, 40)
+	testing.expect_value(t, CORNERS[min(i64)].y, -64)
+
+	for key in ([]i64{2, -2, 1 << 41, max(i64) - 1}) {
+		testing.expect(t, key not_in CORNERS)
+		testing.expect_value(t, CORNERS[key], Point{})
+	}
+}
+
+@test
+test_constant_map_empty :: proc(t: ^testing.T) {
+	key := u8(3)
+	v, ok := EMPTY[key]
+	testing.expect(t, !ok)
+	testing.expect(t, !v)
+	testing.expect(t, key not_in EMPTY)
+	testing.expect_value(t, len(EMPTY), 0)
+}
+
+@test
+test_constant_map_many_keys :: proc(t: ^testing.T) {
+	SQUARES :: map[u16]u32{
+		  0 =     0,   1 =     1,   2 =     4,   3 =     9,   4 =    16,   5 =    25,   6 =    36,   7 =    49,
+		  8 =    64,   9 =    81,  10 =   100,  11 =   121,  12 =   144,  13 =   169,  14 =   196,  15 =   225,
+		 16 =   256,  17 =   289,  18 =   324,  19 =   361,  20 =   400,  21 =   441,  22 =   484,  23 =   529,
+		 24 =   576,  25 =   625,  26 =   676,  27 =   729,  28 =   784,  29 =   841,  30 =   900,  31 =   961,
+		100 = 10000, 200 = 40000, 300 = 90000,
+	}
+	for i in u16(0)..<32 {
+		v, ok := SQUARES[i]
+		testing.expect(t, ok)
+		testing.expect_value(t, v, u32(i)*u32(i))
+	}
+	for i in u16(32)..<100 {
+		testing.expect(t, i not_in SQUARES)
+	}
+	x := u16(300)
+	testing.expect_value(t, SQUARES[x], 90000)
+}
@@ -0,0 +1,55 @@
+package test_internal
+
+import "core:testing"
+
+@(private="file")
+classify_rune :: proc(r: rune) -> int {
+	switch r {
+	case 'a'..='z':      return 1
+	case 'A'..='Z':      return 2
+	case '0'..<'9', '9': return 3
+	case '_':            return 4
+	case ' ', '\t':      return 5
+	}
+	return 0
+}
+
+@(private="file")
+classify_typeid :: proc(id: typeid) -> int {
+	switch id {
+	case i32:            return 1
+	case u8, u16:        return 2
+	case string:         return 3
+	case typeid_of(f64): return 4
+	case:                return 0
+	}
+}
+
+@test
+test_switch_range_jump_table :: proc(t: ^testing.T) {
+	testing.expect_value(t, classify_rune('a'), 1)
+	testing.expect_value(t, classify_rune('m'), 1)
+	testing.expect_value(t, classify_rune('z'), 1)
+	testing.expect_value(t, classify_rune('A'), 2)
+	testing.expect_value(t, classify_rune('Z'), 2)
+	testing.expect_value(t, classify_rune('0'), 3)
+	testing.expect_value(t, classify_rune('8'), 3)
+	testing.expect_value(t, classify_rune('9'), 3)
+	testing.expect_value(t, classify_rune('_'), 4)
+	testing.expect_value(t, classify_rune('\t'), 5)
+	testing.expect_value(t, classify_rune('{'), 0)
+	testing.expect_value(t, classify_rune('`'), 0)
+	testing.expect_value(t, classify_rune('@'), 0)
+	testing.expect_value(t, classify_rune('Ω'), 0)
+}
+
+@test
+test_switch_typeid_jump_table :: proc(t: ^testing.T) {
+	testing.expect_value(t, classify_typeid(i32),    1)
+	testing.expect_value(t, classify_typeid(u8),     2)
+	testing.expect_value(t, classify_typeid(u16),    2)
+	testing.expect_value(t, classify_typeid(string), 3)
+	testing.expect_value(t, classify_typeid(f64),    4)
+	testing.expect_value(t, classify_typeid(i64),    0)
+	testing.expect_value(t, classify_typeid(nil),    0)
+}
@@ -0,0 +1,79 @@
+package test_internal
+
+import "core:testing"
+
+// NOTE: a `switch` on at least four constant strings is dispatched on the length and then on distinguishing bytes
+
+@(private="file")
+classify_key :: proc(s: string) -> int {
+	switch s {
+	case "":                                   return 1
+	case "Aa":                                 return 2 // same hash as "BB" in many string hashes
+	case "BB":                                 return 3
+	case "get_a", "get_b":                     return 4
+	case "get_c":                              return 5
+	case "content-type-override-x1":           return 6 // longer than 16 bytes, differs in the last byte only
+	case "content-type-override-x2":           return 7
+	case "a", "b", "c":                        return 8
+	}
+	return 0
+}
+
+@(private="file")
+classify_fallthrough :: proc(s: string) -> (n: int) {
+	switch s {
+	case "one":
+		n += 1
+		fallthrough
+	case "two":
+		n += 10
+	case:
+		n = -1
+	case "six":
+		n += 100
+		fallthrough
+	case "ten":
+		n += 1000
+	}
+	return
+}
+
+@test
+test_switch_string_dispatch :: proc(t: ^testing.T) {
+	testing.expect_value(t, classify_key(""),   1)
+	testing.expect_value(t, classify_key("Aa"), 2)
+	testing.expect_value(t, classify_key("BB"), 3)
+	testing.expect_value(t, classify_key("AB"), 0)
+	testing.expect_value(t, classify_key("Ab"), 0)
+
+	testing.expect_value(t, classify_key("get_a"), 4)
+	testing.expect_value(t, classify_key("get_b"), 4)
+	testing.expect_value(t, classify_key("get_c"), 5)
+	testing.expect_value(t, classify_key("get_d"), 0)
+	testing.expect_value(t, classify_key("get_"),  0)
+	testing.expect_value(t, classify_key("get_ab"), 0)
+
+	testing.expect_value(t, classify_key("content-type-override-x1"), 6)
+	testing.expect_value(t, classify_key("content-type-override-x2"), 7)
+	testing.expect_value(t, classify_key("content-type-override-x3"), 0)
+	testing.expect_value(t, classify_key("Content-type-override-x1"), 0)
+
+	testing.expect_value(t, classify_key("a"), 8)
+	testing.expect_value(t, classify_key("c"), 8)
+	testing.expect_value(t, classify_key("d"), 0)
+
+	// NOTE: the bytes past the length of the string must never be read
+	buf := "BBB"
+	testing.expect_value(t, classify_key(buf[:2]), 3)
+	testing.expect_value(t, classify_key(buf[:0]), 1)
+}
+
+@test
+test_switch_string_fallthrough_and_default :: proc(t: ^testing.T) {
+	testing.expect_value(t, classify_fallthrough("one"),   11)
+	testing.expect_value(t, classify_fallthrough("two"),   10)
+	testing.expect_value(t, classify_fallthrough("six"),   1100)
+	testing.expect_value(t, classify_fallthrough("ten"),   1000)
+	testing.expect_value(t, classify_fallthrough("three"), -1)
+	testing.expect_value(t, classify_fallthrough(""),      -1)
+}
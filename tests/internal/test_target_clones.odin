@@ -0,0 +1,69 @@
+#+build amd64, i386
+package test_internal
+
+import "base:runtime"
+import "core:testing"
+
+@(private="file", target_clones="avx512f+avx512bw,avx2+fma,default")
+dot :: proc(a, b: []f32) -> (sum: f32) {
+	for x, i in a {
+		sum += x * b[i]
+	}
+	return
+}
+
+// Large enough to be returned through an sret pointer
+@(private="file")
+Big :: struct {
+	values: [16]i64,
+}
+
+@(private="file", target_clones="avx2,sse4.2+popcnt,default")
+make_big :: proc(n: i64, offset: Big) -> (b: Big) {
+	for &v, i in b.values {
+		v = n * i64(i) + offset.values[i]
+	}
+	return
+}
+
+@(private="file", target_clones="avx2,default")
+count_calls :: proc(counter: ^int) {
+	@(static) calls: int
+	calls += 1
+	counter^ = calls
+}
+
+@test
+test_target_clones_dispatch :: proc(t: ^testing.T) {
+	a := []f32{1, 2, 3, 4, 5, 6, 7, 8, 9}
+	b := []f32{9, 8, 7, 6, 5, 4, 3, 2, 1}
+	// every call after the first goes through the cached clone
+	for _ in 0..<3 {
+		testing.expect_value(t, dot(a, b), 165)
+	}
+
+	offset: Big
+	offset.values[15] = 100
+	big := make_big(3, offset)
+	testing.expect_value(t, big.values[0], 0)
+	testing.expect_value(t, big.values[5], 15)
+	testing.expect_value(t, big.values[15], 145)
+}
+
+@test
+test_target_clones_share_statics :: proc(t: ^testing.T) {
+	first, second: int
+	count_calls(&first)
+	count_calls(&second)
+	testing.expect_value(t, second, first + 1)
+}
+
+@test
+test_target_clones_supported :: proc(t: ^testing.T) {
+	when ODIN_ARCH == .amd64 {
+		testing.expect(t, runtime.__target_clones_supported("sse+sse2"))
+	}
+	testing.expect(t, runtime.__target_clones_supported(""))
+	testing.expect(t, !runtime.__target_clones_supported("not-a-feature"))
+	testing.expect(t, !runtime.__target_clones_supported("sse2+not-a-feature"))
+}
@@ -0,0 +1,39 @@
+package pgo
+
+import "core:fmt"
+import "core:os"
+
+// A hot loop with a branch that the training run never takes.
+// With a profile, `rare_path` is known to be cold and the branch in
+// `classify` carries weights, which changes inlining and block layout.
+
+@(private="file")
+rare_count: int
+
+@(private="file")
+rare_path :: #force_no_inline proc(x: u64) -> u64 {
+	rare_count += 1
+	fmt.eprintln("rare path taken for", x)
+	return x*x + 1
+}
+
+@(private="file")
+classify :: proc(x: u64, limit: u64) -> u64 {
+	if x > limit {
+		return rare_path(x)
+	}
+	return x ~ (x >> 7)
+}
+
+main :: proc() {
+	// Passing any argument makes the rare path reachable.
+	limit := max(u64) if len(os.args) < 2 else 1_000
+
+	sum: u64
+	x := u64(0x9e3779b97f4a7c15)
+	for _ in 0..<2_000_000 {
+		x = x*6364136223846793005 + 1442695040888963407
+		sum += classify(x >> 40, limit)
+	}
+	fmt.println(sum, rare_count)
+}
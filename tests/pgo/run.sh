@@ -0,0 +1,83 @@
+#!/usr/bin/env bash
+set -eu
+
+# Profile-guided optimization round trip.
+#
+# `pgo.odin` is trained with `-pgo-generate`, the raw profile is merged with
+# `llvm-profdata`, and the program is rebuilt with `-pgo-use`. The optimized
+# IR must carry the profile (entry counts, branch weights) and mark the
+# never-executed procedure cold; the same round trip is then repeated with
+# `-use-separate-modules` and, when `ld.lld` is available, with `-lto:thin`.
+
+here=$(cd "$(dirname "$0")" && pwd)
+: "${ODIN:=$here/../../odin}"
+: "${LLVM_PROFDATA:=}"
+
+if [ -z "$LLVM_PROFDATA" ]; then
+	for candidate in llvm-profdata llvm-profdata-{22,21,20,19,18,17}; do
+		if command -v "$candidate" > /dev/null; then
+			LLVM_PROFDATA=$candidate
+			break
+		fi
+	done
+fi
+if [ -z "$LLVM_PROFDATA" ]; then
+	echo "SKIPPED: llvm-profdata not found"
+	exit 0
+fi
+
+rm -rf "$here/build"
+mkdir -p "$here/build"
+pushd "$here/build" > /dev/null
+
+set -x
+
+# train <name> <flags...>: builds instrumented, runs, and merges <name>.profdata
+train() {
+	local name=$1; shift
+	$ODIN build ../pgo.odin -file -o:speed -pgo-generate -out:$name-gen "$@"
+	LLVM_PROFILE_FILE=$name.profraw ./$name-gen
+	$LLVM_PROFDATA merge -o $name.profdata $name.profraw
+}
+
+train single
+$ODIN build ../pgo.odin -file -o:speed -build-mode:llvm-ir -out:base
+$ODIN build ../pgo.odin -file -o:speed -build-mode:llvm-ir -out:pgo -pgo-use:single.profdata
+
+# The profile is attached to the module...
+if grep -q 'function_entry_count' base.ll || grep -q 'branch_weights' base.ll; then
+	echo "SUCCESSFUL 0/1: profile metadata without -pgo-use"
+	exit 1
+fi
+grep -q 'function_entry_count' pgo.ll
+grep -q 'branch_weights' pgo.ll
+
+# ...and drives the optimizer: the untrained path is cold only with the profile.
+cold_attrs() {
+	local group
+	group=$(grep -E '^define .*@"?pgo\.rare_path' "$1" | grep -oE '#[0-9]+' | head -n 1)
+	[ -n "$group" ] && grep -E "^attributes $group = " "$1" | grep -qw cold
+}
+if cold_attrs base.ll; then
+	echo "SUCCESSFUL 0/1: rare_path is cold without a profile"
+	exit 1
+fi
+cold_attrs pgo.ll
+
+$ODIN build ../pgo.odin -file -o:speed -out:single-use -pgo-use:single.profdata
+[ "$(./single-use)" = "$(./single-gen)" ]
+
+train separate -use-separate-modules
+$ODIN build ../pgo.odin -file -o:speed -use-separate-modules -out:separate-use -pgo-use:separate.profdata
+[ "$(./separate-use)" = "$(./separate-gen)" ]
+
+if command -v ld.lld > /dev/null; then
+	train lto -lto:thin
+	$ODIN build ../pgo.odin -file -o:speed -lto:thin -out:lto-use -pgo-use:lto.profdata
+	[ "$(./lto-use)" = "$(./lto-gen)" ]
+fi
+
+set +x
+
+popd > /dev/null
+echo "SUCCESSFUL 1/1"
@@ -0,0 +1,121 @@
+#!/usr/bin/env bash
+set -eu
+
+# `odin serve` round trip.
+#
+# A server is started on a private socket and the same `odin check` is sent to it while the
+# package is edited: unchanged, a file changed in place, a syntax error and its fix, and a new
+# file added. Every answer (exit code, stdout, and stderr) must match what a local run gives.
+
+here=$(cd "$(dirname "$0")" && pwd)
+: "${ODIN:=$here/../../odin}"
+
+rm -rf "$here/build"
+mkdir -p "$here/build/pkg"
+pushd "$here/build" > /dev/null
+
+export ODIN_SERVE_SOCKET="$here/build/odin.sock"
+$ODIN serve > serve.log 2>&1 &
+server=$!
+trap 'kill $server 2> /dev/null || true' EXIT
+
+for _ in $(seq 50); do
+	[ -S "$ODIN_SERVE_SOCKET" ] && break
+	sleep 0.1
+done
+
+cat > pkg/main.odin <<'ODIN'
+package main
+
+import "core:fmt"
+
+main :: proc() {
+	fmt.println(answer())
+}
+ODIN
+cat > pkg/answer.odin <<'ODIN'
+package main
+
+answer :: proc() -> int { return 42 }
+ODIN
+mkdir -p env
+cat > env/main.odin <<'ODIN'
+package main
+
+import "core:fmt"
+import "core:os"
+
+main :: proc() {
+	fmt.println(os.get_env("SERVE_TEST_VALUE", context.temp_allocator))
+}
+ODIN
+
+# expect <exit code> <command...>: runs the command through the server, checks its exit code,
+# and compares its stdout and stderr (left in served.out and served.err) with a local run
+expect() {
+	local want=$1; shift
+	local got=0
+	"$@" > served.out 2> served.err || got=$?
+	if [ "$got" -ne "$want" ]; then
+		cat served.out served.err
+		echo "SUCCESSFUL 0/1: '$*' exited with $got, expected $want"
+		exit 1
+	fi
+	ODIN_SERVE_SOCKET= "$@" > local.out 2> local.err || true
+	if ! cmp -s local.out served.out || ! cmp -s local.err served.err; then
+		diff -u local.out served.out || true
+		diff -u local.err served.err || true
+		echo "SUCCESSFUL 0/1: '$*' printed something else through the server"
+		exit 1
+	fi
+}
+
+set -x
+
+expect 0 $ODIN check pkg
+expect 0 $ODIN check pkg
+
+# changed in place, re-parsed by the warm worker
+printf 'package main\n\nanswer :: proc() -> string { return "forty-two" }\n' > pkg/answer.odin
+expect 0 $ODIN check pkg
+
+# a syntax error, and then its fix
+printf 'package main\n\nanswer :: proc() -> int { return 42 \n' > pkg/answer.odin
+expect 1 $ODIN check pkg
+printf 'package main\n\nanswer :: proc() -> int { return 42 }\n' > pkg/answer.odin
+expect 0 $ODIN check pkg
+
+# a type error is reported by the checker
+printf 'package main\n\nanswer :: proc() -> int { return "42" }\n' > pkg/answer.odin
+expect 1 $ODIN check pkg
+
+# the error quotes the file as edited, not as the worker first parsed it
+printf 'package main\n\n\nanswer :: proc() -> int { return "edited" }\n' > pkg/answer.odin
+expect 1 $ODIN check pkg
+grep -q 'answer.odin(4:' served.err
+grep -q 'return "edited"' served.err
+printf 'package main\n\nanswer :: proc() -> int { return 42 }\n' > pkg/answer.odin
+
+# a new file changes the package, the worker is replaced
+printf 'package main\n\nother :: proc() -> int { return answer() + 1 }\n' > pkg/other.odin
+expect 0 $ODIN check pkg
+rm pkg/other.odin
+expect 0 $ODIN check pkg
+
+# the output comes back to the client
+[ "$($ODIN run pkg -out:pkg_main)" = "42" ]
+
+# the client's environment is used, by the compiler and by the program it runs
+expect 1 env ODIN_ROOT=/nonexistent $ODIN check pkg
+[ "$(SERVE_TEST_VALUE=first  $ODIN run env -out:env_main)" = "first" ]
+[ "$(SERVE_TEST_VALUE=second $ODIN run env -out:env_main)" = "second" ]
+
+# without a server, the command runs locally
+kill $server
+wait $server 2> /dev/null || true
+expect 0 $ODIN check pkg
+
+set +x
+
+popd > /dev/null
+echo "SUCCESSFUL 1/1"